@@ -0,0 +1,384 @@
+//========================================
+// dahdit_bench: 합성 프로그램으로 단계별(lex/parse/compile/exec) 처리량 측정
+//========================================
+#include "bench_gen.h"
+#include "lexer.h"
+#include "parser.h"
+#include "symtab.h"
+#include "program.h"
+#include "bytecode.h"
+#include "vm.h"
+#include "output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#define NULL_DEVICE "/dev/null"
+#else
+#include <windows.h>
+#include <fcntl.h>
+#include <io.h>
+#define open _open
+#define close _close
+#define NULL_DEVICE "NUL"
+#endif
+
+#define BENCH_DEFAULT_STMTS 20000
+#define BENCH_DEFAULT_REPEAT 5
+#define BENCH_DEFAULT_SEED 0x5EEDu
+#define BENCH_DEFAULT_TOLERANCE 15.0
+#define BENCH_MIN_COMPARE_MS 5.0     // 이보다 짧은 측정은 잡음이 커서 회귀 판정에서 제외
+
+//========================================
+// Measurement
+//========================================
+typedef enum { PH_LEX, PH_PARSE, PH_COMPILE, PH_EXEC, PH_COUNT } Phase;
+
+static const char* PHASE_NAMES[PH_COUNT] = { "lex", "parse", "compile", "exec" };
+
+typedef struct {
+    const char* name;
+    size_t bytes, stmts;
+    size_t iters;           // 반복 실행되는 본문 문장 수 (loops)
+    size_t calls;           // 실행되는 하위 루틴 호출 수 (calls)
+    size_t elems;           // 실행되는 원소별 연산 수 (arrays)
+    double sec[PH_COUNT];   // 반복 중 단계별 최솟값
+} BenchResult;
+
+typedef struct {
+    size_t stmts;
+    int repeat;
+    uint64_t seed;
+    double tolerance;       // 허용 감소율 (%)
+    const char* only;
+    const char* baseline;
+    const char* save;
+    const char* emit;
+} BenchOptions;
+
+static double now_sec(void) {
+#ifndef _WIN32
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#else
+    LARGE_INTEGER freq, t;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart / (double)freq.QuadPart;
+#endif
+}
+
+static double total_sec(const BenchResult* r) {
+    double t = 0;
+    for (int p = 0; p < PH_COUNT; ++p) t += r->sec[p];
+    return t;
+}
+
+static double mb_per_sec(size_t bytes, double sec) {
+    return sec > 0 ? (double)bytes / (1024.0 * 1024.0) / sec : 0;
+}
+
+/**
+ * @brief 생성된 소스를 한 번 처리하면서 각 단계 시간을 측정
+ * 출력은 null 장치로 보내 터미널 속도가 측정에 섞이지 않게 한다.
+ * @return 메모리 부족 시 false.
+ */
+static bool run_once(const GenBuffer* src, const char* name, int out_fd, double sec[PH_COUNT]) {
+    bool ok = false;
+    double t0 = now_sec();
+
+    Lexer lx; lx_open_buffer(&lx, name, src->data, src->len);
+    TokenStream ts;
+    if (!lx_tokenize(&lx, &ts)) { ts_free(&ts); lx_close(&lx); return false; }
+    double t1 = now_sec();
+
+    SymTab st; st_init(&st);
+    Program prog; prog_init(&prog);
+    Parser ps; ps_init_stream(&ps, &ts, &st, &prog.arena);
+    bool parsed = prog_parse(&prog, &ps);
+    ps_free(&ps);
+    double t2 = now_sec();
+
+    Chunk ch; bc_init(&ch);
+    if (parsed) {
+        for (size_t i = 0; i < prog.count; ++i) bc_compile_stmt(&ch, &prog.stmts[i], &st, name);
+        ok = bc_finish(&ch);
+    }
+    double t3 = now_sec();
+
+    if (ok) {
+        Output out; out_init(&out, out_fd, OUT_FLUSH_FULL);
+        VM vm; vm_init(&vm, &st, name, &out);
+        ok = vm_run(&vm, &ch);
+        vm_free(&vm);
+        out_free(&out);
+    }
+    double t4 = now_sec();
+
+    sec[PH_LEX] = t1 - t0;
+    sec[PH_PARSE] = t2 - t1;
+    sec[PH_COMPILE] = t3 - t2;
+    sec[PH_EXEC] = t4 - t3;
+
+    bc_free(&ch);
+    prog_free(&prog);
+    st_free(&st);
+    ts_free(&ts);
+    lx_close(&lx);
+    return ok;
+}
+
+static bool run_workload(GenKind kind, const BenchOptions* opts, int out_fd, BenchResult* r) {
+    GenBuffer src;
+    if (!gen_program(&src, kind, opts->stmts, opts->seed)) return false;
+
+    r->name = gen_kind_name(kind);
+    r->bytes = src.len;
+    r->stmts = src.stmts;
+    r->iters = src.iters;
+    r->calls = src.calls;
+    r->elems = src.elems;
+    for (int p = 0; p < PH_COUNT; ++p) r->sec[p] = -1;
+
+    bool ok = true;
+    for (int i = 0; i < opts->repeat && ok; ++i) {
+        double sec[PH_COUNT] = {0};
+        ok = run_once(&src, r->name, out_fd, sec);
+        if (!ok) break;     // 토큰화에 실패하면 sec이 채워지지 않음
+        for (int p = 0; p < PH_COUNT; ++p) {
+            if (r->sec[p] < 0 || sec[p] < r->sec[p]) r->sec[p] = sec[p];
+        }
+    }
+    gen_free(&src);
+    return ok;
+}
+
+//========================================
+// Baseline (JSON 저장/비교)
+// 이 도구가 쓰는 평평한 형식만 읽는다: {"config": {...}, "workloads": {"name": {"key": number, ...}}}
+//========================================
+static bool save_baseline(const char* path, const BenchOptions* opts, const BenchResult* rs, int n) {
+    FILE* fp = fopen(path, "w");
+    if (!fp) return false;
+    fprintf(fp, "{\n  \"config\": {\"stmts\": %zu, \"repeat\": %d, \"seed\": %llu},\n  \"workloads\": {\n",
+            opts->stmts, opts->repeat, (unsigned long long)opts->seed);
+    for (int i = 0; i < n; ++i) {
+        const BenchResult* r = &rs[i];
+        double total = total_sec(r);
+        fprintf(fp, "    \"%s\": {\"bytes\": %zu, \"stmts\": %zu", r->name, r->bytes, r->stmts);
+        for (int p = 0; p < PH_COUNT; ++p) fprintf(fp, ", \"%s_ms\": %.3f", PHASE_NAMES[p], r->sec[p] * 1e3);
+        fprintf(fp, ", \"total_ms\": %.3f, \"mb_per_s\": %.2f, \"stmts_per_s\": %.0f}%s\n",
+                total * 1e3, mb_per_sec(r->bytes, total), total > 0 ? (double)r->stmts / total : 0,
+                i + 1 < n ? "," : "");
+    }
+    fprintf(fp, "  }\n}\n");
+    return fclose(fp) == 0;
+}
+
+static char* read_file(const char* path) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return NULL;
+    size_t cap = 4096, len = 0;
+    char* data = malloc(cap);
+    while (data) {
+        if (len + 1 >= cap) {
+            char* grown = realloc(data, cap * 2);
+            if (!grown) { free(data); data = NULL; break; }
+            data = grown; cap *= 2;
+        }
+        size_t n = fread(data + len, 1, cap - len - 1, fp);
+        if (n == 0) break;
+        len += n;
+    }
+    fclose(fp);
+    if (data) data[len] = '\0';
+    return data;
+}
+
+/**
+ * @brief "key": number 형태를 [begin, end) 범위에서 찾아 값 반환
+ */
+static bool json_number(const char* begin, const char* end, const char* key, double* out) {
+    size_t klen = strlen(key);
+    for (const char* p = begin; p && p < end; p = strchr(p + 1, '"')) {
+        if (*p == '"' && (size_t)(end - p) > klen + 1 && strncmp(p + 1, key, klen) == 0 && p[klen + 1] == '"') {
+            const char* q = p + klen + 2;
+            while (q < end && (*q == ' ' || *q == ':')) q++;
+            char* stop;
+            *out = strtod(q, &stop);
+            return stop != q;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 워크로드 이름에 해당하는 객체 범위 {...}를 찾음
+ */
+static bool json_object(const char* json, const char* name, const char** begin, const char** end) {
+    char pat[64];
+    snprintf(pat, sizeof(pat), "\"%s\":", name);
+    const char* p = strstr(json, pat);
+    if (!p || !(p = strchr(p, '{'))) return false;
+    const char* q = strchr(p, '}');
+    if (!q) return false;
+    *begin = p; *end = q;
+    return true;
+}
+
+/**
+ * @brief 기준선과 단계별 시간을 비교하여 출력
+ * BENCH_MIN_COMPARE_MS 미만인 항목은 변화율만 보여 주고 회귀로 세지 않는다.
+ * @return 허용 범위를 넘어 느려진 항목 수.
+ */
+static int compare_baseline(const char* json, const BenchOptions* opts, const BenchResult* rs, int n) {
+    const char* cb; const char* ce;
+    double stmts;
+    if (json_object(json, "config", &cb, &ce) && json_number(cb, ce, "stmts", &stmts)
+        && (size_t)stmts != opts->stmts) {
+        printf("\nbaseline was recorded with --stmts %.0f; results are not comparable\n", stmts);
+        return 0;
+    }
+
+    int regressions = 0;
+    printf("\n%-10s %-8s %10s %10s %8s\n", "workload", "phase", "base ms", "now ms", "change");
+    for (int i = 0; i < n; ++i) {
+        const char* b; const char* e;
+        if (!json_object(json, rs[i].name, &b, &e)) {
+            printf("%-10s (not in baseline)\n", rs[i].name);
+            continue;
+        }
+        for (int p = 0; p <= PH_COUNT; ++p) {
+            char key[32];
+            double now = (p == PH_COUNT ? total_sec(&rs[i]) : rs[i].sec[p]) * 1e3;
+            const char* phase = p == PH_COUNT ? "total" : PHASE_NAMES[p];
+            snprintf(key, sizeof(key), "%s_ms", phase);
+            double base;
+            if (!json_number(b, e, key, &base) || base <= 0) continue;
+
+            double change = (now - base) / base * 100.0;
+            bool slow = change > opts->tolerance && base >= BENCH_MIN_COMPARE_MS;
+            regressions += slow;
+            printf("%-10s %-8s %10.3f %10.3f %+7.1f%%%s\n",
+                   rs[i].name, phase, base, now, change, slow ? "  REGRESSION" : "");
+        }
+    }
+    return regressions;
+}
+
+//========================================
+// Main
+//========================================
+static void usage(const char* prog) {
+    fprintf(stderr,
+            "usage: %s [--stmts N] [--repeat N] [--seed N] [--only KIND]\n"
+            "          [--baseline FILE] [--save FILE] [--tolerance PCT]\n"
+            "       %s --emit KIND [--stmts N] [--seed N]   (print the generated program)\n"
+            "kinds:", prog, prog);
+    for (int k = 0; k < GEN_KIND_COUNT; ++k) fprintf(stderr, " %s", gen_kind_name((GenKind)k));
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opts = {
+        .stmts = BENCH_DEFAULT_STMTS, .repeat = BENCH_DEFAULT_REPEAT,
+        .seed = BENCH_DEFAULT_SEED, .tolerance = BENCH_DEFAULT_TOLERANCE,
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* val = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!val) { usage(argv[0]); return 1; }
+        if (strcmp(arg, "--stmts") == 0) opts.stmts = strtoull(val, NULL, 10);
+        else if (strcmp(arg, "--repeat") == 0) opts.repeat = atoi(val);
+        else if (strcmp(arg, "--seed") == 0) opts.seed = strtoull(val, NULL, 0);
+        else if (strcmp(arg, "--tolerance") == 0) opts.tolerance = atof(val);
+        else if (strcmp(arg, "--only") == 0) opts.only = val;
+        else if (strcmp(arg, "--baseline") == 0) opts.baseline = val;
+        else if (strcmp(arg, "--save") == 0) opts.save = val;
+        else if (strcmp(arg, "--emit") == 0) opts.emit = val;
+        else { usage(argv[0]); return 1; }
+        ++i;
+    }
+    if (opts.repeat < 1) opts.repeat = 1;
+
+    GenKind kind;
+    if (opts.emit) {
+        GenBuffer src;
+        if (!gen_kind_parse(opts.emit, &kind)) { usage(argv[0]); return 1; }
+        if (!gen_program(&src, kind, opts.stmts, opts.seed)) return 1;
+        fwrite(src.data, 1, src.len, stdout);
+        gen_free(&src);
+        return 0;
+    }
+    if (opts.only && !gen_kind_parse(opts.only, &kind)) { usage(argv[0]); return 1; }
+
+    int out_fd = open(NULL_DEVICE, O_WRONLY);
+    if (out_fd < 0) { fprintf(stderr, "Cannot open: %s\n", NULL_DEVICE); return 1; }
+
+    BenchResult rs[GEN_KIND_COUNT];
+    int n = 0;
+    printf("%-10s %9s %8s", "workload", "KiB", "stmts");
+    for (int p = 0; p < PH_COUNT; ++p) printf(" %9s", PHASE_NAMES[p]);
+    printf(" %9s %9s %11s\n", "total ms", "MB/s", "stmts/s");
+
+    for (int k = 0; k < GEN_KIND_COUNT; ++k) {
+        if (opts.only && k != (int)kind) continue;
+        BenchResult* r = &rs[n];
+        if (!run_workload((GenKind)k, &opts, out_fd, r)) {
+            fprintf(stderr, "%s: out of memory\n", gen_kind_name((GenKind)k));
+            close(out_fd);
+            return 1;
+        }
+        n++;
+
+        double total = total_sec(r);
+        printf("%-10s %9.1f %8zu", r->name, (double)r->bytes / 1024.0, r->stmts);
+        for (int p = 0; p < PH_COUNT; ++p) printf(" %7.2fms", r->sec[p] * 1e3);
+        printf(" %9.2f %9.2f %11.0f\n", total * 1e3, mb_per_sec(r->bytes, total),
+               total > 0 ? (double)r->stmts / total : 0);
+    }
+    close(out_fd);
+    for (int i = 0; i < n; ++i) {
+        if (rs[i].iters == 0) continue;
+        printf("%-10s %.2f ns per loop body statement (%zu executed)\n", rs[i].name,
+               rs[i].sec[PH_EXEC] * 1e9 / (double)rs[i].iters, rs[i].iters);
+    }
+    for (int i = 0; i < n; ++i) {
+        if (rs[i].calls == 0) continue;
+        printf("%-10s %.2f ns per call (%zu executed)\n", rs[i].name,
+               rs[i].sec[PH_EXEC] * 1e9 / (double)rs[i].calls, rs[i].calls);
+    }
+    for (int i = 0; i < n; ++i) {
+        if (rs[i].elems == 0) continue;
+        printf("%-10s %.3f ns per element operation (%zu executed)\n", rs[i].name,
+               rs[i].sec[PH_EXEC] * 1e9 / (double)rs[i].elems, rs[i].elems);
+    }
+
+    int status = 0;
+    if (opts.save) {
+        if (!save_baseline(opts.save, &opts, rs, n)) {
+            fprintf(stderr, "Cannot write: %s\n", opts.save);
+            status = 1;
+        }
+    }
+    if (opts.baseline) {
+        char* json = read_file(opts.baseline);
+        if (!json) {
+            fprintf(stderr, "Cannot open: %s\n", opts.baseline);
+            return 1;
+        }
+        int regressions = compare_baseline(json, &opts, rs, n);
+        free(json);
+        if (regressions) {
+            printf("\n%d measurement(s) slower than baseline by more than %.0f%%\n", regressions, opts.tolerance);
+            status = 1;
+        }
+    }
+    return status;
+}
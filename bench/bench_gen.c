@@ -0,0 +1,394 @@
+//========================================
+// System Includes
+//========================================
+#include "bench_gen.h"
+#include "morse_table.h"
+#include <stdlib.h>
+#include <string.h>
+
+//========================================
+// Generator State
+//========================================
+typedef struct {
+    GenBuffer* out;
+    uint64_t rng;
+    bool ok;
+    size_t vars;    // 지금까지 정의한 변수 수 (X0..)
+    size_t subs;    // 지금까지 정의한 두 인자 하위 루틴 수 (S0..)
+    size_t arrays;  // 지금까지 선언한 배열 수 (Y0..)
+} Gen;
+
+// 변수 이름에 쓰는 문자. K는 '*' 연산자와 부호가 같으므로 제외
+static const char NAME_CHARS[] = "ABCDEFGHIJLMNOPQRSTUVWXYZ";
+#define NAME_RADIX (sizeof(NAME_CHARS) - 1)
+
+static const char* WORDS[] = {
+    "HELLO", "WORLD", "MORSE", "SIGNAL", "DAH", "DIT", "STATION", "COPY", "OVER", "RADIO",
+};
+#define WORD_COUNT (sizeof(WORDS) / sizeof(WORDS[0]))
+
+static uint64_t rnd(Gen* g) {
+    // xorshift64*
+    g->rng ^= g->rng >> 12;
+    g->rng ^= g->rng << 25;
+    g->rng ^= g->rng >> 27;
+    return g->rng * 0x2545F4914F6CDD1DULL;
+}
+
+static size_t rnd_below(Gen* g, size_t n) { return (size_t)(rnd(g) % n); }
+
+//========================================
+// Text Output
+//========================================
+static void put(Gen* g, const char* s, size_t n) {
+    GenBuffer* b = g->out;
+    if (!g->ok) return;
+    if (b->len + n > b->cap) {
+        size_t cap = b->cap ? b->cap : 64 * 1024;
+        while (cap < b->len + n) cap *= 2;
+        char* grown = realloc(b->data, cap);
+        if (!grown) { g->ok = false; return; }
+        b->data = grown; b->cap = cap;
+    }
+    memcpy(b->data + b->len, s, n);
+    b->len += n;
+}
+
+static void puts_(Gen* g, const char* s) { put(g, s, strlen(s)); }
+
+/**
+ * @brief 문자 하나의 모스 부호 (테이블의 첫 항목)
+ */
+static const char* morse_of(char ch) {
+    for (size_t i = 0; i < sizeof(MORSE_TABLE) / sizeof(MORSE_TABLE[0]); ++i) {
+        if (MORSE_TABLE[i].ch == ch) return MORSE_TABLE[i].code;
+    }
+    return NULL;
+}
+
+/**
+ * @brief 평문 토큰(단어, 숫자, 연산자)을 공백으로 구분된 모스 부호로 출력
+ */
+static void put_morse(Gen* g, const char* text) {
+    for (const char* p = text; *p; ++p) {
+        if (p != text) put(g, " ", 1);
+        puts_(g, morse_of(*p));
+    }
+}
+
+static void put_sep(Gen* g) { put(g, " / ", 3); }
+static void put_end(Gen* g) { put(g, " ;\n", 3); g->out->stmts++; }
+
+static void var_name(size_t index, char* buf) {
+    char* p = buf;
+    *p++ = 'X';
+    do { *p++ = NAME_CHARS[index % NAME_RADIX]; index /= NAME_RADIX; } while (index);
+    *p = '\0';
+}
+
+static void put_var(Gen* g, size_t index) {
+    char name[16];
+    var_name(index, name);
+    put_morse(g, name);
+}
+
+static void put_number(Gen* g, uint32_t v) {
+    char buf[16];
+    char* p = buf + sizeof(buf);
+    *--p = '\0';
+    do { *--p = (char)('0' + v % 10); v /= 10; } while (v);
+    put_morse(g, p);
+}
+
+/**
+ * @brief 이미 정의된 변수 또는 상수 하나를 피연산자로 출력
+ */
+static void put_operand(Gen* g) {
+    if (g->vars && rnd_below(g, 3)) put_var(g, rnd_below(g, g->vars));
+    else put_number(g, (uint32_t)rnd_below(g, 1000));
+}
+
+/**
+ * @brief operands개 피연산자로 이루어진 중위식 출력
+ * 나눗셈/나머지는 0이 아닌 상수로만 나누어 런타임 오류가 나지 않게 한다.
+ */
+static void put_expr(Gen* g, size_t operands) {
+    static const char* OPS[] = { "+", "-", "*", "/", "%" };
+    put_operand(g);
+    for (size_t i = 1; i < operands; ++i) {
+        size_t op = rnd_below(g, 5);
+        put(g, " ", 1);
+        put_morse(g, OPS[op]);
+        put(g, " ", 1);
+        if (op >= 3) put_number(g, 1 + (uint32_t)rnd_below(g, 99));
+        else put_operand(g);
+    }
+}
+
+//========================================
+// Statements
+//========================================
+static void stmt_var(Gen* g, size_t operands) {
+    // 새 변수 정의와 기존 변수 재할당을 섞음. 새 변수는 식을 출력한 뒤에야 참조 가능
+    bool fresh = g->vars == 0 || rnd_below(g, 4) == 0;
+    size_t target = fresh ? g->vars : rnd_below(g, g->vars);
+    put_morse(g, "VAR"); put_sep(g);
+    put_var(g, target); put_sep(g);
+    put_morse(g, "="); put_sep(g);
+    put_expr(g, operands);
+    put_end(g);
+    if (fresh) g->vars++;
+}
+
+static void stmt_print_expr(Gen* g, size_t operands) {
+    put_morse(g, "PRINT"); put_sep(g);
+    put_expr(g, operands);
+    put_end(g);
+}
+
+static void stmt_print_string(Gen* g, size_t words) {
+    put_morse(g, "PRINT"); put_sep(g);
+    put(g, "\"", 1);
+    for (size_t i = 0; i < words; ++i) {
+        if (i) put(g, " ", 1);
+        puts_(g, WORDS[rnd_below(g, WORD_COUNT)]);
+    }
+    put(g, "\"", 1);
+    put_end(g);
+}
+
+/**
+ * @brief REPEAT n ; 본문 ; END ; 블록 (본문은 기존 변수의 재할당만 하여 출력 없이 실행 경로만 잼)
+ */
+static void stmt_loop(Gen* g, size_t body) {
+    size_t count = 16 + rnd_below(g, 48);
+    put_morse(g, "REPEAT"); put_sep(g);
+    put_number(g, (uint32_t)count);
+    put_end(g);
+    for (size_t i = 0; i < body; ++i) {
+        put_morse(g, "VAR"); put_sep(g);
+        put_var(g, rnd_below(g, g->vars)); put_sep(g);
+        put_morse(g, "="); put_sep(g);
+        put_expr(g, 2 + rnd_below(g, 2));
+        put_end(g);
+    }
+    put_morse(g, "END");
+    put_end(g);
+    g->out->iters += count * body;
+}
+
+static void put_sub_name(Gen* g, size_t index) {
+    char name[16];
+    var_name(index, name);
+    name[0] = 'S';
+    put_morse(g, name);
+}
+
+/**
+ * @brief 두 인자 하위 루틴 정의 (지역 변수 하나를 거쳐 값을 돌려줌)
+ * SUB Sn ( P , Q ) ; VAR T = P * c + Q ; RETURN T % m ; END ;
+ */
+static void stmt_sub(Gen* g) {
+    put_morse(g, "SUB"); put_sep(g);
+    put_sub_name(g, g->subs); put_sep(g);
+    put_morse(g, "(P,Q)");
+    put_end(g);
+    put_morse(g, "VAR"); put_sep(g); put_morse(g, "T"); put_sep(g); put_morse(g, "="); put_sep(g);
+    put_morse(g, "P"); put(g, " ", 1); put_morse(g, "*"); put(g, " ", 1);
+    put_number(g, 2 + (uint32_t)rnd_below(g, 9));
+    put(g, " ", 1); put_morse(g, "+"); put(g, " ", 1); put_morse(g, "Q");
+    put_end(g);
+    put_morse(g, "RETURN"); put_sep(g);
+    put_morse(g, "T"); put(g, " ", 1); put_morse(g, "%"); put(g, " ", 1);
+    put_number(g, 100 + (uint32_t)rnd_below(g, 900));
+    put_end(g);
+    put_morse(g, "END");
+    put_end(g);
+    g->subs++;
+}
+
+/**
+ * @brief 꼬리 재귀로 1..N을 더하는 하위 루틴 (프레임을 늘리지 않고 N번 다시 들어감)
+ * SUB SUM ( N , ACC ) ; IF N ; RETURN SUM(N-1,ACC+N) ; END ; RETURN ACC ; END ;
+ */
+static void stmt_sum_sub(Gen* g) {
+    put_morse(g, "SUB"); put_sep(g); put_morse(g, "SUM"); put_sep(g); put_morse(g, "(N,ACC)"); put_end(g);
+    put_morse(g, "IF"); put_sep(g); put_morse(g, "N"); put_end(g);
+    put_morse(g, "RETURN"); put_sep(g); put_morse(g, "SUM(N-1,ACC+N)"); put_end(g);
+    put_morse(g, "END"); put_end(g);
+    put_morse(g, "RETURN"); put_sep(g); put_morse(g, "ACC"); put_end(g);
+    put_morse(g, "END"); put_end(g);
+}
+
+/**
+ * @brief 호출 문장: VAR X = Sn(Xa, Xb) + Xc ; 또는 VAR X = SUM(n, Xa) ;
+ */
+static void stmt_call(Gen* g) {
+    put_morse(g, "VAR"); put_sep(g);
+    put_var(g, rnd_below(g, g->vars)); put_sep(g);
+    put_morse(g, "="); put_sep(g);
+    if (rnd_below(g, 8) == 0) {
+        size_t n = 64 + rnd_below(g, 192);  // exec 단계가 기준선 비교 하한(BENCH_MIN_COMPARE_MS)을 넘도록
+        put_morse(g, "SUM"); put(g, " ", 1); put_morse(g, "("); put(g, " ", 1);
+        put_number(g, (uint32_t)n); put(g, " ", 1); put_morse(g, ","); put(g, " ", 1);
+        put_var(g, rnd_below(g, g->vars)); put(g, " ", 1); put_morse(g, ")");
+        g->out->calls += n + 1;
+    } else {
+        put_sub_name(g, rnd_below(g, g->subs)); put(g, " ", 1); put_morse(g, "("); put(g, " ", 1);
+        put_operand(g); put(g, " ", 1); put_morse(g, ","); put(g, " ", 1);
+        put_operand(g); put(g, " ", 1); put_morse(g, ")");
+        put(g, " ", 1); put_morse(g, "+"); put(g, " ", 1);
+        put_operand(g);
+        g->out->calls++;
+    }
+    put_end(g);
+}
+
+// 배열 길이 (원소별 연산 하나가 커널 호출 하나이므로 디스패치보다 커널 시간이 보이도록 김)
+#define GEN_ARRAY_LEN 4096
+#define GEN_ARRAY_COUNT 4
+
+static void put_array(Gen* g, size_t index) {
+    char name[16];
+    var_name(index, name);
+    name[0] = 'Y';
+    put_morse(g, name);
+}
+
+/**
+ * @brief ARRAY Yn ( 4096 ) ; VAR Yn = Xa ; (배열 선언과 채우기)
+ */
+static void stmt_array(Gen* g) {
+    put_morse(g, "ARRAY"); put_sep(g);
+    put_array(g, g->arrays); put_sep(g);
+    put_morse(g, "("); put(g, " ", 1);
+    put_number(g, GEN_ARRAY_LEN); put(g, " ", 1);
+    put_morse(g, ")");
+    put_end(g);
+    put_morse(g, "VAR"); put_sep(g); put_array(g, g->arrays); put_sep(g); put_morse(g, "="); put_sep(g);
+    put_operand(g);
+    put_end(g);
+    g->arrays++;
+}
+
+/**
+ * @brief 원소별 식: VAR Ya = Yb op Yc op k ... ; 가끔 원소 하나를 쓰거나 읽음
+ * 나눗셈/나머지는 0이 아닌 상수로만 나눈다.
+ */
+static void stmt_array_expr(Gen* g) {
+    static const char* OPS[] = { "+", "-", "*", "/", "%" };
+    put_morse(g, "VAR"); put_sep(g);
+    if (rnd_below(g, 8) == 0) {
+        put_array(g, rnd_below(g, g->arrays));
+        put(g, " ", 1); put_morse(g, "("); put(g, " ", 1);
+        put_number(g, (uint32_t)rnd_below(g, GEN_ARRAY_LEN)); put(g, " ", 1); put_morse(g, ")");
+        put_sep(g); put_morse(g, "="); put_sep(g);
+        put_expr(g, 2);
+        put_end(g);
+        return;
+    }
+    put_array(g, rnd_below(g, g->arrays)); put_sep(g);
+    put_morse(g, "="); put_sep(g);
+    put_array(g, rnd_below(g, g->arrays));
+    size_t operands = 2 + rnd_below(g, 3);
+    for (size_t i = 1; i < operands; ++i) {
+        size_t op = rnd_below(g, 5);
+        put(g, " ", 1);
+        put_morse(g, OPS[op]);
+        put(g, " ", 1);
+        if (op >= 3) put_number(g, 1 + (uint32_t)rnd_below(g, 99));
+        else if (rnd_below(g, 2)) put_array(g, rnd_below(g, g->arrays));
+        else put_operand(g);
+    }
+    put_end(g);
+    g->out->elems += (operands - 1) * GEN_ARRAY_LEN;
+}
+
+static void comment(Gen* g, size_t words) {
+    put(g, "#", 1);
+    for (size_t i = 0; i < words; ++i) {
+        put(g, " ", 1);
+        puts_(g, WORDS[rnd_below(g, WORD_COUNT)]);
+    }
+    put(g, "\n", 1);
+}
+
+//========================================
+// Public API
+//========================================
+static const char* KIND_NAMES[GEN_KIND_COUNT] = {
+    "vars", "long_expr", "print", "strings", "comments", "mixed", "loops", "calls", "arrays",
+};
+
+const char* gen_kind_name(GenKind kind) {
+    return kind < GEN_KIND_COUNT ? KIND_NAMES[kind] : "?";
+}
+
+bool gen_kind_parse(const char* name, GenKind* kind) {
+    for (int i = 0; i < GEN_KIND_COUNT; ++i) {
+        if (strcmp(name, KIND_NAMES[i]) == 0) { *kind = (GenKind)i; return true; }
+    }
+    return false;
+}
+
+bool gen_program(GenBuffer* out, GenKind kind, size_t stmts, uint64_t seed) {
+    memset(out, 0, sizeof(*out));
+    Gen g = { .out = out, .rng = seed ? seed : 1, .ok = true, .vars = 0, .subs = 0, .arrays = 0 };
+
+    for (size_t i = 0; i < stmts && g.ok; ++i) {
+        switch (kind) {
+            case GEN_VARS:
+                stmt_var(&g, 1 + rnd_below(&g, 3));
+                break;
+            case GEN_LONG_EXPR:
+                if (g.vars < 8) stmt_var(&g, 1);
+                else stmt_var(&g, 32 + rnd_below(&g, 96));
+                break;
+            case GEN_PRINT:
+                if (g.vars < 8) stmt_var(&g, 1);
+                else stmt_print_expr(&g, 1 + rnd_below(&g, 2));
+                break;
+            case GEN_STRINGS:
+                stmt_print_string(&g, 20 + rnd_below(&g, 40));
+                break;
+            case GEN_COMMENTS:
+                for (size_t c = 4 + rnd_below(&g, 8); c > 0; --c) comment(&g, 4 + rnd_below(&g, 12));
+                if (g.vars < 8) stmt_var(&g, 1);
+                else if (rnd_below(&g, 2)) stmt_var(&g, 2);
+                else stmt_print_expr(&g, 2);
+                break;
+            case GEN_LOOPS:
+                if (g.vars < 8) stmt_var(&g, 1);
+                else stmt_loop(&g, 3);
+                break;
+            case GEN_CALLS:
+                if (g.vars < 8) stmt_var(&g, 1);
+                else if (g.subs == 0) { stmt_sum_sub(&g); stmt_sub(&g); }
+                else if (g.subs < 8 && rnd_below(&g, 16) == 0) stmt_sub(&g);
+                else stmt_call(&g);
+                break;
+            case GEN_ARRAYS:
+                if (g.vars < 8) stmt_var(&g, 1);
+                else if (g.arrays < GEN_ARRAY_COUNT) stmt_array(&g);
+                else stmt_array_expr(&g);
+                break;
+            case GEN_MIXED:
+            default:
+                switch (g.vars < 8 ? 0 : rnd_below(&g, 10)) {
+                    case 0: case 1: case 2: case 3: stmt_var(&g, 1 + rnd_below(&g, 6)); break;
+                    case 4: case 5: case 6: stmt_print_expr(&g, 1 + rnd_below(&g, 4)); break;
+                    case 7: stmt_print_string(&g, 1 + rnd_below(&g, 8)); break;
+                    case 8: comment(&g, 3 + rnd_below(&g, 8)); stmt_var(&g, 2); break;
+                    default: stmt_var(&g, 20 + rnd_below(&g, 40)); break;
+                }
+                break;
+        }
+    }
+    if (!g.ok) gen_free(out);
+    return g.ok;
+}
+
+void gen_free(GenBuffer* out) {
+    free(out->data);
+    memset(out, 0, sizeof(*out));
+}
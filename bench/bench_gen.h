@@ -0,0 +1,48 @@
+#ifndef BENCH_GEN_H
+#define BENCH_GEN_H
+//========================================
+// System Includes
+//========================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//========================================
+// Workload Kinds (생성할 합성 프로그램 종류)
+//========================================
+typedef enum {
+    GEN_VARS,       // 많은 변수 정의/재할당 (심볼 테이블 부하)
+    GEN_LONG_EXPR,  // 피연산자 수백 개짜리 긴 식
+    GEN_PRINT,      // PRINT 위주 (출력 경로 부하)
+    GEN_STRINGS,    // 긴 문자열 리터럴 PRINT
+    GEN_COMMENTS,   // 주석이 대부분인 파일 (렉서 스킵 경로)
+    GEN_MIXED,      // 위 문장들을 고르게 섞은 현실적인 프로그램
+    GEN_LOOPS,      // 짧은 본문을 수십 번 도는 REPEAT 블록 (실행 디스패치 부하)
+    GEN_CALLS,      // 하위 루틴 호출과 꼬리 재귀 (프레임 생성/반환 부하)
+    GEN_ARRAYS,     // 긴 배열끼리의 원소별 식 (SIMD 커널 부하)
+    GEN_KIND_COUNT
+} GenKind;
+
+//========================================
+// Generated Program (생성 결과: 모스 부호 소스 텍스트)
+//========================================
+typedef struct {
+    char* data;
+    size_t len, cap;
+    size_t stmts;   // 생성한 문장 수 (주석 줄 제외)
+    size_t iters;   // 실행 시 반복되는 본문 문장 수의 합 (GEN_LOOPS)
+    size_t calls;   // 실행 시 하위 루틴 호출 수의 합, 꼬리 호출 포함 (GEN_CALLS)
+    size_t elems;   // 실행 시 원소별 연산 수의 합 (GEN_ARRAYS)
+} GenBuffer;
+
+//========================================
+// Function Prototypes
+//========================================
+const char* gen_kind_name(GenKind kind);
+bool gen_kind_parse(const char* name, GenKind* kind);
+
+// stmts개 문장으로 이루어진 프로그램을 생성 (같은 seed면 항상 같은 결과). 메모리 부족 시 false
+bool gen_program(GenBuffer* out, GenKind kind, size_t stmts, uint64_t seed);
+void gen_free(GenBuffer* out);
+
+#endif
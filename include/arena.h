@@ -0,0 +1,37 @@
+#ifndef ARENA_H
+#define ARENA_H
+//========================================
+// System Includes
+//========================================
+#include <stdbool.h>
+#include <stddef.h>
+
+//========================================
+// Arena (bump allocator)
+// 블록 단위로 메모리를 확보하고 포인터만 증가시키며 할당한다.
+// 개별 해제는 없고, arena_reset/arena_free로 한 번에 돌려준다.
+//========================================
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t size;            // data 영역 크기
+    size_t used;
+} ArenaBlock;
+
+typedef struct {
+    ArenaBlock* head;       // 현재 할당 중인 블록 (가장 최근)
+    size_t block_size;      // 기본 블록 크기
+    size_t reserved;        // 시스템에서 확보한 총 바이트 (블록 헤더 포함)
+} Arena;
+
+//========================================
+// Function Prototypes
+//========================================
+void arena_init(Arena* a, size_t block_size);  // block_size 0이면 기본값
+void arena_free(Arena* a);
+void arena_reset(Arena* a);                     // 가장 최근 블록 하나만 남기고 비움
+
+void* arena_alloc(Arena* a, size_t size);       // max_align_t 정렬, 실패 시 NULL
+void* arena_copy(Arena* a, const void* src, size_t size);
+void arena_absorb(Arena* dst, Arena* src);      // src의 블록을 모두 dst로 옮김 (src는 비워짐)
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef ARITH_H
+#define ARITH_H
+//========================================
+// System Includes
+//========================================
+#include <stdint.h>
+
+//========================================
+// Dahdit 정수 연산 규칙 (int32 wrap-around)
+// 모든 실행 경로(VM, 상수 폴딩 등)가 같은 결과를 내도록 한 곳에 정의한다.
+// - 덧셈/뺄셈/곱셈은 2의 보수 wrap-around (C의 부호 있는 오버플로 UB 회피)
+// - 나눗셈/나머지는 C의 truncation 규칙, INT32_MIN / -1 은 INT32_MIN, 나머지는 0
+// - 0으로 나누기 검사는 호출자가 먼저 수행해야 한다
+//========================================
+static inline int32_t ar_add(int32_t lhs, int32_t rhs) { return (int32_t)((uint32_t)lhs + (uint32_t)rhs); }
+static inline int32_t ar_sub(int32_t lhs, int32_t rhs) { return (int32_t)((uint32_t)lhs - (uint32_t)rhs); }
+static inline int32_t ar_mul(int32_t lhs, int32_t rhs) { return (int32_t)((uint32_t)lhs * (uint32_t)rhs); }
+
+static inline int32_t ar_div(int32_t lhs, int32_t rhs) {
+    if (rhs == -1) return ar_sub(0, lhs);
+    return lhs / rhs;
+}
+
+static inline int32_t ar_mod(int32_t lhs, int32_t rhs) {
+    if (rhs == -1) return 0;
+    return lhs % rhs;
+}
+
+#endif
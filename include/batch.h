@@ -0,0 +1,32 @@
+#ifndef BATCH_H
+#define BATCH_H
+//========================================
+// System Includes
+//========================================
+#include "interp.h"
+#include <stdbool.h>
+
+//========================================
+// Batch Runner (여러 .dit 파일을 한 프로세스에서 동시 실행)
+// 워커 스레드마다 Interp 하나를 두고 파일 사이에 interp_reset으로 재사용한다.
+// 파일은 워커별 큐에 나누어 담고, 자기 큐가 빈 워커는 다른 워커의 큐 끝에서 훔쳐 온다.
+// 각 프로그램의 출력과 진단은 따로 모았다가 주어진 파일 순서대로 내보낸다.
+//========================================
+typedef struct {
+    char** files;
+    int count, cap;
+} BatchList;
+
+//========================================
+// Function Prototypes
+//========================================
+void batch_list_init(BatchList* list);
+void batch_list_free(BatchList* list);
+bool batch_list_add(BatchList* list, const char* path);        // 메모리 부족 시 false
+bool batch_list_load(BatchList* list, const char* manifest);   // 한 줄에 경로 하나 (빈 줄, '#' 줄 무시)
+
+// files를 jobs개 스레드로 실행하고 끝에 시간 요약을 stderr로 출력.
+// 모든 파일이 실행되었으면 true (파일을 열 수 없거나 메모리 부족이면 false)
+bool batch_run(const BatchList* list, int jobs, const RunOptions* opts);
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+//========================================
+// System Includes
+//========================================
+#include "parser.h"
+#include "symtab.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+//========================================
+// OpCodes (바이트코드 명령어)
+// 스택 기반. 피연산자(arg)는 상수 값, 변수 슬롯, 문자열/문장 인덱스, 점프 목적지 중 하나.
+// 점프 목적지는 항상 OP_STMT 또는 OP_HALT이므로 도착하면 스택이 그 문장의 base로 맞춰진다.
+// REPEAT의 남은 횟수는 스택 바닥(문장 base 아래)에 두고, 블록이 끝나면 내린다.
+// 하위 루틴 호출은 한 스택에 프레임을 이어 쌓는다: 인자(= 앞쪽 지역 변수) | 나머지 지역 변수 | 피연산자.
+// 프레임 안의 문장 base는 지역 변수 다음부터 센다.
+// 배열 값(배열 전체 또는 원소별 연산 결과)은 스택 칸을 하나 차지하고, 내용은 VM이 그 칸 번호로 따로 둔다.
+//========================================
+typedef enum {
+    OP_STMT,        // arg: 문장 인덱스 (오류 보고 위치와 오류 시 재개 지점 설정)
+    OP_PUSH_CONST,  // arg: 상수 값
+    OP_LOAD_SLOT,   // arg: 변수 슬롯
+    OP_ADD,
+    OP_SUB,
+    OP_MUL,
+    OP_DIV,
+    OP_MOD,
+    OP_PRINT_INT,   // 스택 top 출력
+    OP_PRINT_STR,   // arg: 문자열 인덱스
+    OP_STORE_SLOT,  // arg: 변수 슬롯, 스택 top 저장
+    OP_JUMP,        // arg: 목적지
+    OP_JUMP_FALSE,  // arg: 목적지, 스택 top을 꺼내 0이면 점프
+    OP_REPEAT,      // arg: 블록 끝. 스택 top(횟수)이 0 이하면 꺼내고 점프, 아니면 반복 카운터로 남김
+    OP_LOOP,        // arg: 블록 본문. 스택 top(카운터)을 1 줄여 0보다 크면 점프, 아니면 꺼냄
+    OP_LOAD_LOCAL,  // arg: 현재 프레임의 지역 변수 번호
+    OP_STORE_LOCAL, // arg: 지역 변수 번호, 스택 top 저장
+    OP_CALL,        // arg: 하위 루틴 번호. 스택 top의 인자들로 새 프레임을 열고 본문으로
+    OP_TAIL_CALL,   // arg: 하위 루틴 번호. 현재 프레임을 인자들로 바꿔 재사용 (RETURN f(...) 꼴)
+    OP_RETURN,      // 스택 top을 호출한 쪽 스택에 남기고 프레임을 닫음
+    OP_ARRAY_NEW,   // arg: 배열 슬롯. 스택 top(길이)을 꺼내 원소가 모두 0인 배열로 (음수면 오류)
+    OP_LOAD_ELEM,   // arg: 배열 슬롯. 스택 top(첨자)을 그 원소 값으로 바꿈 (범위 밖이면 오류)
+    OP_STORE_ELEM,  // arg: 배열 슬롯. 값과 그 아래의 첨자를 꺼내 원소에 저장 (범위 밖이면 오류)
+    OP_LOAD_ARRAY,  // arg: 배열 슬롯. 배열 전체를 배열 값으로 넣음
+    OP_VEC,         // arg: ExprOp * 4 + 배열 값인 피연산자 (VEC_LEFT/RIGHT/BOTH). 원소별 연산 (길이가 다르면 오류)
+    OP_STORE_ARRAY, // arg: 배열 슬롯. 스택 top의 배열 값을 꺼내 배열에 복사 (길이도 따라감)
+    OP_FILL_ARRAY,  // arg: 배열 슬롯. 스택 top 값을 꺼내 모든 원소에 저장
+    OP_PRINT_ARRAY, // 스택 top의 배열 값을 한 줄에 공백으로 나눠 출력
+    OP_HALT,
+    OP_COUNT
+} OpCode;
+
+//========================================
+// Instruction (8 bytes)
+//========================================
+typedef struct {
+    uint8_t op;     // OpCode
+    int32_t arg;
+} Instr;
+
+//========================================
+// 문장 정보: 오류 보고 위치와 오류 발생 시 이어서 실행할 명령어 위치
+//========================================
+typedef struct {
+    int64_t line, col;
+    uint32_t end;   // 다음 문장의 첫 명령어 위치 (블록 시작 문장은 블록 끝 다음, 오류가 나면 블록을 건너뜀)
+    uint32_t base;  // 문장 시작 시 스택 깊이 (바깥 REPEAT 카운터 수)
+} StmtInfo;
+
+typedef struct {
+    uint32_t off, len;  // 문자열 풀 내 위치
+} StrRef;
+
+//========================================
+// 하위 루틴 (SUB ... END)
+// 본문은 정의 위치에 그대로 있고, 정의 문장(STMT JUMP)이 실행될 때는 본문을 건너뛴다.
+// 모든 필드가 32비트라 .ditc에 그대로 기록한다.
+//========================================
+typedef struct {
+    int32_t slot;       // 이름 심볼 슬롯
+    uint32_t entry;     // 본문 첫 명령어 (OP_STMT)
+    uint32_t end;       // 본문 끝 다음 (마지막 RETURN 다음)
+    uint32_t nparams;
+    uint32_t nlocals;   // 매개변수 포함 지역 변수 수
+    uint32_t max_stack; // 본문이 지역 변수 위에 쓰는 최대 스택 깊이
+    uint32_t start;     // 정의 문장의 첫 명령어 (지울 때 여기까지 되돌림)
+    uint32_t stmt;      // 정의 문장 인덱스
+    uint32_t nstrs, pool_len;
+} Sub;
+
+//========================================
+// 열린 블록 (END를 만나면 점프 목적지를 채움)
+//========================================
+typedef struct {
+    uint8_t kind;       // STMT_WHILE, STMT_IF, STMT_REPEAT, STMT_SUB
+    bool has_else;
+    uint32_t stmt;      // 시작 문장 인덱스
+    uint32_t start;     // 시작 문장의 첫 명령어 위치 (WHILE은 매 반복 여기서 조건을 다시 계산)
+    uint32_t patch;     // 목적지를 채울 점프 명령어 (JUMP_FALSE / REPEAT / ELSE의 JUMP)
+    uint32_t body;      // 본문 첫 명령어 위치 (REPEAT의 LOOP 목적지)
+    uint32_t base;      // 본문 문장의 base
+    size_t nstrs, pool_len; // 닫히지 않은 블록을 버릴 때 되돌릴 위치
+} Block;
+
+//========================================
+// Chunk (컴파일된 명령어 묶음)
+//========================================
+typedef struct {
+    Instr* code;
+    size_t count, cap;
+    StmtInfo* stmts;
+    size_t nstmts, stmts_cap;
+    StrRef* strs;
+    size_t nstrs, strs_cap;
+    char* pool;                 // 문자열 풀
+    size_t pool_len, pool_cap;
+    int max_stack;              // 실행에 필요한 최대 스택 깊이
+    Block* blocks;              // 컴파일 중 열린 블록 (안쪽이 뒤)
+    size_t nblocks, blocks_cap;
+    size_t entry;               // 실행을 시작할 명령어 (bc_reset_stmts가 남긴 하위 루틴 다음)
+    Sub* subs;
+    size_t nsubs, subs_cap;
+    // 컴파일 중 이름 해석: 슬롯 → 하위 루틴 번호 + 1, 열린 하위 루틴의 슬롯 → 지역 변수 번호 + 1
+    uint32_t* sub_of;
+    size_t sub_of_cap;
+    uint32_t* local_of;
+    size_t local_of_cap;
+    int32_t* scope;             // local_of에 등록한 슬롯 (하위 루틴이 닫히면 지움)
+    size_t nscope, scope_cap;
+    // 컴파일 중 이름 해석: ARRAY 문장을 컴파일한 슬롯 → 1 (그 뒤 문장부터 배열, bc_reset만 지움)
+    uint32_t* array_of;
+    size_t array_of_cap;
+    size_t narrays;             // 배열로 선언된 이름 수
+    uint8_t* shapes;            // 식 컴파일 작업 배열: 스택 칸이 배열 값인지
+    size_t shapes_cap;
+    // bc_reset_stmts가 남기는 앞부분 (닫힌 하위 루틴까지)
+    size_t keep_code, keep_stmts, keep_strs, keep_pool;
+} Chunk;
+
+//========================================
+// Function Prototypes
+//========================================
+void bc_init(Chunk* ch);
+void bc_reset(Chunk* ch);       // 메모리는 유지하고 내용만 비움 (하위 루틴, 배열 이름 포함)
+void bc_reset_stmts(Chunk* ch); // 정의된 하위 루틴은 남기고 그 뒤의 문장만 비움 (문장 단위 실행)
+void bc_drop_subs(Chunk* ch, size_t nsubs);    // nsubs번째 이후 정의된 하위 루틴과 그 뒤를 지움
+void bc_free(Chunk* ch);
+
+// 문장 하나를 컴파일하여 chunk 뒤에 덧붙임. 컴파일 오류는 진단 후 false (코드 미생성)
+// st는 진단에 하위 루틴 이름을 표시하는 데 쓴다.
+bool bc_compile_stmt(Chunk* ch, const Stmt* s, const SymTab* st, const char* filename);
+bool bc_in_block(const Chunk* ch);  // END를 기다리는 블록이 있는지 (있으면 아직 실행할 수 없음)
+void bc_end_blocks(Chunk* ch, const char* filename);    // 입력 끝: 닫히지 않은 블록을 진단하고 그 코드를 버림
+bool bc_finish(Chunk* ch);      // 끝에 OP_HALT 추가
+
+void bc_dump(const Chunk* ch, const SymTab* st, FILE* out);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef CACHE_H
+#define CACHE_H
+//========================================
+// System Includes
+//========================================
+#include "bytecode.h"
+#include "symtab.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//========================================
+// Compiled Program Cache (.ditc)
+// 소스 내용 해시 + 인터프리터 버전 + 컴파일 옵션을 키로, 전체 프로그램의 바이트코드와
+// 심볼 이름을 버전이 붙은 바이너리 형식으로 저장한다. 파일은 mmap으로 매핑하여
+// 복사 없이 그대로 Chunk로 쓴다 (같은 머신 전용, 네이티브 엔디언).
+//
+// 레이아웃: DitcHeader | Instr[ncode] | StmtInfo[nstmts] | Sub[nsubs] | StrRef[nstrs] | pool | names
+// (각 구간은 8바이트 정렬, names는 슬롯 순서의 null-terminated 이름들)
+//========================================
+#define DITC_MAGIC "DITC"
+#define DITC_FORMAT 4
+
+// 이보다 큰 소스는 캐시하지 않는다 (캐시를 만들려면 전체 프로그램을 메모리에 올려야 하므로)
+#ifndef DITC_MAX_SOURCE
+#define DITC_MAX_SOURCE ((size_t)64 << 20)
+#endif
+
+// 헤더 플래그
+#define DITC_OPTIMIZED    0x1u  // -O로 최적화된 바이트코드
+#define DITC_UNCACHEABLE  0x2u  // 컴파일 진단이 있어 캐시하지 않는 소스 (다음 실행에서 재시도하지 않음)
+
+typedef struct {
+    char magic[4];          // DITC_MAGIC
+    uint32_t format;        // DITC_FORMAT
+    char version[16];       // DAHDIT_VERSION
+    uint64_t src_hash;      // 소스 내용 해시 (cache_hash)
+    uint64_t src_size;
+    uint32_t flags;
+    int32_t max_stack;
+    uint64_t ncode, nstmts, nsubs, nstrs, pool_len;
+    uint64_t nsyms, names_len;
+    uint64_t checksum;      // 파일 전체의 해시 (이 필드는 0으로 계산, 손상된 파일은 다시 만든다)
+} DitcHeader;
+
+_Static_assert(sizeof(DitcHeader) % 8 == 0, "DitcHeader must keep sections 8-byte aligned");
+
+typedef enum {
+    CACHE_MISS,             // 캐시 없음 / 키 불일치 / 손상 → 다시 만들어야 함
+    CACHE_HIT,              // dc->chunk와 심볼 이름을 그대로 사용 가능
+    CACHE_UNCACHEABLE,      // 같은 소스가 이전에 캐시 불가로 기록됨
+} CacheStatus;
+
+//========================================
+// Loaded Cache (매핑된 캐시 파일)
+// chunk의 배열은 매핑을 직접 가리키므로 bc_free하지 말고 cache_close로 해제한다.
+//========================================
+typedef struct {
+    void* map;
+    size_t size;
+    Chunk chunk;
+    const char* names;      // 슬롯 순서의 이름들
+    uint64_t nsyms;
+} DitCache;
+
+//========================================
+// Function Prototypes
+//========================================
+uint64_t cache_hash(const char* data, size_t size);
+char* cache_path(const char* filename);    // "prog.dit" → "prog.ditc" (malloc, 실패 시 NULL)
+
+// 키(src_hash, src_size, flags)가 맞고 내용 검증을 통과하면 CACHE_HIT
+CacheStatus cache_load(DitCache* dc, const char* path, uint64_t src_hash, uint64_t src_size, uint32_t flags);
+bool cache_intern(const DitCache* dc, SymTab* st);     // 이름을 캐시와 같은 슬롯 번호로 등록
+void cache_close(DitCache* dc);
+
+// ch/st를 캐시로 저장 (임시 파일에 쓴 뒤 rename). ch가 NULL이면 캐시 불가 표시만 기록
+bool cache_save(const char* path, uint64_t src_hash, uint64_t src_size, uint32_t flags,
+                const Chunk* ch, const SymTab* st);
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef DAHDIT_H
+#define DAHDIT_H
+//========================================
+// System Includes
+//========================================
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//========================================
+// libdahdit: 임베딩용 공개 API
+// 컨텍스트 단위로 동작한다 (출력, 진단 콜백과 진단 형식/접기/오류 수 제한도 컨텍스트마다 따로).
+// 서로 다른 컨텍스트는 각자 다른 스레드에서 동시에 실행할 수 있고, 하나의 컨텍스트는 한 번에 한 스레드에서만 사용한다.
+// 변수는 같은 컨텍스트의 실행 사이에 유지되며 dahdit_reset으로 지운다.
+//========================================
+typedef struct DahditContext DahditContext;
+
+// 프로그램 출력 콜백. false를 돌려주면 쓰기 실패로 처리 (NULL이면 표준 출력)
+typedef bool (*DahditWriteFn)(void* user, const char* data, size_t len);
+// 진단 메시지 콜백. text는 줄바꿈을 포함한 한 건 이상의 메시지 (NULL이면 표준 에러)
+typedef void (*DahditDiagFn)(void* user, const char* text, size_t len);
+
+typedef struct {
+    DahditWriteFn write;
+    DahditDiagFn diag;
+    void* user;             // 두 콜백에 그대로 전달
+    bool optimize;          // -O
+    int parallel;           // --parallel=N (0이면 끔)
+    bool line_buffered;     // 줄바꿈마다 출력 콜백 호출 (기본은 버퍼가 차거나 실행이 끝날 때)
+    bool jit;               // --jit (x86-64 Linux가 아니면 무시)
+    bool diag_json;         // --diag-format=json
+    bool diag_fold;         // --diag-fold
+    unsigned max_errors;    // --max-errors=N: 한 번의 실행에서 오류가 N개 나오면 중단 (0이면 제한 없음)
+} DahditConfig;
+
+//========================================
+// Function Prototypes
+//========================================
+DahditContext* dahdit_create(const DahditConfig* config);  // config가 NULL이면 기본값, 실패 시 NULL
+void dahdit_destroy(DahditContext* ctx);
+void dahdit_reset(DahditContext* ctx);                      // 변수를 모두 지움 (확보한 메모리는 재사용)
+
+// 프로그램 실행. 구문/실행 오류는 진단 콜백으로 보고하며 실행 자체는 성공으로 친다.
+// 소스를 열거나 읽을 수 없거나, 메모리가 부족하거나, 출력에 실패하면 false (max_errors에 도달해 중단된 경우도)
+bool dahdit_run_buffer(DahditContext* ctx, const char* name, const char* data, size_t size);
+bool dahdit_run_file(DahditContext* ctx, const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,5 +1,98 @@
 #ifndef DIAG_H
 #define DIAG_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
 
-void diag_error(const char* file, int line, int col, const char* msg);
-#endif
\ No newline at end of file
+//========================================
+// Diagnostic Codes (진단 코드)
+// 심각도와 JSON 출력의 "code"는 코드로 정해진다. 같은 코드와 같은 메시지가 연속되면 "같은 진단"이다.
+//========================================
+typedef enum {
+    DIAG_LEX,           // E101 알 수 없는 모스 부호 / 문자
+    DIAG_STRING,        // E102 닫히지 않은 문자열
+    DIAG_SYNTAX,        // E201 구문 오류
+    DIAG_COMPILE,       // E301 식을 컴파일할 수 없음
+    DIAG_UNDEFINED,     // E401 정의되지 않은 변수
+    DIAG_DIV_ZERO,      // E402 0으로 나누기 / 나머지
+    DIAG_CALL_DEPTH,    // E403 하위 루틴 호출 깊이 제한 초과
+    DIAG_INDEX,         // E404 배열 첨자가 범위를 벗어남
+    DIAG_ARRAY_LENGTH,  // E405 음수 배열 길이 / 길이가 다른 배열끼리 연산
+    DIAG_NOMEM,         // E901 메모리 부족
+    DIAG_INTERNAL,      // E902 내부 오류
+    DIAG_TOO_MANY,      // E903 오류 수 제한에 도달하여 중단 (fatal)
+} DiagCode;
+
+//========================================
+// Diagnostic Output Options (출력 형식 / 접기 / 제한)
+// 기본값은 프로세스 전체 설정이며 실행 전에 한 번 정한다 (diag_configure).
+// 싱크가 설정을 가지고 있으면 그 스레드에서는 싱크의 설정을 쓴다 (라이브러리 컨텍스트별 설정).
+// - fold: 같은 진단이 연달아 나오면 첫 번째 하나에 횟수와 마지막 위치를 붙여 출력
+// - max_errors: 한 프로그램(파일)에서 오류가 이만큼 나오면 중단 진단을 낸 뒤 그 프로그램의 실행을 멈춤 (0이면 제한 없음)
+// - json: 한 줄에 진단 하나씩 JSON 객체로 출력
+// stderr가 터미널이 아니면 진단을 DIAG_BUFFER_SIZE만큼 모아서 쓴다 (diag_sync, 프로그램 종료 시 비움).
+//========================================
+typedef enum {
+    DIAG_FORMAT_TEXT,   // file:line:col: error: message
+    DIAG_FORMAT_JSON,   // {"file":..,"line":..,"column":..,"severity":..,"code":..,"message":..,"count":..}
+} DiagFormat;
+
+typedef struct {
+    DiagFormat format;
+    bool fold;
+    unsigned max_errors;
+} DiagConfig;
+
+#ifndef DIAG_BUFFER_SIZE
+#define DIAG_BUFFER_SIZE (64 * 1024)
+#endif
+
+//========================================
+// Diagnostic Capture (진단 임시 보관)
+// 병렬 파싱 워커는 진단을 바로 출력하지 않고 모아 두었다가, 병합 시 소스 순서대로 내보낸다.
+// text는 기본 형식으로 포맷된 메시지, recs는 그 안의 각 진단 구간과 코드/위치 (출력 단계에서 접기/제한/JSON에 사용)
+//========================================
+typedef struct {
+    size_t off;         // text 안의 시작 위치 (줄바꿈까지 한 줄)
+    uint32_t len;
+    uint32_t file_len;  // 위치 있는 진단: text[off, off + file_len)이 파일 이름
+    uint32_t msg_off;   // 메시지 시작 (off 기준), 위치 없는 메시지면 0
+    int16_t code;       // DiagCode, 위치 없는 메시지면 -1
+    int64_t line, col;
+} DiagRecord;
+
+typedef struct {
+    char* text;     // 포맷된 진단 메시지들 (줄바꿈 포함)
+    size_t len, cap;
+    DiagRecord* recs;
+    size_t nrecs, recs_cap;
+} DiagBuffer;
+
+//========================================
+// Diagnostic Sink (최종 출력 대상)
+// 기본은 stderr. 라이브러리 컨텍스트는 실행하는 동안 자신의 콜백과 출력 설정을 설치한다.
+//========================================
+typedef void (*DiagSinkFn)(void* user, const char* text, size_t len);
+
+typedef struct {
+    DiagSinkFn fn;              // NULL이면 stderr
+    void* user;
+    const DiagConfig* config;   // NULL이면 diag_configure로 정한 프로세스 설정
+} DiagSink;
+
+void diag_error(DiagCode code, const char* file, int64_t line, int64_t col, const char* msg);
+void diag_message(const char* fmt, ...);        // 위치 없는 메시지 (printf 형식, 줄바꿈 포함)
+
+void diag_configure(const DiagConfig* config);  // 스레드를 만들기 전에 호출
+void diag_begin_run(void);                      // 현재 스레드에서 새 프로그램 시작: 오류 수와 중단 상태 초기화
+bool diag_stopped(void);                        // 현재 스레드의 프로그램이 오류 수 제한으로 중단되었는지
+void diag_sync(void);                           // 접어 둔 진단과 stderr 버퍼를 내보냄 (다른 stderr 출력 전에)
+
+DiagSink diag_set_sink(DiagSink sink);          // 현재 스레드의 최종 출력 대상 설정, 이전 값 반환 (바꾸기 전에 diag_sync)
+
+DiagBuffer* diag_capture(DiagBuffer* buf);      // 현재 스레드의 진단을 buf에 모음 (NULL이면 싱크/stderr로 복귀), 이전 대상 반환
+void diag_truncate(DiagBuffer* buf, size_t len);    // 모은 진단을 앞의 len바이트(진단 경계)까지만 남김
+void diag_flush(DiagBuffer* buf, FILE* fp);     // 모은 진단을 fp로 출력 (fp가 NULL이면 버림) 후 해제
+void diag_forward(const DiagBuffer* buf, size_t begin, size_t end); // 모은 진단 [begin, end)를 현재 스레드의 출력 대상으로 전달
+#endif
@@ -0,0 +1,30 @@
+#ifndef EMIT_C_H
+#define EMIT_C_H
+//========================================
+// System Includes
+//========================================
+#include "interp.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+//========================================
+// C Backend (--emit-c)
+// 프로그램을 하나의 독립된 C 번역 단위로 변환한다. 시스템 C 컴파일러로 빌드하면
+// 인터프리터 없이 같은 출력과 같은 진단(위치·문구·순서)을 내는 실행 파일이 된다.
+// - 변수는 int32_t 값과 정의 여부 플래그 (파일 범위 static), 식은 바이트코드 순서대로 임시 지역 변수에 계산
+// - 문장은 일정 개수씩 함수로 나뉘어 main에서 차례로 호출된다 (큰 프로그램의 C 컴파일 시간 제한)
+// - 하위 루틴은 지역 변수를 매개변수/지역 변수로 갖는 C 함수가 되고, 자기 꼬리 호출은 함수 처음으로 가는 goto가 된다
+// - 정수 연산 규칙은 arith.h와 같다 (생성 코드에 같은 정의를 넣는다)
+// - 구문/컴파일 진단은 인터프리터가 출력하는 시점에 같은 문자열을 stderr로 내보내고,
+//   런타임 오류는 미리 포맷한 진단을 출력한 뒤 다음 문장으로 건너뛴다
+// -O이면 최적화한 프로그램을 번역하며, 진단은 인터프리터의 -O와 같이 실행보다 먼저 나온다.
+//========================================
+
+//========================================
+// Function Prototypes
+//========================================
+// filename("-"이면 표준 입력)의 프로그램을 C로 변환하여 out에 씀. 구문 진단은 현재 진단 대상으로도 출력한다.
+// 파일을 열 수 없거나, 메모리가 부족하거나, 쓰기에 실패하면 false
+bool emit_c_file(const char* filename, const RunOptions* opts, FILE* out);
+
+#endif
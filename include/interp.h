@@ -4,11 +4,88 @@
 //========================================
 // System Includes
 //========================================
+#include "output.h"
+#include "symtab.h"
+#include "bytecode.h"
+#include "vm.h"
+#include "jit.h"
+#include "lexer.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 //========================================
-// 파일에서 Dashdit 프로그램을 로드, 파싱 및 실행
+// Run Options (실행 옵션)
 //========================================
-bool run_program(const char* filename);
+typedef struct {
+    bool dump_bytecode;     // 실행 대신 컴파일된 바이트코드 목록을 출력 (--dump-bytecode)
+    bool optimize;          // 전체 프로그램 최적화 후 실행 (-O)
+    bool opt_report;        // 최적화 내역을 stderr에 출력 (--opt-report, -O 포함)
+    bool pipeline;          // 렉서/파서/실행기를 각각 다른 스레드에서 (--pipeline, -O/--parallel이 우선)
+    int parallel;           // 병렬 파싱 워커 수, 0이면 사용 안 함 (--parallel[=N])
+    bool profile;           // 종료 시 단계별 시간/카운터/메모리 요약을 stderr에 출력 (--profile)
+    OutFlush flush;         // PRINT 출력 비우기 정책 (--flush=, 기본은 터미널 여부로 결정)
+    bool no_cache;          // 컴파일 캐시(.ditc)를 읽지도 쓰지도 않음 (--no-cache)
+    bool jit;               // 전체 프로그램을 x86-64 기계어로 번역해 실행 (--jit, 지원하지 않으면 VM)
+    bool vars_live_out;     // 실행 후에도 변수 값을 읽음: -O가 마지막 저장을 지우지 않고 캐시도 쓰지 않음
+    const char* load_state; // 실행 전에 변수 상태 이미지를 불러옴 (--load-state=FILE)
+    const char* save_state; // 실행 후 변수 상태를 이미지로 저장 (--save-state=FILE, vars_live_out 함의)
+} RunOptions;
 
-#endif
\ No newline at end of file
+//========================================
+// Hot Programs (--jit)
+// 같은 Interp에서 다시 실행되는 프로그램의 컴파일 결과를 소스 해시로 찾아 렉싱·파싱 없이 재실행한다.
+// 한 번만 실행되는 코드는 번역 비용이 실행 비용보다 크므로, INTERP_JIT_RUNS번째 실행부터 기계어로 번역한다.
+//========================================
+#ifndef INTERP_HOT_PROGRAMS
+#define INTERP_HOT_PROGRAMS 8
+#endif
+#ifndef INTERP_JIT_RUNS
+#define INTERP_JIT_RUNS 2
+#endif
+
+typedef struct {
+    bool used;
+    uint64_t src_hash, src_size;
+    uint32_t generation;    // 슬롯 번호가 유효한 심볼 테이블 세대 (SymTab.generation)
+    char* names;            // 빈 심볼 테이블에서 컴파일했으면 슬롯 순서의 이름들 (초기화 후 다시 등록용)
+    size_t nsyms;
+    unsigned runs;
+    uint64_t last_use;
+    bool jit_failed;        // 번역할 수 없음 (지원하지 않는 플랫폼/명령어) → VM으로 실행
+    Chunk ch;
+    JitCode* jit;
+} HotProgram;
+
+//========================================
+// Interpreter (실행 상태: 변수, 바이트코드 버퍼, VM)
+// 여러 프로그램을 차례로 실행해도 확보한 메모리를 재사용한다. 변수는 interp_reset 전까지 유지된다.
+// 서로 다른 Interp는 각자 다른 스레드에서 동시에 사용할 수 있다.
+//========================================
+typedef struct {
+    RunOptions opts;
+    SymTab st;
+    Chunk ch;
+    VM vm;
+    HotProgram hot[INTERP_HOT_PROGRAMS];
+    uint64_t tick;          // hot[].last_use 기준
+} Interp;
+
+//========================================
+// Function Prototypes
+//========================================
+void interp_init(Interp* it, const RunOptions* opts, Output* out); // out은 it보다 오래 유지되어야 함
+void interp_free(Interp* it);
+void interp_reset(Interp* it);     // 변수와 배열을 모두 지움 (메모리는 유지)
+
+// 파일("-"이면 표준 입력) / 메모리 버퍼의 프로그램을 실행. 메모리 부족이나 입출력 오류면 false
+bool interp_run_file(Interp* it, const char* filename);
+bool interp_run_buffer(Interp* it, const char* name, const char* data, size_t size);
+
+// 전체 프로그램을 먼저 파싱하는 모드인지 (-O, --parallel, --jit), 그 경우의 파싱·최적화·컴파일 (메모리 부족이면 false)
+bool whole_program(const RunOptions* opts);
+bool compile_whole(Lexer* lx, SymTab* st, Chunk* ch, const RunOptions* opts);
+
+// 파일에서 Dashdit 프로그램을 로드, 파싱 및 실행 (표준 출력/표준 에러 사용)
+bool run_program(const char* filename, const RunOptions* opts);
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef JIT_H
+#define JIT_H
+//========================================
+// System Includes
+//========================================
+#include "bytecode.h"
+#include "vm.h"
+#include <stdbool.h>
+
+//========================================
+// JIT (chunk → x86-64 기계어, --jit)
+// chunk 전체를 한 함수로 번역한다. 피연산자 스택은 레지스터에 두고 (깊이가 깊으면 VM 스택으로),
+// 변수 미정의/0으로 나누기 검사는 문장마다 별도의 오류 경로로 빠져 vm_report로 진단한 뒤 다음 문장으로 이어간다.
+// 정수 연산 규칙은 arith.h와 같다 (wrap-around, truncation, INT32_MIN / -1).
+// x86-64 Linux가 아니거나, 하위 루틴(SUB)이나 배열 명령어가 있거나, 실행 가능한 메모리를 얻지 못하면
+// jit_compile이 NULL을 돌려주며, 호출자는 vm_run으로 실행한다. 생성한 코드는 chunk의 문자열/문장 정보를 직접 가리키므로
+// chunk가 바뀌거나 해제되기 전에 jit_free해야 한다.
+//========================================
+typedef struct JitCode JitCode;
+
+//========================================
+// Function Prototypes
+//========================================
+bool jit_supported(void);               // 이 빌드/플랫폼에서 JIT를 쓸 수 있는지
+JitCode* jit_compile(const Chunk* ch);  // 지원하지 않는 명령어나 플랫폼이면 NULL
+bool jit_run(const JitCode* jc, VM* vm); // vm_run과 같은 의미 (스택 메모리 부족 시 false)
+void jit_free(JitCode* jc);
+
+#endif
@@ -5,6 +5,9 @@
 //========================================
 #include <stdio.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "scan.h"
 
 //========================================
 // Token Kinds (토큰 종류)
@@ -31,30 +34,77 @@ typedef enum {
 } TokenKind;
 
 //========================================
-// Token Structure (토큰 구조체)
+// Token Structure (토큰 구조체, 16 bytes)
+// 문자열 등 원문은 복사하지 않고 소스 버퍼의 스팬(off, len)으로만 가리킨다.
+// 위치(line, col)는 렉서가 마지막 토큰 기준으로 보관 (tok_line, tok_col)
 //========================================
 typedef struct {
-    TokenKind kind;
+    uint8_t kind;   // TokenKind
     char ch;        // TK_LETTER 일 때만 유효
-    char text[128]; // TK_STRING 일 때만 유효 (null-terminated)
-    int line, col;  // 토큰 시작 위치
+    uint32_t len;   // 스팬 길이 (TK_STRING은 따옴표 제외 내용 길이)
+    uint64_t off;   // 스팬 시작 오프셋 (소스 버퍼 기준)
 } Token;
 
+_Static_assert(sizeof(Token) == 16, "Token must stay 16 bytes");
+
+//========================================
+// Token Stream (SoA 토큰 스트림)
+// lx_tokenize()가 파일 전체를 토큰화한 결과. 마지막 항목은 TK_EOF.
+//========================================
+typedef struct {
+    const char* filename;
+    const char* src;    // 스팬이 가리키는 소스 버퍼
+    uint8_t* kinds;
+    char* chs;
+    uint32_t* lens;
+    uint64_t* offs;
+    int64_t* lines;
+    int64_t* cols;
+    size_t count, cap;
+} TokenStream;
+
+//========================================
+// Source Backing (소스 버퍼 확보 방식)
+//========================================
+typedef enum {
+    LX_SRC_NONE = 0, // 빈 파일 (버퍼 없음)
+    LX_SRC_MMAP,     // 일반 파일: mmap으로 통째로 매핑
+    LX_SRC_HEAP,     // 파이프 등: read()로 힙 버퍼에 적재
+    LX_SRC_BORROWED, // lx_open_buffer: 호출자가 소유한 메모리 (해제하지 않음)
+} LexerSource;
+
+// 파일 이름 "-"(표준 입력)일 때 진단에 표시하는 이름
+#define LX_STDIN_NAME "<stdin>"
+
 //========================================
 // Lexer Structure (렉서 상태 구조체)
 //========================================
 typedef struct {
     const char *filename;
-    FILE *fp;
-    int line, col;
+    const char *buf; // 소스 전체 버퍼 시작
+    const char *p;   // 다음에 읽을 위치
+    const char *end; // 버퍼 끝
+    size_t size;     // 버퍼 크기 (bytes)
+    LexerSource src;
+    int64_t line, col;     // 2 GB를 넘는 입력/줄에서도 위치가 넘치지 않도록 64비트
+    int64_t tok_line, tok_col; // 마지막으로 반환한 토큰의 시작 위치
     int cur; // current char (lookahead)
+    const ScanOps* scan; // 문자 분류 스캔 구현 (CPU에 따라 SIMD/스칼라)
 } Lexer;
 
 //========================================
 // Function Prototypes (함수 원형)
 //========================================
 bool lx_open(Lexer *lx, const char *filename);
+void lx_open_buffer(Lexer *lx, const char *name, const char *data, size_t size); // 메모리 상의 소스 (복사하지 않음)
+void lx_open_slice(Lexer *lx, const char *name, const char *data, size_t size, int64_t line, int64_t col); // 소스 일부 (시작 위치 지정)
 void lx_close(Lexer *lx);
+void lx_rewind(Lexer *lx); // 같은 소스를 처음부터 다시 렉싱
 Token lx_next(Lexer *lx); // 다음 토큰
+const char* lx_token_text(const Lexer* lx, const Token* tok); // 토큰 스팬 원문
+size_t lx_memory(const Lexer* lx); // 소스 버퍼 크기 (bytes)
+
+bool lx_tokenize(Lexer* lx, TokenStream* ts); // 파일 전체 → SoA 토큰 스트림
+void ts_free(TokenStream* ts);
 
 #endif
@@ -7,6 +7,15 @@
 //========================================
 typedef struct { const char* code; char ch; } MorseEntry;
 
+//========================================
+// 디코딩 인덱스 설정 (tools/morse_gen.c가 빌드 시 morse_index.h 생성)
+// MORSE_MAX_CODE_LEN: 테이블에 등록 가능한 부호의 최대 길이
+// MORSE_PRIORITY_CHARS: 같은 부호의 다른 항목보다 우선 매칭되는 문자
+//========================================
+#define MORSE_MAX_CODE_LEN 7
+#define MORSE_INDEX_SIZE (1 << (MORSE_MAX_CODE_LEN + 1))
+#define MORSE_PRIORITY_CHARS "+-*/%="
+
 static const MorseEntry MORSE_TABLE[] = {
     //========================================
     // Letters (영문)
@@ -0,0 +1,34 @@
+#ifndef OPTIMIZE_H
+#define OPTIMIZE_H
+//========================================
+// System Includes
+//========================================
+#include "program.h"
+#include "symtab.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+//========================================
+// Optimizer Statistics (최적화 결과 요약)
+//========================================
+typedef struct {
+    int folded;         // 컴파일 시 계산된 상수 연산 수
+    int propagated;     // 상수 값으로 대체된 변수 참조 수
+    int cse;            // 이전 변수 값으로 대체된 공통 부분식 수
+    int dead_stores;    // 제거된 VAR 문장 수
+} OptStats;
+
+//========================================
+// Function Prototypes
+//========================================
+
+// 전체 프로그램 최적화: 상수 폴딩/전파, 공통 부분식 제거, 죽은 저장 제거.
+// 실행 결과와 진단(0으로 나누기, 미정의 변수)은 최적화 전과 동일하게 유지된다.
+// report가 NULL이 아니면 제거된 문장을 note로 기록한다.
+// live_out이면 실행 후에도 변수 값이 쓰이므로 (상태 저장, 라이브러리 재사용) 마지막 저장을 남긴다.
+// 메모리 부족 시 false를 반환하지만, 그때까지 적용된 변환은 그대로 유효하다.
+bool opt_program(Program* prog, const SymTab* st, const char* filename, FILE* report, bool live_out,
+                 OptStats* stats);
+void opt_print_stats(const OptStats* stats, FILE* out);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+//========================================
+// System Includes
+//========================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//========================================
+// Flush Policy (출력 비우기 정책)
+//========================================
+typedef enum {
+    OUT_FLUSH_AUTO,         // 터미널이면 LINE, 아니면 FULL (stdio 기본 동작과 동일)
+    OUT_FLUSH_FULL,         // 버퍼가 가득 찰 때만 write()
+    OUT_FLUSH_LINE,         // 줄바꿈마다 write()
+    OUT_FLUSH_EXPLICIT      // out_flush 호출 전까지 모아 둠 (버퍼를 늘려 가며 보관)
+} OutFlush;
+
+// 버퍼를 fd 대신 넘겨받는 콜백 (임베딩용). false를 반환하면 이후 출력을 버림
+typedef bool (*OutSinkFn)(void* user, const char* data, size_t len);
+
+//========================================
+// Output (write()로 직접 내보내는 사용자 공간 버퍼)
+//========================================
+typedef struct {
+    int fd;
+    OutSinkFn sink;         // NULL이 아니면 fd 대신 사용
+    void* sink_user;
+    OutFlush policy;        // AUTO는 out_init에서 FULL/LINE으로 결정됨
+    char* buf;
+    size_t len, cap;
+    bool failed;            // write() 실패 이후로는 출력을 버림
+} Output;
+
+#define OUT_BUFFER_SIZE (64 * 1024)
+#define OUT_INT_MAX_LEN 11  // "-2147483648"
+
+//========================================
+// Function Prototypes
+//========================================
+void out_init(Output* out, int fd, OutFlush policy);
+void out_init_sink(Output* out, OutSinkFn sink, void* user, OutFlush policy); // AUTO는 FULL
+void out_free(Output* out);                             // 남은 내용을 flush한 뒤 해제
+bool out_flush(Output* out);                            // 실패 시 false
+
+void out_write(Output* out, const char* s, size_t n);
+void out_line(Output* out, const char* s, size_t n);    // s + '\n'
+void out_int_line(Output* out, int32_t v);              // 십진수 + '\n'
+void out_ints_line(Output* out, const int32_t* v, size_t n); // 공백으로 나눈 십진수 n개 + '\n'
+
+// dst에 v의 십진 표현을 기록 (null 종단 없음), 기록한 길이 반환. dst는 OUT_INT_MAX_LEN 이상
+size_t out_format_i32(char* dst, int32_t v);
+
+// "full" / "line" / "explicit" / "auto" 문자열을 정책으로 변환
+bool out_parse_policy(const char* name, OutFlush* policy);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+//========================================
+// System Includes
+//========================================
+#include "lexer.h"
+#include "symtab.h"
+#include "program.h"
+#include <stdbool.h>
+
+//========================================
+// Parallel Front End (병렬 렉싱/파싱)
+// 소스를 문장 경계(';' 직후)에서 청크로 나누어 워커 스레드마다 독립적으로 렉싱·파싱한 뒤,
+// 소스 순서대로 하나의 Program으로 합친다. 실행은 호출자가 순차적으로 한다.
+//========================================
+
+// 청크 하나의 최소 크기. 이보다 작은 파일은 나누지 않고 현재 스레드에서 파싱한다
+#ifndef PAR_MIN_CHUNK
+#define PAR_MIN_CHUNK (256 * 1024)
+#endif
+
+//========================================
+// Function Prototypes
+//========================================
+int par_default_threads(void);     // 사용 가능한 CPU 수
+
+// lx의 소스 버퍼 전체를 최대 threads개 청크로 나누어 파싱하고 prog에 이어 붙임.
+// 진단은 순차 파싱과 같은 순서로 출력되며, 치명적 구문 오류 이후의 문장/진단은 버린다.
+// 슬롯은 st에 순차 파싱과 같은 순서로 등록된다. 메모리 부족 시 false.
+bool par_parse(Program* prog, const Lexer* lx, SymTab* st, int threads);
+
+#endif
@@ -4,6 +4,8 @@
 // System Includes
 //========================================
 #include "lexer.h"
+#include "symtab.h"
+#include "arena.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -12,11 +14,29 @@
 // PRINT <expr> ; (정수 출력)
 // PRINT_STR <string> ; (문자열 출력)
 // VAR <name> = <expr> ; (변수 선언 및 할당)
+// VAR <name>(<index>) = <expr> ; (배열 원소에 대입. 배열 이름에 첨자 없이 대입하면 배열 전체를 바꿈)
+// WHILE <expr> ; ... END ; (식이 0이 아닌 동안 반복)
+// IF <expr> ; ... [ELSE ; ...] END ; (식이 0이 아니면 앞 블록, 아니면 ELSE 블록)
+// REPEAT <expr> ; ... END ; (식의 값만큼 반복, 횟수는 들어갈 때 한 번만 계산)
+// SUB <name>(<param>, ...) ; ... END ; (하위 루틴 정의, 최상위에서만. 호출은 식 안의 NAME(<expr>, ...))
+// RETURN [<expr>] ; (하위 루틴에서 값을 돌려주고 끝냄, 식이 없으면 0)
+// ARRAY <name>(<length>) ; (정수 배열 선언, 원소는 0. 식 안에서 NAME(<index>)는 원소, NAME은 배열 전체)
+// NONE: 구문 오류 후 복구되어 실행할 내용이 없는 문장
+// 블록 문장은 파서가 한 문장씩 평평하게 돌려주며, 짝 맞추기는 컴파일러(bc_compile_stmt)가 한다.
 //========================================
 typedef enum {
     STMT_PRINT,
     STMT_PRINT_STR,
-    STMT_VAR
+    STMT_VAR,
+    STMT_WHILE,
+    STMT_IF,
+    STMT_ELSE,
+    STMT_REPEAT,
+    STMT_END,
+    STMT_SUB,
+    STMT_RETURN,
+    STMT_ARRAY,
+    STMT_NONE
 } StmtKind;
 
 //========================================
@@ -26,6 +46,7 @@ typedef enum {
     EXPR_ITEM_NUMBER,
     EXPR_ITEM_VAR,
     EXPR_ITEM_OP,
+    EXPR_ITEM_CALL,     // 앞의 인자 argc개를 꺼내 하위 루틴을 호출하고 결과를 넣음 (배열이면 인자 하나가 첨자)
 } ExprItemKind;
 
 //========================================
@@ -46,18 +67,21 @@ typedef struct {
     ExprItemKind kind;
     union {
         int32_t number;     // 리터럴 숫자 값
-        char var[64];       // 변수 이름 (식별자)
+        int32_t slot;       // 변수 심볼 슬롯 (파싱 시 해석, 이름은 st_name)
         ExprOp op;          // 연산자 종류
+        struct {
+            int32_t slot;   // 하위 루틴 / 배열 이름 슬롯
+            int32_t argc;
+        } call;
     } as;
 } ExprItem;
 
-#define MAX_EXPR_ITEMS 64
-
 //========================================
 // Expression Structure (표현식 전체)
+// 항목 배열은 Parser의 arena에 식 길이만큼만 할당된다 (길이 제한 없음).
 //========================================
 typedef struct {
-    ExprItem items[MAX_EXPR_ITEMS];
+    ExprItem* items;
     int count;
 } Expr;
 
@@ -69,42 +93,97 @@ typedef struct {
 } PrintStmt;
 
 typedef struct {
-    char text[128];     // 출력할 문자열 리터럴 (TK_STRING 내용)
+    const char* text;   // 출력할 문자열 (arena에 할당, null-terminated)
+    size_t len;         // 문자열 길이 (길이 제한 없음)
 } PrintStrStmt;
 
 typedef struct {
-    char name[64];      // 변수 이름
+    int32_t slot;       // 변수 심볼 슬롯
     bool has_value;     // 할당 값 유무
     Expr value_expr;    // 할당될 표현식
+    bool indexed;       // 배열 원소 대입
+    Expr index_expr;    // 원소 첨자
 } VarStmt;
 
+typedef struct {
+    Expr expr;          // WHILE/IF의 조건, REPEAT의 반복 횟수
+} CondStmt;
+
+typedef struct {
+    int32_t slot;       // 하위 루틴 이름 슬롯
+    int32_t* params;    // 매개변수 슬롯 (arena에 할당)
+    int nparams;
+} SubStmt;
+
+typedef struct {
+    bool has_value;     // 없으면 0을 돌려줌
+    Expr expr;
+} ReturnStmt;
+
+typedef struct {
+    int32_t slot;       // 배열 이름 슬롯
+    Expr length_expr;   // 원소 수
+} ArrayStmt;
+
 //========================================
 // Main Statement Structure
 //========================================
 typedef struct {
     StmtKind kind;
-    int line, col;
+    int64_t line, col;
     union {
         PrintStmt printStmt;
         PrintStrStmt printStrStmt;
         VarStmt varStmt;
+        CondStmt condStmt;  // STMT_WHILE, STMT_IF, STMT_REPEAT
+        SubStmt subStmt;
+        ReturnStmt returnStmt;
+        ArrayStmt arrayStmt;
     };
 } Stmt;
 
+//========================================
+// Token Feed (다른 스레드 등 외부에서 토큰을 하나씩 공급받는 경우)
+// next는 다음 토큰과 그 위치를 돌려주며, 입력이 끝나면 TK_EOF를 계속 반환해야 한다.
+//========================================
+typedef struct {
+    Token (*next)(void* ctx, int64_t* line, int64_t* col);
+    void* ctx;
+    const char* const* src; // 토큰 스팬이 가리키는 소스 버퍼 (공급원이 배치마다 바꿀 수 있음)
+} TokenFeed;
+
 //========================================
 // Parser State Structure
-// Lexer: 렉서 포인터
-// Token: 현재 토큰 (Lookahead)
+// Lexer / TokenStream / TokenFeed: 토큰 공급원 (셋 중 하나만 사용)
+// Token: 현재 토큰 (Lookahead), line/col: 현재 토큰 위치
 //========================================
 typedef struct {
     Lexer* lx;
+    const TokenStream* ts;
+    size_t ti;              // ts 사용 시 다음 토큰 인덱스
+    TokenFeed feed;
+    const char* filename;
+    SymTab* st;             // 식별자 → 슬롯 해석용
+    Arena* arena;           // 문장의 식/문자열이 할당되는 곳
     Token cur;
+    int64_t line, col;
+    char* text;             // PRINT 문자열 작업 버퍼
+    size_t text_len, text_cap;
+    char* word;             // parse_word 결과 (null-terminated)
+    size_t word_len, word_cap;
+    ExprItem* items;        // 파싱 중인 식의 작업 배열
+    size_t items_cap;
+    int arg_depth;          // 호출 인자/매개변수 목록 중첩 깊이 (0보다 크면 ',' ')'가 단어를 끊음)
 } Parser;
 
 //========================================
 // Function Prototypes
 //========================================
-void ps_init(Parser* ps, Lexer* lx);
+void ps_init(Parser* ps, Lexer* lx, SymTab* st, Arena* arena);
+void ps_init_stream(Parser* ps, const TokenStream* ts, SymTab* st, Arena* arena); // 미리 토큰화된 스트림에서 파싱
+void ps_init_feed(Parser* ps, TokenFeed feed, const char* filename, SymTab* st, Arena* arena); // 외부 공급 토큰으로 파싱
+void ps_free(Parser* ps);
+size_t ps_memory(const Parser* ps); // 작업 버퍼 + arena가 확보한 바이트 수
 bool ps_next_stmt(Parser* ps, Stmt* out); // 한 문장씩 파싱, EOF면 false
 
 #endif
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+//========================================
+// System Includes
+//========================================
+#include "lexer.h"
+#include "symtab.h"
+#include "bytecode.h"
+#include "vm.h"
+#include <stdbool.h>
+
+//========================================
+// Pipelined Execution (--pipeline)
+// 렉서 스레드 → 파서 스레드 → 실행기(호출 스레드)를 SPSC 링으로 연결한다.
+// 렉서 스레드는 입력을 SourceStream으로 읽어 가며 토큰화하므로, 소스를 미리 적재하지 않고
+// 첫 문장은 입력을 다 읽기 전에 실행된다.
+// 토큰과 문장은 배치 단위로 넘기고, 다 쓴 배치는 반대 방향 링으로 돌려받아 재사용한다.
+// 렉서/파서 진단은 해당 토큰/문장에 붙어 함께 흘러가므로 출력 순서는 순차 실행과 같다.
+//========================================
+#ifndef PIPE_TOKEN_BATCH
+#define PIPE_TOKEN_BATCH 1024   // 토큰 배치 크기
+#endif
+#ifndef PIPE_STMT_BATCH
+#define PIPE_STMT_BATCH 64      // 문장 배치 크기
+#endif
+#ifndef PIPE_BATCHES
+#define PIPE_BATCHES 8          // 단계마다 동시에 존재하는 배치 수 (메모리 상한)
+#endif
+
+//========================================
+// Function Prototypes
+//========================================
+
+// fd에서 읽는 프로그램을 파이프라인으로 파싱하며 실행 (name은 진단에 표시할 이름).
+// 메모리 부족(또는 스레드 생성 실패) 시 false, 읽기 실패는 *read_failed로 알림
+bool pipe_run(const char* name, int fd, SymTab* st, Chunk* ch, VM* vm, bool* read_failed);
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+//========================================
+// System Includes
+//========================================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+//========================================
+// Built-in Profiler (--profile)
+// DAHDIT_PROFILE로 빌드했을 때만 존재한다. 꺼져 있으면 아래 매크로는 모두 아무것도 하지 않으며
+// 인자도 평가되지 않는다.
+//========================================
+typedef enum {
+    PROF_LEX,       // lx_next / lx_tokenize
+    PROF_PARSE,     // ps_next_stmt (lex 시간 제외)
+    PROF_OPTIMIZE,  // opt_program (-O)
+    PROF_COMPILE,   // bc_compile_stmt / bc_finish
+    PROF_EXEC,      // vm_run
+    PROF_PHASE_COUNT
+} ProfPhase;
+
+#ifdef DAHDIT_PROFILE
+
+#define PROF_MAX_DEPTH 8
+
+typedef struct {
+    bool enabled;
+    double start;                       // prof_start 시각
+    double mark;                        // 마지막으로 시간을 배분한 시각
+    int depth;
+    ProfPhase stack[PROF_MAX_DEPTH];    // 진행 중인 단계 (안쪽 단계 시간은 바깥에서 제외)
+    double phase_sec[PROF_PHASE_COUNT];
+    uint64_t phase_calls[PROF_PHASE_COUNT];
+
+    uint64_t tokens, stmts, diagnostics;
+    uint64_t lookups, probes, max_probe;
+
+    size_t peak_lexer, peak_parser, peak_symtab;
+} Profile;
+
+// 스레드마다 따로 집계 (병렬 파싱 워커는 끝날 때 prof_merge로 합침)
+extern _Thread_local Profile g_profile;
+
+void prof_start(void);
+void prof_merge(const Profile* worker);     // 워커의 카운터/메모리를 현재 스레드 집계에 더함 (시간 제외)
+void prof_enter(ProfPhase phase);
+void prof_leave(void);
+void prof_memory(size_t lexer, size_t parser, size_t symtab);
+void prof_report(FILE* fp);
+
+#define PROF_ENTER(phase)   do { if (g_profile.enabled) prof_enter(phase); } while (0)
+#define PROF_LEAVE()        do { if (g_profile.enabled) prof_leave(); } while (0)
+#define PROF_COUNT(field, n) (g_profile.field += (n))
+#define PROF_MAX(field, v)  do { if ((v) > g_profile.field) g_profile.field = (v); } while (0)
+#define PROF_MEMORY(lexer, parser, symtab) \
+    do { if (g_profile.enabled) prof_memory((lexer), (parser), (symtab)); } while (0)
+
+#else
+
+#define PROF_ENTER(phase)   ((void)0)
+#define PROF_LEAVE()        ((void)0)
+#define PROF_COUNT(field, n) ((void)0)
+#define PROF_MAX(field, v)  ((void)0)
+#define PROF_MEMORY(lexer, parser, symtab) ((void)0)
+
+#endif
+
+#endif
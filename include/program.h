@@ -0,0 +1,34 @@
+#ifndef PROGRAM_H
+#define PROGRAM_H
+//========================================
+// System Includes
+//========================================
+#include "parser.h"
+#include "arena.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+//========================================
+// Program (파싱된 전체 문장 목록)
+// 문장은 연속된 배열에, 식 항목과 문자열은 Program의 arena에 저장된다.
+// 재실행을 위해 통째로 보관하고 prog_free 한 번으로 해제한다.
+//========================================
+typedef struct {
+    Stmt* stmts;
+    size_t count, cap;
+    Arena arena;        // 파서가 이 arena에 할당하도록 ps_init에 전달
+} Program;
+
+//========================================
+// Function Prototypes
+//========================================
+void prog_init(Program* prog);
+void prog_free(Program* prog);
+
+// 파서가 EOF(또는 치명적 구문 오류)에 도달할 때까지 모든 문장을 읽어 들임 (메모리 부족 시 false)
+bool prog_parse(Program* prog, Parser* ps);
+
+// src의 문장을 dst 끝에 옮기고 arena도 넘겨받음. src는 빈 상태가 됨 (메모리 부족 시 false)
+bool prog_take(Program* dst, Program* src);
+
+#endif
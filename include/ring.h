@@ -0,0 +1,59 @@
+#ifndef RING_H
+#define RING_H
+//========================================
+// System Includes
+//========================================
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+//========================================
+// SPSC Ring (단일 생산자/단일 소비자 lock-free 큐)
+// 포인터 하나씩 주고받는다. 생산자만 tail을, 소비자만 head를 쓴다.
+// 용량은 2의 거듭제곱이며 head/tail은 감싸지 않고 계속 증가시킨다 (차이가 곧 원소 수).
+// false 반환 시 기다리는 정책은 호출자가 정한다.
+//========================================
+typedef struct {
+    void** slots;
+    size_t mask;
+    _Alignas(64) atomic_size_t head;    // 소비자가 다음에 꺼낼 위치
+    _Alignas(64) atomic_size_t tail;    // 생산자가 다음에 넣을 위치
+} Ring;
+
+static inline bool ring_init(Ring* r, size_t capacity) {
+    size_t cap = 1;
+    while (cap < capacity) cap <<= 1;
+    r->slots = malloc(cap * sizeof(void*));
+    r->mask = cap - 1;
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    return r->slots != NULL;
+}
+
+static inline void ring_free(Ring* r) {
+    free(r->slots);
+    r->slots = NULL;
+}
+
+// 생산자 전용: 가득 차 있으면 false
+static inline bool ring_push(Ring* r, void* item) {
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+    if (tail - head > r->mask) return false;
+    r->slots[tail & r->mask] = item;
+    atomic_store_explicit(&r->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+// 소비자 전용: 비어 있으면 NULL
+static inline void* ring_pop(Ring* r) {
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    if (head == tail) return NULL;
+    void* item = r->slots[head & r->mask];
+    atomic_store_explicit(&r->head, head + 1, memory_order_release);
+    return item;
+}
+
+#endif
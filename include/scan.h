@@ -0,0 +1,35 @@
+#ifndef SCAN_H
+#define SCAN_H
+//========================================
+// System Includes
+//========================================
+#include <stddef.h>
+
+//========================================
+// Lexer Scanning Kernels (문자 분류 스캔)
+// 렉서의 안쪽 루프를 한 번에 16~32바이트씩 처리하는 구현들. 실행 시 CPU 기능을 보고
+// 가장 빠른 구현을 고르며, 어떤 구현이든 결과는 스칼라 구현과 같아야 한다.
+//========================================
+typedef struct {
+    const char* name;   // "avx2" / "sse2" / "scalar"
+
+    // p부터 이어지는 '.'/'-' 개수 (최대 max, p < end이고 *p는 '.' 또는 '-')
+    // *dashes에는 i번째 문자가 '-'이면 비트 i가 선 마스크를 저장
+    size_t (*morse_run)(const char* p, const char* end, size_t max, unsigned* dashes);
+
+    // 첫 '\n' 위치 (없으면 end)
+    const char* (*find_eol)(const char* p, const char* end);
+
+    // 첫 '"' 또는 '\n' 위치 (없으면 end)
+    const char* (*find_quote_or_eol)(const char* p, const char* end);
+} ScanOps;
+
+//========================================
+// Function Prototypes
+//========================================
+
+// CPU 기능에 맞는 구현 (최초 호출 시 한 번 결정).
+// 환경 변수 DAHDIT_SIMD=scalar|sse2|avx2로 낮은 단계를 강제할 수 있다 (비교/디버깅용)
+const ScanOps* scan_ops(void);
+
+#endif
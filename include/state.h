@@ -0,0 +1,65 @@
+#ifndef STATE_H
+#define STATE_H
+//========================================
+// System Includes
+//========================================
+#include "symtab.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//========================================
+// Interpreter State Image (--save-state / --load-state)
+// 심볼 테이블 전체(값, 정의 여부, 이름 풀, 해시 인덱스)를 포인터 없이 오프셋만으로 된 바이너리 이미지로 저장한다.
+// 불러올 때는 파일을 MAP_PRIVATE로 매핑하여 SymTab이 그 배열을 그대로 가리키게 하므로
+// 변수 수와 무관하게 바로 시작할 수 있고, 값을 바꾼 페이지만 커널이 복사한다 (copy-on-write).
+// 새 이름이 등록되면 그때 SymTab이 배열을 힙으로 옮긴다 (SymTab.borrowed).
+//
+// 레이아웃: DitsHeader | int32 values[n] | uint8 defined[n] | uint32 name_off[n] | uint32 hashes[n]
+//          | int32 index[index_cap] | names (각 구간은 8바이트 정렬, 같은 머신 전용, 네이티브 엔디언)
+//========================================
+#define DITS_MAGIC "DITS"
+#define DITS_FORMAT 1
+
+typedef struct {
+    char magic[4];          // DITS_MAGIC
+    uint32_t format;        // DITS_FORMAT
+    char version[16];       // DAHDIT_VERSION
+    uint64_t nsyms;
+    uint64_t names_len;
+    uint64_t index_cap;     // 2의 거듭제곱 (nsyms가 0이면 0)
+    uint64_t checksum;      // 파일 전체의 해시 (이 필드는 0으로 계산)
+} DitsHeader;
+
+_Static_assert(sizeof(DitsHeader) % 8 == 0, "DitsHeader must keep sections 8-byte aligned");
+
+typedef enum {
+    STATE_OK,
+    STATE_CANNOT_OPEN,
+    STATE_NOT_IMAGE,        // 형식이 다름 (magic)
+    STATE_STALE,            // 다른 형식 버전 / 인터프리터 버전에서 만든 이미지
+    STATE_CORRUPT,          // 체크섬 불일치, 잘렸거나 구조가 맞지 않음
+    STATE_NOMEM,
+} StateStatus;
+
+//========================================
+// Loaded Image (매핑된 상태 파일)
+// 불러온 SymTab이 매핑을 가리키므로 st_free한 뒤에 state_close한다.
+//========================================
+typedef struct {
+    void* map;
+    size_t size;
+} StateImage;
+
+//========================================
+// Function Prototypes
+//========================================
+// st(비어 있어야 함)가 이미지의 변수를 그대로 쓰도록 연결
+StateStatus state_load(StateImage* img, const char* path, SymTab* st);
+void state_close(StateImage* img);
+const char* state_error(StateStatus status);
+
+// st를 이미지로 저장 (임시 파일에 쓴 뒤 rename). 쓰기 실패나 메모리 부족이면 false
+bool state_save(const char* path, const SymTab* st);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef STREAM_H
+#define STREAM_H
+//========================================
+// System Includes
+//========================================
+#include <stdbool.h>
+#include <stddef.h>
+
+//========================================
+// Source Stream (입력을 문장 단위로 끊어 읽기)
+// 입력을 read()로 조금씩 받아, 문자열/주석 밖의 ';' 직후(문장 경계)까지의 완결된 문장
+// 묶음만 돌려준다. 돌려준 부분은 다음 호출 때 버리므로, 버퍼는 가장 긴 문장 하나와
+// 한 번에 읽는 양 정도로만 유지된다 (입력 전체 길이와 무관).
+//========================================
+typedef struct {
+    int fd;
+    char* buf;              // 아직 실행하지 않은 입력 (buf[0]은 항상 문장 시작)
+    size_t len, cap;
+    size_t taken;           // 직전 ss_next가 돌려준 길이 (다음 호출 때 버림)
+    size_t scanned;         // 문장 경계 검사를 마친 위치
+    bool in_string;         // scanned 위치가 문자열 리터럴 안인지
+    bool in_comment;        // scanned 위치가 주석 안인지
+    bool eof;
+    bool failed;            // read() 실패
+    bool nomem;             // 버퍼 확장 실패
+} SourceStream;
+
+// 한 번에 read()로 요청하는 크기
+#ifndef SS_READ_SIZE
+#define SS_READ_SIZE (64 * 1024)
+#endif
+
+//========================================
+// Function Prototypes
+//========================================
+void ss_init(SourceStream* ss, int fd);
+void ss_free(SourceStream* ss);
+
+// 다음 완결된 문장 묶음 [*data, *data + *size). 입력이 끝나면 남은 (미완결) 부분까지 돌려준다.
+// 완결된 문장이 생길 때까지 입력을 기다리며, 더 돌려줄 것이 없으면 false.
+// 반환한 포인터는 다음 ss_next 호출 전까지만 유효하다.
+bool ss_next(SourceStream* ss, const char** data, size_t* size);
+
+#endif
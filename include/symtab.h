@@ -1,23 +1,47 @@
 #ifndef SYMTAB_H
 #define SYMTAB_H
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
-#define MAX_SYMS 256
-#define MAX_NAME 64
-
+//========================================
+// Symbol Table (interned 이름 + open addressing 해시)
+//
+// 이름은 처음 등장할 때 이름 풀에 한 번만 복사(intern)되고 고정된 슬롯 번호를 받는다.
+// 슬롯 번호는 배열이 커져도 변하지 않으므로 파서/컴파일러가 미리 해석해 둘 수 있다.
+// 해시 인덱스는 (슬롯 + 1)을 담으며 0은 빈 칸. 적재율 1/2을 넘으면 두 배로 키운다.
+//========================================
 typedef struct {
-    char name[MAX_NAME];
-    int32_t value;
-    bool used;
-} Symbol;
+    // 슬롯별 데이터 (슬롯 번호 = 배열 인덱스)
+    int32_t* values;
+    uint8_t* defined;       // 값이 한 번이라도 대입됨
+    uint32_t* name_off;     // 이름 풀 내 오프셋 (null-terminated)
+    uint32_t* hashes;       // 재해시용 이름 해시
+    int count, cap;
+    uint32_t generation;    // st_clear마다 증가 (이전에 해석한 슬롯 번호가 아직 유효한지 판단용)
+    bool borrowed;          // 배열이 외부 메모리(매핑한 상태 이미지)를 가리킴: 늘리기 전에 힙으로 복사하며 st_free가 해제하지 않음
 
-typedef struct {
-    Symbol syms[MAX_SYMS];
+    // 이름 풀
+    char* names;
+    size_t names_len, names_cap;
+
+    // 해시 인덱스
+    int32_t* index;
+    uint32_t index_cap;     // 2의 거듭제곱
 } SymTab;
 
 void st_init(SymTab* st);
+void st_free(SymTab* st);
+void st_clear(SymTab* st);  // 이름/값만 지우고 메모리는 유지 (재사용)
+
+// 슬롯 API: 이름을 고정 슬롯 번호로 변환 (파서/바이트코드 피연산자)
+int st_intern(SymTab* st, const char* name, size_t len); // 없으면 미정의 상태로 등록, 메모리 부족 시 -1
+int st_lookup(const SymTab* st, const char* name, size_t len); // 없으면 -1
+const char* st_name(const SymTab* st, int slot);
+size_t st_memory(const SymTab* st); // 슬롯 배열 + 인덱스 + 이름 풀 바이트 수
+
+// 이름 기반 접근 (편의용)
 bool st_set(SymTab* st, const char* name, int32_t value);
 bool st_get(SymTab* st, const char* name, int32_t* out);
 
-#endif
\ No newline at end of file
+#endif
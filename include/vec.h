@@ -0,0 +1,52 @@
+#ifndef VEC_H
+#define VEC_H
+//========================================
+// System Includes
+//========================================
+#include "parser.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//========================================
+// Array Storage (배열 저장소)
+// 배열과 배열 값 임시 버퍼는 VEC_ALIGN 바이트 경계에 놓인 연속 메모리다 (캐시 줄 / AVX 레지스터 단위).
+//========================================
+#ifndef VEC_ALIGN
+#define VEC_ALIGN 64
+#endif
+
+//========================================
+// Element-wise Kernels (배열 원소별 연산)
+// kernel[shape][op]: op는 ExprOp, shape는 배열 값인 피연산자 (VEC_LEFT / VEC_RIGHT / VEC_BOTH).
+// 배열이 아닌 쪽은 값 하나를 가리키며 모든 원소에 쓰인다. dst는 a 또는 b와 같은 버퍼여도 된다.
+// 결과는 arith.h 규칙과 같고, 나눗셈/나머지의 0 검사는 호출자가 has_zero로 먼저 해야 한다.
+// 구현은 실행 시 CPU 기능을 보고 고르며, 어떤 구현이든 결과는 스칼라 구현과 같아야 한다.
+//========================================
+enum {
+    VEC_LEFT = 1,   // dst[i] = a[i] op b[0]
+    VEC_RIGHT = 2,  // dst[i] = a[0] op b[i]
+    VEC_BOTH = 3,   // dst[i] = a[i] op b[i]
+};
+
+#define VEC_NOPS (EXPR_OP_MOD + 1)
+
+typedef void (*VecKernel)(int32_t* dst, const int32_t* a, const int32_t* b, size_t n);
+
+typedef struct {
+    const char* name;                   // "avx2" / "sse2" / "scalar"
+    VecKernel kernel[4][VEC_NOPS];      // [0]은 쓰지 않음
+    bool (*has_zero)(const int32_t* p, size_t n);
+} VecOps;
+
+//========================================
+// Function Prototypes
+//========================================
+
+// CPU 기능에 맞는 구현 (최초 호출 시 한 번 결정). DAHDIT_SIMD=scalar|sse2|avx2로 낮은 단계를 강제할 수 있다
+const VecOps* vec_ops(void);
+
+int32_t* vec_alloc(size_t n);   // 원소 n개를 담을 정렬된 버퍼 (내용은 정하지 않음, 실패 시 NULL)
+void vec_free(int32_t* p);
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef VERSION_H
+#define VERSION_H
+//========================================
+// Interpreter Version (인터프리터 버전)
+// 바이트코드나 컴파일 규칙이 바뀌면 올린다. 컴파일 캐시(.ditc)의 키에 포함되어
+// 다른 버전이 만든 캐시는 자동으로 무효가 된다.
+//========================================
+#define DAHDIT_VERSION "0.15.0"
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef VM_H
+#define VM_H
+//========================================
+// System Includes
+//========================================
+#include "bytecode.h"
+#include "symtab.h"
+#include "output.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+//========================================
+// Call Depth Limit (하위 루틴 호출 깊이 제한)
+// 꼬리 호출(RETURN f(...))은 프레임을 재사용하므로 깊이에 들어가지 않는다. --emit-c 코드도 같은 제한을 쓴다.
+//========================================
+#ifndef VM_MAX_CALL_DEPTH
+#define VM_MAX_CALL_DEPTH 10000
+#endif
+
+//========================================
+// Call Frame (호출한 쪽으로 돌아갈 때 되살릴 상태)
+// 프레임의 지역 변수와 피연산자는 VM 스택에 이어져 있고, 여기에는 위치만 남긴다.
+//========================================
+typedef struct {
+    size_t pc;                  // 돌아갈 명령어
+    const StmtInfo* cur;        // 호출한 문장 (오류 보고 / 재개 지점)
+    int fp, bp;                 // 호출한 쪽 프레임의 지역 변수 시작과 문장 base 기준
+} VmFrame;
+
+//========================================
+// Arrays (배열 변수와 배열 값)
+// 배열은 이름 슬롯으로 찾는 전역 저장소이고, 선언 문장이 아직 실행되지 않은 배열은 길이 0이다.
+// 배열 값은 그것이 놓인 스택 칸 번호로 찾는다: 배열 하나를 그대로 가리키거나(복사 없음),
+// 원소별 연산 결과를 그 칸이 가진 버퍼에 담는다 (버퍼는 칸마다 재사용). 저장소는 모두 VEC_ALIGN 정렬이다.
+//========================================
+typedef struct {
+    int32_t* data;
+    size_t len, cap;
+} VmArray;
+
+typedef struct {
+    const int32_t* data;    // 배열의 원소 또는 buf
+    size_t len;
+    int32_t* buf;           // 이 칸의 연산 결과 버퍼
+    size_t cap;
+} VmVec;
+
+//========================================
+// VM State (바이트코드 실행기)
+//========================================
+typedef struct {
+    SymTab* st;
+    const char* filename;   // 오류 보고용
+    Output* out;            // PRINT 출력 대상
+    int32_t* stack;
+    int stack_cap;
+    VmFrame* frames;
+    int frames_cap;
+    VmArray* arrays;        // 슬롯 → 배열 (ARRAY를 처음 실행할 때 늘림)
+    size_t arrays_cap;
+    VmVec* vecs;            // 스택 칸 → 배열 값
+    size_t vecs_cap;
+} VM;
+
+// 런타임 오류 종류 (오류가 나면 현재 문장의 나머지를 건너뜀)
+typedef enum {
+    VM_ERR_UNDEFINED,       // 정의되지 않은 변수 읽기
+    VM_ERR_DIV_ZERO,
+    VM_ERR_MOD_ZERO,
+    VM_ERR_CALL_DEPTH,      // 호출 깊이가 VM_MAX_CALL_DEPTH를 넘음 (프레임을 모두 닫고 최상위 문장을 건너뜀)
+    VM_ERR_INDEX,           // 배열 첨자가 범위를 벗어남
+    VM_ERR_ARRAY_LENGTH,    // 음수 길이로 배열 선언
+    VM_ERR_LENGTH_MISMATCH, // 길이가 다른 배열 값끼리 연산
+} VmError;
+
+//========================================
+// Function Prototypes
+//========================================
+void vm_init(VM* vm, SymTab* st, const char* filename, Output* out);
+void vm_free(VM* vm);
+bool vm_reserve(VM* vm, int64_t depth); // 스택을 depth 칸 이상으로 (메모리 부족이거나 너무 크면 false)
+void vm_reset_arrays(VM* vm);           // 모든 배열을 길이 0으로 (메모리는 유지)
+// slot은 VM_ERR_UNDEFINED / INDEX / ARRAY_LENGTH의 이름. 오류 수 제한에 도달하여 실행을 멈춰야 하면 false
+bool vm_report(const VM* vm, const StmtInfo* at, VmError err, int32_t slot);
+
+// chunk 실행. 런타임 오류는 진단 후 해당 문장만 건너뛰고 계속, 오류 수 제한에 도달하면 멈춤 (메모리 부족 시 false)
+bool vm_run(VM* vm, const Chunk* ch);
+
+#endif
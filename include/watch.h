@@ -0,0 +1,26 @@
+#ifndef WATCH_H
+#define WATCH_H
+//========================================
+// System Includes
+//========================================
+#include <stdbool.h>
+
+//========================================
+// Watch Mode (--watch, 파일이 바뀔 때마다 증분 재실행)
+// 문장마다 소스 구간(첫 토큰부터 다음 문장의 첫 토큰 전까지)의 해시, 그 문장까지의 출력/진단 길이,
+// VAR가 덮어쓴 변수의 이전 값을 기록해 둔다. 파일이 바뀌면 처음으로 달라진 문장을 찾아
+// 그 뒤의 기록을 거꾸로 되돌려 그 직전의 변수 상태를 복원하고, 그 문장의 위치부터만 다시 렉싱·파싱·실행한다.
+// 바뀌지 않은 앞부분의 출력과 진단은 기록해 둔 것을 그대로 다시 내보낸다.
+// 블록(WHILE/IF/REPEAT ... END)은 END까지 모아 한 번에 실행하므로 블록 전체를 한 문장으로 기록한다.
+//========================================
+#ifndef WATCH_POLL_MS
+#define WATCH_POLL_MS 100   // 파일 변경 확인 주기
+#endif
+
+//========================================
+// Function Prototypes
+//========================================
+// filename을 실행한 뒤 바뀔 때마다 다시 실행한다 (종료하지 않음). 처음에 파일을 열 수 없으면 false
+bool watch_run(const char* filename);
+
+#endif
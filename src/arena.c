@@ -0,0 +1,90 @@
+//========================================
+// System Includes
+//========================================
+#include "arena.h"
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_DEFAULT_BLOCK (64 * 1024)
+#define ARENA_ALIGN alignof(max_align_t)
+
+// 블록 헤더 뒤 data 영역의 시작 (정렬 보장)
+#define BLOCK_HEADER ((sizeof(ArenaBlock) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+#define BLOCK_DATA(b) ((char*)(b) + BLOCK_HEADER)
+
+void arena_init(Arena* a, size_t block_size) {
+    a->head = NULL;
+    a->block_size = block_size ? block_size : ARENA_DEFAULT_BLOCK;
+    a->reserved = 0;
+}
+
+void arena_free(Arena* a) {
+    ArenaBlock* b = a->head;
+    while (b) {
+        ArenaBlock* next = b->next;
+        free(b);
+        b = next;
+    }
+    a->head = NULL;
+    a->reserved = 0;
+}
+
+/**
+ * @brief 가장 최근 블록 하나만 남기고 나머지를 해제, 남긴 블록은 처음부터 재사용
+ */
+void arena_reset(Arena* a) {
+    if (!a->head) return;
+    ArenaBlock* b = a->head->next;
+    while (b) {
+        ArenaBlock* next = b->next;
+        a->reserved -= BLOCK_HEADER + b->size;
+        free(b);
+        b = next;
+    }
+    a->head->next = NULL;
+    a->head->used = 0;
+}
+
+void* arena_alloc(Arena* a, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+    ArenaBlock* b = a->head;
+    if (!b || b->size - b->used < size) {
+        size_t data = size > a->block_size ? size : a->block_size;
+        b = malloc(BLOCK_HEADER + data);
+        if (!b) return NULL;
+        b->next = a->head;
+        b->size = data;
+        b->used = 0;
+        a->head = b;
+        a->reserved += BLOCK_HEADER + data;
+    }
+    void* p = BLOCK_DATA(b) + b->used;
+    b->used += size;
+    return p;
+}
+
+/**
+ * @brief 다른 arena의 블록을 통째로 넘겨받음 (복사 없이 연결 리스트만 이어 붙임)
+ * dst의 현재 할당 블록은 그대로 head로 남는다.
+ */
+void arena_absorb(Arena* dst, Arena* src) {
+    if (!src->head) return;
+    if (!dst->head) {
+        dst->head = src->head;
+    } else {
+        ArenaBlock* tail = src->head;
+        while (tail->next) tail = tail->next;
+        tail->next = dst->head->next;
+        dst->head->next = src->head;
+    }
+    dst->reserved += src->reserved;
+    src->head = NULL;
+    src->reserved = 0;
+}
+
+void* arena_copy(Arena* a, const void* src, size_t size) {
+    void* p = arena_alloc(a, size ? size : 1);
+    if (p && size) memcpy(p, src, size);
+    return p;
+}
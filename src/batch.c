@@ -0,0 +1,312 @@
+//========================================
+// System Includes
+//========================================
+#include "batch.h"
+#include "diag.h"
+#include "output.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <time.h>
+#else
+#include <windows.h>
+#endif
+
+//========================================
+// Batch List
+//========================================
+void batch_list_init(BatchList* list) {
+    list->files = NULL;
+    list->count = list->cap = 0;
+}
+
+void batch_list_free(BatchList* list) {
+    for (int i = 0; i < list->count; ++i) free(list->files[i]);
+    free(list->files);
+    batch_list_init(list);
+}
+
+static bool add_n(BatchList* list, const char* path, size_t n) {
+    if (list->count == list->cap) {
+        int cap = list->cap ? list->cap * 2 : 16;
+        char** grown = realloc(list->files, (size_t)cap * sizeof(char*));
+        if (!grown) return false;
+        list->files = grown; list->cap = cap;
+    }
+    char* copy = malloc(n + 1);
+    if (!copy) return false;
+    memcpy(copy, path, n);
+    copy[n] = '\0';
+    list->files[list->count++] = copy;
+    return true;
+}
+
+bool batch_list_add(BatchList* list, const char* path) {
+    return add_n(list, path, strlen(path));
+}
+
+/**
+ * @brief 매니페스트 파일의 경로들을 추가 (앞뒤 공백 제거, 빈 줄과 '#'으로 시작하는 줄 무시)
+ * 경로는 현재 디렉터리 기준이다.
+ */
+bool batch_list_load(BatchList* list, const char* manifest) {
+    FILE* fp = fopen(manifest, "rb");
+    if (!fp) return false;
+
+    bool ok = true;
+    char buf[4096];
+    char* line = NULL;      // 버퍼보다 긴 줄을 이어 붙이는 곳
+    size_t len = 0;
+    while (ok && fgets(buf, sizeof(buf), fp)) {
+        size_t n = strlen(buf);
+        char* grown = realloc(line, len + n + 1);
+        if (!grown) { ok = false; break; }
+        line = grown;
+        memcpy(line + len, buf, n + 1);
+        len += n;
+        if (len > 0 && line[len - 1] != '\n' && !feof(fp)) continue;
+
+        const char* s = line;
+        const char* e = line + len;
+        while (s < e && (*s == ' ' || *s == '\t')) ++s;
+        while (e > s && (e[-1] == '\n' || e[-1] == '\r' || e[-1] == ' ' || e[-1] == '\t')) --e;
+        if (e > s && *s != '#') ok = add_n(list, s, (size_t)(e - s));
+        len = 0;
+    }
+    if (ferror(fp)) ok = false;
+    free(line);
+    fclose(fp);
+    return ok;
+}
+
+//========================================
+// Batch State
+//========================================
+typedef struct {
+    DiagBuffer out;         // 프로그램 출력 (PRINT)
+    DiagBuffer diags;       // 진단
+    double sec;
+    bool ok;
+    bool done;              // Batch.lock으로 보호
+} BatchResult;
+
+// 워커 w의 큐: 남은 작업 k ∈ [head, tail)은 파일 w + k * nqueues
+typedef struct {
+#ifndef _WIN32
+    pthread_mutex_t lock;
+#endif
+    int head, tail;
+} WorkQueue;
+
+typedef struct {
+    const BatchList* list;
+    const RunOptions* opts;
+    BatchResult* results;
+    WorkQueue* queues;
+    int nqueues;
+#ifndef _WIN32
+    pthread_mutex_t lock;   // results[].done
+    pthread_cond_t done_cv;
+#endif
+} Batch;
+
+typedef struct {
+    Batch* b;
+    int id;
+} Worker;
+
+static double now_sec(void) {
+#ifndef _WIN32
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#else
+    LARGE_INTEGER freq, t;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart / (double)freq.QuadPart;
+#endif
+}
+
+/**
+ * @brief 다음에 실행할 파일을 고름: 자기 큐의 앞(파일 순서)에서, 비었으면 다른 큐의 뒤에서 훔침
+ * @return 남은 작업이 없으면 false.
+ */
+static bool take(Batch* b, int self, int* file) {
+    for (int i = 0; i < b->nqueues; ++i) {
+        int w = (self + i) % b->nqueues;
+        WorkQueue* q = &b->queues[w];
+#ifndef _WIN32
+        pthread_mutex_lock(&q->lock);
+#endif
+        bool found = q->head < q->tail;
+        if (found) {
+            int k = i == 0 ? q->head++ : --q->tail;
+            *file = w + k * b->nqueues;
+        }
+#ifndef _WIN32
+        pthread_mutex_unlock(&q->lock);
+#endif
+        if (found) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Output 싱크: 프로그램 출력을 결과 버퍼에 이어 붙임
+ */
+static bool collect(void* user, const char* data, size_t len) {
+    DiagBuffer* buf = user;
+    if (buf->cap - buf->len < len) {
+        size_t cap = buf->cap ? buf->cap : 4096;
+        while (cap - buf->len < len) cap *= 2;
+        char* grown = realloc(buf->text, cap);
+        if (!grown) return false;
+        buf->text = grown; buf->cap = cap;
+    }
+    memcpy(buf->text + buf->len, data, len);
+    buf->len += len;
+    return true;
+}
+
+/**
+ * @brief 파일 하나를 워커의 Interp로 실행 (출력과 진단은 r에 모음)
+ */
+static void run_one(Interp* it, Output* out, const char* path, BatchResult* r) {
+    double start = now_sec();
+    DiagBuffer* prev = diag_capture(&r->diags);
+
+    out_init_sink(out, collect, &r->out, OUT_FLUSH_FULL);
+    r->ok = interp_run_file(it, path) && !diag_stopped();
+    if (!out_flush(out)) {
+        diag_message("Out of memory\n");
+        r->ok = false;
+    }
+    out_free(out);
+    interp_reset(it);
+
+    diag_capture(prev);
+    r->sec = now_sec() - start;
+}
+
+static void* worker_main(void* arg) {
+    Worker* w = arg;
+    Batch* b = w->b;
+    Output out;             // 파일마다 run_one에서 다시 초기화
+    Interp it; interp_init(&it, b->opts, &out);
+
+    int file;
+    while (take(b, w->id, &file)) {
+        BatchResult* r = &b->results[file];
+        run_one(&it, &out, b->list->files[file], r);
+#ifndef _WIN32
+        pthread_mutex_lock(&b->lock);
+        r->done = true;
+        pthread_cond_signal(&b->done_cv);
+        pthread_mutex_unlock(&b->lock);
+#else
+        r->done = true;
+#endif
+    }
+    interp_free(&it);
+    return NULL;
+}
+
+/**
+ * @brief 파일 i의 실행이 끝날 때까지 기다림
+ */
+static void wait_done(Batch* b, int i) {
+#ifndef _WIN32
+    pthread_mutex_lock(&b->lock);
+    while (!b->results[i].done) pthread_cond_wait(&b->done_cv, &b->lock);
+    pthread_mutex_unlock(&b->lock);
+#else
+    (void)b; (void)i;
+#endif
+}
+
+//========================================
+// Batch Run
+//========================================
+bool batch_run(const BatchList* list, int jobs, const RunOptions* opts) {
+    int n = list->count;
+    if (jobs > n) jobs = n;
+    if (jobs < 1) jobs = 1;
+
+    Batch b = { .list = list, .opts = opts, .nqueues = jobs };
+    b.results = calloc((size_t)(n > 0 ? n : 1), sizeof(BatchResult));
+    b.queues = calloc((size_t)jobs, sizeof(WorkQueue));
+    Worker* workers = calloc((size_t)jobs, sizeof(Worker));
+    if (!b.results || !b.queues || !workers) {
+        free(b.results); free(b.queues); free(workers);
+        fprintf(stderr, "Out of memory\n");
+        return false;
+    }
+    for (int w = 0; w < jobs; ++w) {
+        // 파일을 번갈아 나누어 워커들이 대체로 파일 순서대로 진행하게 함 (출력 대기 최소화)
+        b.queues[w].tail = (n - w + jobs - 1) / jobs;
+        workers[w].b = &b;
+        workers[w].id = w;
+    }
+
+    double start = now_sec();
+    int started = 0;
+#ifndef _WIN32
+    pthread_mutex_init(&b.lock, NULL);
+    pthread_cond_init(&b.done_cv, NULL);
+    for (int w = 0; w < jobs; ++w) pthread_mutex_init(&b.queues[w].lock, NULL);
+
+    pthread_t* threads = malloc((size_t)jobs * sizeof(pthread_t));
+    while (threads && started < jobs &&
+           pthread_create(&threads[started], NULL, worker_main, &workers[started]) == 0) {
+        ++started;
+    }
+#endif
+    // 스레드를 만들 수 없으면 현재 스레드에서 모두 실행 (남은 큐는 훔쳐서 처리됨)
+    if (started == 0) worker_main(&workers[0]);
+
+    // 파일 순서대로 결과를 내보냄
+    Output out; out_init(&out, 1, opts->flush);
+    int failed = 0, slowest = -1;
+    double total = 0;
+    for (int i = 0; i < n; ++i) {
+        wait_done(&b, i);
+        BatchResult* r = &b.results[i];
+        out_write(&out, r->out.text, r->out.len);
+        if (r->diags.len > 0) {
+            if (out.policy != OUT_FLUSH_EXPLICIT) out_flush(&out);
+            diag_begin_run();   // 오류 수 제한은 파일마다
+            diag_forward(&r->diags, 0, r->diags.len);
+        }
+        diag_flush(&r->out, NULL);
+        diag_flush(&r->diags, NULL);
+
+        if (!r->ok) ++failed;
+        total += r->sec;
+        if (slowest < 0 || r->sec > b.results[slowest].sec) slowest = i;
+    }
+    out_free(&out);
+    double wall = now_sec() - start;
+
+#ifndef _WIN32
+    for (int w = 0; w < started; ++w) pthread_join(threads[w], NULL);
+    free(threads);
+    for (int w = 0; w < jobs; ++w) pthread_mutex_destroy(&b.queues[w].lock);
+    pthread_cond_destroy(&b.done_cv);
+    pthread_mutex_destroy(&b.lock);
+#endif
+
+    diag_sync();
+    fprintf(stderr, "batch: %d files (%d failed), %d jobs, %.3f s wall, %.3f s in programs (%.2fx)",
+            n, failed, started > 0 ? started : 1, wall, total, wall > 0 ? total / wall : 0.0);
+    if (slowest >= 0) fprintf(stderr, ", slowest %.3f s: %s", b.results[slowest].sec, list->files[slowest]);
+    fputc('\n', stderr);
+
+    free(workers);
+    free(b.queues);
+    free(b.results);
+    return failed == 0;
+}
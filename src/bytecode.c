@@ -0,0 +1,770 @@
+//========================================
+// System Includes
+//========================================
+#include "bytecode.h"
+#include "diag.h"
+#include "vec.h"
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+//========================================
+// Chunk Memory Management
+//========================================
+
+void bc_init(Chunk* ch) {
+    memset(ch, 0, sizeof(*ch));
+}
+
+/**
+ * @brief 배열 용량을 최소 need 개까지 두 배씩 늘림
+ */
+static bool grow(void** arr, size_t* cap, size_t need, size_t elem) {
+    if (need <= *cap) return true;
+    size_t n = *cap ? *cap : 64;
+    while (n < need) n *= 2;
+    void* p = realloc(*arr, n * elem);
+    if (!p) return false;
+    *arr = p; *cap = n;
+    return true;
+}
+
+/**
+ * @brief 슬롯으로 찾는 표를 need 칸 이상으로 늘리고 새 칸은 0(없음)으로 채움
+ */
+static bool grow_map(uint32_t** map, size_t* cap, size_t need) {
+    size_t old = *cap;
+    if (!grow((void**)map, cap, need, sizeof(uint32_t))) return false;
+    memset(*map + old, 0, (*cap - old) * sizeof(uint32_t));
+    return true;
+}
+
+/**
+ * @brief 열린 하위 루틴의 지역 변수 이름을 지움
+ */
+static void clear_scope(Chunk* ch) {
+    for (size_t i = 0; i < ch->nscope; ++i) ch->local_of[ch->scope[i]] = 0;
+    ch->nscope = 0;
+}
+
+/**
+ * @brief n번째 이후의 하위 루틴 등록을 지우고, 같은 이름의 앞선 정의가 있으면 그것을 되살림
+ */
+static void unregister_subs(Chunk* ch, size_t n) {
+    for (size_t i = n; i < ch->nsubs; ++i) ch->sub_of[ch->subs[i].slot] = 0;
+    ch->nsubs = n;
+    for (size_t i = 0; i < n; ++i) ch->sub_of[ch->subs[i].slot] = (uint32_t)i + 1;
+}
+
+void bc_reset(Chunk* ch) {
+    unregister_subs(ch, 0);
+    clear_scope(ch);
+    if (ch->array_of_cap) memset(ch->array_of, 0, ch->array_of_cap * sizeof(uint32_t));
+    ch->narrays = 0;
+    ch->count = 0;
+    ch->nstmts = 0;
+    ch->nstrs = 0;
+    ch->pool_len = 0;
+    ch->max_stack = 0;
+    ch->nblocks = 0;
+    ch->entry = 0;
+    ch->keep_code = ch->keep_stmts = ch->keep_strs = ch->keep_pool = 0;
+}
+
+/**
+ * @brief 닫힌 하위 루틴(keep_*)까지 남기고 그 뒤를 비움. 실행은 남긴 부분 다음에서 시작한다
+ */
+void bc_reset_stmts(Chunk* ch) {
+    clear_scope(ch);
+    ch->count = ch->keep_code;
+    ch->nstmts = ch->keep_stmts;
+    ch->nstrs = ch->keep_strs;
+    ch->pool_len = ch->keep_pool;
+    ch->max_stack = 0;
+    ch->nblocks = 0;
+    ch->entry = ch->keep_code;
+}
+
+void bc_drop_subs(Chunk* ch, size_t nsubs) {
+    if (nsubs >= ch->nsubs) return;
+    const Sub* first = &ch->subs[nsubs];
+    ch->keep_code = first->start;
+    ch->keep_stmts = first->stmt;
+    ch->keep_strs = first->nstrs;
+    ch->keep_pool = first->pool_len;
+    unregister_subs(ch, nsubs);
+    bc_reset_stmts(ch);
+}
+
+void bc_free(Chunk* ch) {
+    free(ch->code);
+    free(ch->stmts);
+    free(ch->strs);
+    free(ch->pool);
+    free(ch->blocks);
+    free(ch->subs);
+    free(ch->sub_of);
+    free(ch->local_of);
+    free(ch->scope);
+    free(ch->array_of);
+    free(ch->shapes);
+    bc_init(ch);
+}
+
+static bool emit(Chunk* ch, OpCode op, int32_t arg) {
+    if (!grow((void**)&ch->code, &ch->cap, ch->count + 1, sizeof(Instr))) return false;
+    ch->code[ch->count].op = (uint8_t)op;
+    ch->code[ch->count].arg = arg;
+    ch->count++;
+    return true;
+}
+
+/**
+ * @brief 문자열을 풀에 복사하고 문자열 인덱스를 반환 (실패 시 -1)
+ */
+static int32_t add_string(Chunk* ch, const char* text, size_t len) {
+    if (!grow((void**)&ch->pool, &ch->pool_cap, ch->pool_len + len + 1, 1)) return -1;
+    if (!grow((void**)&ch->strs, &ch->strs_cap, ch->nstrs + 1, sizeof(StrRef))) return -1;
+    memcpy(ch->pool + ch->pool_len, text, len);
+    ch->pool[ch->pool_len + len] = '\0';
+    ch->strs[ch->nstrs].off = (uint32_t)ch->pool_len;
+    ch->strs[ch->nstrs].len = (uint32_t)len;
+    ch->pool_len += len + 1;
+    return (int32_t)ch->nstrs++;
+}
+
+
+//========================================
+// Compiler (Stmt/Expr → Bytecode)
+//========================================
+
+/**
+ * @brief 지금 본문을 컴파일하고 있는 하위 루틴 (SUB는 최상위에서만 열리므로 가장 바깥 블록)
+ */
+static Sub* open_sub(Chunk* ch) {
+    return ch->nblocks && ch->blocks[0].kind == STMT_SUB ? &ch->subs[ch->nsubs - 1] : NULL;
+}
+
+/**
+ * @brief 스택 깊이 depth가 필요함을 기록 (하위 루틴 본문이면 그 루틴의 최대 깊이)
+ */
+static void note_depth(Chunk* ch, int depth) {
+    Sub* sub = open_sub(ch);
+    if (sub) {
+        if ((uint32_t)depth > sub->max_stack) sub->max_stack = (uint32_t)depth;
+    } else if (depth > ch->max_stack) {
+        ch->max_stack = depth;
+    }
+}
+
+static uint32_t sub_index(const Chunk* ch, int32_t slot) {
+    return (size_t)slot < ch->sub_of_cap ? ch->sub_of[slot] : 0;
+}
+
+static uint32_t local_index(const Chunk* ch, int32_t slot) {
+    return (size_t)slot < ch->local_of_cap ? ch->local_of[slot] : 0;
+}
+
+static bool is_array(const Chunk* ch, int32_t slot) {
+    return (size_t)slot < ch->array_of_cap && ch->array_of[slot];
+}
+
+/**
+ * @brief 열린 하위 루틴에 지역 변수를 추가
+ * @return 지역 변수 번호 + 1, 메모리 부족이면 0.
+ */
+static uint32_t declare_local(Chunk* ch, Sub* sub, int32_t slot) {
+    if (!grow_map(&ch->local_of, &ch->local_of_cap, (size_t)slot + 1) ||
+        !grow((void**)&ch->scope, &ch->scope_cap, ch->nscope + 1, sizeof(int32_t))) return 0;
+    ch->scope[ch->nscope++] = slot;
+    ch->local_of[slot] = ++sub->nlocals;
+    return sub->nlocals;
+}
+
+/**
+ * @brief 호출 항목을 OP_CALL로 변환. 하위 루틴은 호출보다 앞에 정의되어 있어야 한다
+ * 배열 이름이면 첨자 하나로 원소를 읽는 OP_LOAD_ELEM이 된다.
+ */
+static bool compile_call(Chunk* ch, const ExprItem* item, const SymTab* st, const char* filename,
+                         int64_t line, int64_t col) {
+    uint32_t k = sub_index(ch, item->as.call.slot);
+    char msg[128];
+    if (!k && is_array(ch, item->as.call.slot)) {
+        if (item->as.call.argc != 1) {
+            snprintf(msg, sizeof(msg), "array '%s' takes 1 index, got %d",
+                     st_name(st, item->as.call.slot), (int)item->as.call.argc);
+            diag_error(DIAG_COMPILE, filename, line, col, msg);
+            return false;
+        }
+        return emit(ch, OP_LOAD_ELEM, item->as.call.slot);
+    }
+    if (!k) {
+        snprintf(msg, sizeof(msg), "unknown subroutine '%s'", st_name(st, item->as.call.slot));
+        diag_error(DIAG_COMPILE, filename, line, col, msg);
+        return false;
+    }
+    uint32_t nparams = ch->subs[k - 1].nparams;
+    if ((uint32_t)item->as.call.argc != nparams) {
+        snprintf(msg, sizeof(msg), "subroutine '%s' takes %u argument%s, got %d",
+                 st_name(st, item->as.call.slot), nparams, nparams == 1 ? "" : "s", (int)item->as.call.argc);
+        diag_error(DIAG_COMPILE, filename, line, col, msg);
+        return false;
+    }
+    return emit(ch, OP_CALL, (int32_t)(k - 1));
+}
+
+/**
+ * @brief RPN 표현식을 스택 명령어로 변환. 변수는 슬롯(하위 루틴 본문에서는 지역 변수 우선)으로 해석하고 스택 깊이를 검증
+ * 배열 이름은 배열 값이 되고, 배열 값이 피연산자인 연산은 원소별 연산(OP_VEC)이 된다.
+ * 배열 값은 연산의 피연산자로만 쓸 수 있다 (호출 인자, 첨자는 수여야 함). 하위 루틴 본문에서는 원소만 읽는다.
+ * @param base 식을 시작할 때의 스택 깊이 (바깥 REPEAT 카운터 수)
+ * @param array 결과가 배열 값이면 true로 (NULL이면 결과도 수여야 함)
+ */
+static bool compile_value(Chunk* ch, const Expr* expr, const SymTab* st, const char* filename, int64_t line, int64_t col,
+                          int base, bool* array) {
+    if (!grow((void**)&ch->shapes, &ch->shapes_cap, (size_t)expr->count + 1, 1)) return false;
+    uint8_t* vec = ch->shapes;  // 스택 칸별 배열 값 여부
+    int depth = 0;
+    char msg[128];
+
+    for (int i = 0; i < expr->count; ++i) {
+        const ExprItem* item = &expr->items[i];
+        switch (item->kind) {
+            case EXPR_ITEM_NUMBER:
+                if (!emit(ch, OP_PUSH_CONST, item->as.number)) return false;
+                vec[depth++] = 0;
+                break;
+            case EXPR_ITEM_VAR: {
+                uint32_t local = local_index(ch, item->as.slot);
+                bool whole = !local && is_array(ch, item->as.slot);
+                if (whole && open_sub(ch)) {
+                    snprintf(msg, sizeof(msg), "array '%s' needs an index inside SUB", st_name(st, item->as.slot));
+                    diag_error(DIAG_COMPILE, filename, line, col, msg);
+                    return false;
+                }
+                if (!(local ? emit(ch, OP_LOAD_LOCAL, (int32_t)(local - 1)) :
+                      emit(ch, whole ? OP_LOAD_ARRAY : OP_LOAD_SLOT, item->as.slot))) return false;
+                vec[depth++] = whole;
+                break;
+            }
+            case EXPR_ITEM_OP: {
+                if (depth < 2) {
+                    diag_error(DIAG_COMPILE, filename, line, col, "not enough operands for operator");
+                    return false;
+                }
+                OpCode op;
+                switch (item->as.op) {
+                    case EXPR_OP_ADD: op = OP_ADD; break;
+                    case EXPR_OP_SUB: op = OP_SUB; break;
+                    case EXPR_OP_MUL: op = OP_MUL; break;
+                    case EXPR_OP_DIV: op = OP_DIV; break;
+                    case EXPR_OP_MOD: op = OP_MOD; break;
+                    default:
+                        diag_error(DIAG_INTERNAL, filename, line, col, "Unknown operator in expression");
+                        return false;
+                }
+                int shape = vec[depth - 2] | vec[depth - 1] << 1;
+                if (!(shape ? emit(ch, OP_VEC, (int32_t)item->as.op * 4 + shape) : emit(ch, op, 0))) return false;
+                depth--;
+                vec[depth - 1] = shape != 0;
+                break;
+            }
+            case EXPR_ITEM_CALL:
+                if (item->as.call.argc < 0 || depth < item->as.call.argc) {
+                    diag_error(DIAG_COMPILE, filename, line, col, "not enough operands for call");
+                    return false;
+                }
+                for (int k = depth - item->as.call.argc; k < depth; ++k) {
+                    if (vec[k]) {
+                        diag_error(DIAG_COMPILE, filename, line, col, "array value used where a number is expected");
+                        return false;
+                    }
+                }
+                if (!compile_call(ch, item, st, filename, line, col)) return false;
+                depth -= item->as.call.argc - 1;
+                vec[depth - 1] = 0;
+                break;
+        }
+        note_depth(ch, base + depth);
+    }
+
+    if (depth != 1) {
+        diag_error(DIAG_COMPILE, filename, line, col, "expression did not reduce to a value");
+        return false;
+    }
+    if (vec[0] && !array) {
+        diag_error(DIAG_COMPILE, filename, line, col, "array value used where a number is expected");
+        return false;
+    }
+    if (array) *array = vec[0];
+    return true;
+}
+
+/**
+ * @brief 값이 수여야 하는 식 (조건, 횟수, 첨자, RETURN 값 등)
+ */
+static bool compile_expr(Chunk* ch, const Expr* expr, const SymTab* st, const char* filename, int64_t line, int64_t col,
+                         int base) {
+    return compile_value(ch, expr, st, filename, line, col, base, NULL);
+}
+
+//========================================
+// Blocks (WHILE / IF / REPEAT / SUB ... END)
+// 블록 시작 문장은 목적지를 모르는 점프를 남기고 블록을 열며, ELSE/END가 그 목적지를 채운다.
+//
+//   WHILE c ; B END ;      L: STMT c JUMP_FALSE X | B | STMT JUMP L | X:
+//   IF c ; B ELSE ; E END ;   STMT c JUMP_FALSE E | B | STMT JUMP X | E: E | STMT | X:
+//   REPEAT n ; B END ;        STMT n REPEAT X | L: B | STMT LOOP L | X:
+//   SUB f ; B END ;           STMT JUMP X | f: B | STMT PUSH_CONST 0 RETURN | X:
+//
+// ELSE/END도 OP_STMT로 시작하므로 모든 점프 목적지는 문장 경계가 된다.
+// 하위 루틴 본문의 문장 base는 프레임 기준이며, 본문에서 VAR는 지역 변수를 만든다 (전역은 읽기만).
+//========================================
+
+static const char* block_name(uint8_t kind) {
+    return kind == STMT_WHILE ? "WHILE" : kind == STMT_IF ? "IF" : kind == STMT_REPEAT ? "REPEAT" : "SUB";
+}
+
+bool bc_in_block(const Chunk* ch) {
+    return ch->nblocks > 0;
+}
+
+/**
+ * @brief 현재 위치의 문장 base (가장 안쪽 블록 본문의 base)
+ */
+static uint32_t cur_base(const Chunk* ch) {
+    return ch->nblocks ? ch->blocks[ch->nblocks - 1].base : 0;
+}
+
+static void patch(Chunk* ch, uint32_t at, size_t target) {
+    ch->code[at].arg = (int32_t)target;
+}
+
+/**
+ * @brief 블록 시작 문장: 조건/횟수 식과 목적지를 비워 둔 점프를 내고 블록을 엶
+ */
+static bool compile_open(Chunk* ch, const Stmt* s, const SymTab* st, const char* filename, uint32_t idx,
+                         size_t mark_code, size_t mark_strs, size_t mark_pool) {
+    if (!grow((void**)&ch->blocks, &ch->blocks_cap, ch->nblocks + 1, sizeof(Block))) return false;
+    uint32_t base = cur_base(ch);
+    if (!compile_expr(ch, &s->condStmt.expr, st, filename, s->line, s->col, (int)base)) return false;
+
+    Block b = {0};
+    b.kind = (uint8_t)s->kind;
+    b.stmt = idx;
+    b.start = (uint32_t)mark_code;
+    b.patch = (uint32_t)ch->count;
+    b.base = base;
+    b.nstrs = mark_strs;
+    b.pool_len = mark_pool;
+    if (!emit(ch, s->kind == STMT_REPEAT ? OP_REPEAT : OP_JUMP_FALSE, 0)) return false;
+    if (s->kind == STMT_REPEAT) b.base = base + 1;     // 본문 동안 카운터가 스택 바닥에 있음
+    b.body = (uint32_t)ch->count;
+    ch->blocks[ch->nblocks++] = b;
+    return true;
+}
+
+/**
+ * @brief SUB: 본문을 건너뛰는 점프를 내고 하위 루틴을 등록 (본문 안의 재귀 호출을 위해 END 전에)
+ * 같은 이름으로 다시 정의하면 그 뒤의 호출부터 새 정의를 부른다.
+ */
+static bool compile_sub(Chunk* ch, const Stmt* s, const SymTab* st, const char* filename, uint32_t idx,
+                        size_t mark_code, size_t mark_strs, size_t mark_pool) {
+    const SubStmt* def = &s->subStmt;
+    if (ch->nblocks) {
+        diag_error(DIAG_SYNTAX, filename, s->line, s->col, "SUB inside a block or another SUB");
+        return false;
+    }
+    // 배열 이름은 본문 안에서도 배열이므로 하위 루틴 / 매개변수 이름으로 쓸 수 없다
+    char msg[128];
+    if (is_array(ch, def->slot)) {
+        snprintf(msg, sizeof(msg), "'%s' is an array", st_name(st, def->slot));
+        diag_error(DIAG_COMPILE, filename, s->line, s->col, msg);
+        return false;
+    }
+    int32_t max_slot = def->slot;
+    for (int i = 0; i < def->nparams; ++i) {
+        if (is_array(ch, def->params[i])) {
+            snprintf(msg, sizeof(msg), "parameter '%s' is an array", st_name(st, def->params[i]));
+            diag_error(DIAG_COMPILE, filename, s->line, s->col, msg);
+            return false;
+        }
+        if (def->params[i] > max_slot) max_slot = def->params[i];
+    }
+    if (!grow((void**)&ch->blocks, &ch->blocks_cap, 1, sizeof(Block)) ||
+        !grow((void**)&ch->subs, &ch->subs_cap, ch->nsubs + 1, sizeof(Sub)) ||
+        !grow((void**)&ch->scope, &ch->scope_cap, (size_t)def->nparams, sizeof(int32_t)) ||
+        !grow_map(&ch->sub_of, &ch->sub_of_cap, (size_t)def->slot + 1) ||
+        !grow_map(&ch->local_of, &ch->local_of_cap, (size_t)max_slot + 1)) return false;
+
+    uint32_t jump = (uint32_t)ch->count;
+    if (!emit(ch, OP_JUMP, 0)) return false;
+
+    Sub sub = {0};
+    sub.slot = def->slot;
+    sub.entry = (uint32_t)ch->count;
+    sub.nparams = sub.nlocals = (uint32_t)def->nparams;
+    sub.start = (uint32_t)mark_code;
+    sub.stmt = idx;
+    sub.nstrs = (uint32_t)mark_strs;
+    sub.pool_len = (uint32_t)mark_pool;
+    ch->subs[ch->nsubs++] = sub;
+    ch->sub_of[def->slot] = (uint32_t)ch->nsubs;
+    for (int i = 0; i < def->nparams; ++i) {
+        ch->scope[ch->nscope++] = def->params[i];
+        ch->local_of[def->params[i]] = (uint32_t)i + 1;
+    }
+
+    Block b = {0};
+    b.kind = STMT_SUB;
+    b.stmt = idx;
+    b.start = (uint32_t)mark_code;
+    b.patch = jump;
+    b.body = (uint32_t)ch->count;
+    b.nstrs = mark_strs;
+    b.pool_len = mark_pool;
+    ch->blocks[ch->nblocks++] = b;
+    return true;
+}
+
+/**
+ * @brief RETURN: 값을 남기고 프레임을 닫음. 값이 호출 하나면 그 호출을 꼬리 호출로 바꿔 프레임을 재사용
+ */
+static bool compile_return(Chunk* ch, const Stmt* s, const SymTab* st, const char* filename, uint32_t base) {
+    if (!open_sub(ch)) {
+        diag_error(DIAG_SYNTAX, filename, s->line, s->col, "RETURN outside SUB");
+        return false;
+    }
+    const Expr* e = &s->returnStmt.expr;
+    if (!s->returnStmt.has_value) {
+        note_depth(ch, (int)base + 1);
+        return emit(ch, OP_PUSH_CONST, 0) && emit(ch, OP_RETURN, 0);
+    }
+    if (!compile_expr(ch, e, st, filename, s->line, s->col, (int)base)) return false;
+    if (ch->code[ch->count - 1].op == OP_CALL) {
+        ch->code[ch->count - 1].op = OP_TAIL_CALL;
+        return true;
+    }
+    return emit(ch, OP_RETURN, 0);
+}
+
+/**
+ * @brief VAR: 변수(하위 루틴 본문에서는 지역 변수)에 대입
+ * 배열 이름이면 첨자가 있을 때 원소에, 없으면 배열 값을 복사하거나 수 하나로 모든 원소를 채운다.
+ * 배열은 하위 루틴 본문에서 바꿀 수 없다 (같은 이름의 지역 변수도 만들 수 없음).
+ */
+static bool compile_var(Chunk* ch, const Stmt* s, const SymTab* st, const char* filename, uint32_t base) {
+    const VarStmt* v = &s->varStmt;
+    if (!v->has_value) {
+        diag_error(DIAG_COMPILE, filename, s->line, s->col, "VAR without initializer is not supported yet");
+        return false;
+    }
+    Sub* sub = open_sub(ch);
+    bool target_array = is_array(ch, v->slot);
+    char msg[128];
+    if ((v->indexed && !target_array) || (target_array && sub)) {
+        snprintf(msg, sizeof(msg), target_array ? "array '%s' is read-only inside SUB" : "'%s' is not an array",
+                 st_name(st, v->slot));
+        diag_error(DIAG_COMPILE, filename, s->line, s->col, msg);
+        return false;
+    }
+    if (v->indexed) {
+        return compile_expr(ch, &v->index_expr, st, filename, s->line, s->col, (int)base) &&
+               compile_expr(ch, &v->value_expr, st, filename, s->line, s->col, (int)base + 1) &&
+               emit(ch, OP_STORE_ELEM, v->slot);
+    }
+    bool array = false;
+    if (!compile_value(ch, &v->value_expr, st, filename, s->line, s->col, (int)base, target_array ? &array : NULL)) {
+        return false;
+    }
+    if (target_array) return emit(ch, array ? OP_STORE_ARRAY : OP_FILL_ARRAY, v->slot);
+    // 하위 루틴 본문의 VAR는 지역 변수 (값을 계산한 뒤에 만들므로 VAR X = X + 1은 전역 X를 읽음)
+    if (sub) {
+        uint32_t local = local_index(ch, v->slot);
+        if (!local) local = declare_local(ch, sub, v->slot);
+        return local && emit(ch, OP_STORE_LOCAL, (int32_t)(local - 1));
+    }
+    return emit(ch, OP_STORE_SLOT, v->slot);
+}
+
+/**
+ * @brief ARRAY: 길이만큼 0으로 채운 배열을 만듦. 이름은 이 문장 뒤부터 배열이다 (다시 선언하면 새 길이로 비움)
+ * 배열은 전역이므로 하위 루틴 본문에서는 선언할 수 없다.
+ */
+static bool compile_array(Chunk* ch, const Stmt* s, const SymTab* st, const char* filename, uint32_t base) {
+    const ArrayStmt* a = &s->arrayStmt;
+    if (open_sub(ch)) {
+        diag_error(DIAG_SYNTAX, filename, s->line, s->col, "ARRAY inside SUB");
+        return false;
+    }
+    if (sub_index(ch, a->slot)) {
+        char msg[128];
+        snprintf(msg, sizeof(msg), "'%s' is a subroutine", st_name(st, a->slot));
+        diag_error(DIAG_COMPILE, filename, s->line, s->col, msg);
+        return false;
+    }
+    if (!grow_map(&ch->array_of, &ch->array_of_cap, (size_t)a->slot + 1) ||
+        !compile_expr(ch, &a->length_expr, st, filename, s->line, s->col, (int)base) ||
+        !emit(ch, OP_ARRAY_NEW, a->slot)) return false;
+    if (!ch->array_of[a->slot]) {
+        ch->array_of[a->slot] = 1;
+        ch->narrays++;
+    }
+    return true;
+}
+
+/**
+ * @brief ELSE: 앞 블록 끝에서 END 뒤로 건너뛰는 점프를 내고, IF의 거짓 목적지를 여기로
+ */
+static bool compile_else(Chunk* ch, const Stmt* s, const char* filename) {
+    Block* b = ch->nblocks ? &ch->blocks[ch->nblocks - 1] : NULL;
+    if (!b || b->kind != STMT_IF || b->has_else) {
+        diag_error(DIAG_SYNTAX, filename, s->line, s->col, "ELSE without matching IF");
+        return false;
+    }
+    uint32_t jump = (uint32_t)ch->count;
+    if (!emit(ch, OP_JUMP, 0)) return false;
+    patch(ch, b->patch, ch->count);
+    b->patch = jump;
+    b->has_else = true;
+    return true;
+}
+
+/**
+ * @brief END: 가장 안쪽 블록을 닫고 점프 목적지를 채움. 시작 문장의 오류 재개 지점도 블록 끝 다음으로
+ * 하위 루틴은 끝에 닿으면 0을 돌려준다.
+ */
+static bool compile_end(Chunk* ch, const Stmt* s, const char* filename) {
+    if (!ch->nblocks) {
+        diag_error(DIAG_SYNTAX, filename, s->line, s->col, "END without WHILE, IF, REPEAT or SUB");
+        return false;
+    }
+    const Block* b = &ch->blocks[ch->nblocks - 1];
+    if (b->kind == STMT_WHILE && !emit(ch, OP_JUMP, (int32_t)b->start)) return false;
+    if (b->kind == STMT_REPEAT && !emit(ch, OP_LOOP, (int32_t)b->body)) return false;
+    if (b->kind == STMT_SUB) {
+        note_depth(ch, 1);
+        if (!emit(ch, OP_PUSH_CONST, 0) || !emit(ch, OP_RETURN, 0)) return false;
+        open_sub(ch)->end = (uint32_t)ch->count;
+        clear_scope(ch);
+    }
+    patch(ch, b->patch, ch->count);
+    ch->stmts[b->stmt].end = (uint32_t)ch->count;
+    ch->nblocks--;
+    return true;
+}
+
+void bc_end_blocks(Chunk* ch, const char* filename) {
+    if (!ch->nblocks) return;
+    for (size_t i = 0; i < ch->nblocks; ++i) {
+        const StmtInfo* at = &ch->stmts[ch->blocks[i].stmt];
+        char msg[48];
+        snprintf(msg, sizeof(msg), "missing END for %s", block_name(ch->blocks[i].kind));
+        diag_error(DIAG_SYNTAX, filename, at->line, at->col, msg);
+    }
+    // 가장 바깥 블록부터 끝까지는 실행할 수 없으므로 버림 (닫히지 않은 하위 루틴은 정의되지 않은 것으로)
+    const Block* outer = &ch->blocks[0];
+    if (outer->kind == STMT_SUB) {
+        unregister_subs(ch, ch->nsubs - 1);
+        clear_scope(ch);
+    }
+    ch->count = outer->start;
+    ch->nstmts = outer->stmt;
+    ch->nstrs = outer->nstrs;
+    ch->pool_len = outer->pool_len;
+    ch->nblocks = 0;
+}
+
+/**
+ * @brief 문장 하나를 컴파일하여 chunk 뒤에 덧붙임
+ *
+ * 각 문장은 OP_STMT로 시작한다. 컴파일 오류가 나면 진단을 출력하고 이 문장의 코드를 되돌린다.
+ * 블록 문장은 열린 블록을 갱신하며, 블록이 열려 있는 동안(bc_in_block)은 chunk를 실행할 수 없다.
+ * 하위 루틴을 닫는 END 뒤에는 bc_reset_stmts가 남길 위치(keep_*)를 옮긴다.
+ * @return 코드가 생성되었으면 true, 컴파일 오류로 건너뛰었으면 false.
+ */
+bool bc_compile_stmt(Chunk* ch, const Stmt* s, const SymTab* st, const char* filename) {
+    if (s->kind == STMT_NONE) return false;
+
+    size_t mark_code = ch->count, mark_strs = ch->nstrs, mark_pool = ch->pool_len;
+    uint32_t idx = (uint32_t)ch->nstmts;
+    // END는 닫는 블록의 본문 base에서 시작한다 (REPEAT 카운터가 아직 있음)
+    uint32_t base = cur_base(ch);
+    bool closes_sub = s->kind == STMT_END && ch->nblocks == 1 && ch->blocks[0].kind == STMT_SUB;
+    if (!grow((void**)&ch->stmts, &ch->stmts_cap, ch->nstmts + 1, sizeof(StmtInfo)) ||
+        !emit(ch, OP_STMT, (int32_t)idx)) {
+        ch->count = mark_code;
+        return false;
+    }
+
+    bool ok = true;
+    switch (s->kind) {
+        case STMT_PRINT: {
+            bool array = false;
+            ok = compile_value(ch, &s->printStmt.expr, st, filename, s->line, s->col, (int)base, &array) &&
+                 emit(ch, array ? OP_PRINT_ARRAY : OP_PRINT_INT, 0);
+            break;
+        }
+
+        case STMT_PRINT_STR: {
+            int32_t str = add_string(ch, s->printStrStmt.text, s->printStrStmt.len);
+            ok = str >= 0 && emit(ch, OP_PRINT_STR, str);
+            break;
+        }
+
+        case STMT_VAR:
+            ok = compile_var(ch, s, st, filename, base);
+            break;
+
+        case STMT_WHILE:
+        case STMT_IF:
+        case STMT_REPEAT:
+            ok = compile_open(ch, s, st, filename, idx, mark_code, mark_strs, mark_pool);
+            break;
+
+        case STMT_ELSE:
+            ok = compile_else(ch, s, filename);
+            break;
+
+        case STMT_END:
+            ok = compile_end(ch, s, filename);
+            break;
+
+        case STMT_SUB:
+            ok = compile_sub(ch, s, st, filename, idx, mark_code, mark_strs, mark_pool);
+            break;
+
+        case STMT_RETURN:
+            ok = compile_return(ch, s, st, filename, base);
+            break;
+
+        case STMT_ARRAY:
+            ok = compile_array(ch, s, st, filename, base);
+            break;
+
+        default:
+            diag_error(DIAG_INTERNAL, filename, s->line, s->col, "Internal error: Unknown statement kind");
+            ok = false;
+            break;
+    }
+
+    if (!ok) {
+        ch->count = mark_code;
+        ch->nstrs = mark_strs;
+        ch->pool_len = mark_pool;
+        return false;
+    }
+    ch->stmts[idx].line = s->line;
+    ch->stmts[idx].col = s->col;
+    ch->stmts[idx].base = base;
+    // 블록 시작 문장의 재개 지점은 END에서 블록 끝 다음으로 다시 채운다
+    if (!bc_in_block(ch) || ch->blocks[ch->nblocks - 1].stmt != idx) ch->stmts[idx].end = (uint32_t)ch->count;
+    note_depth(ch, (int)base);
+    ch->nstmts++;
+    if (closes_sub) {
+        ch->keep_code = ch->count;
+        ch->keep_stmts = ch->nstmts;
+        ch->keep_strs = ch->nstrs;
+        ch->keep_pool = ch->pool_len;
+    }
+    return true;
+}
+
+bool bc_finish(Chunk* ch) {
+    return emit(ch, OP_HALT, 0);
+}
+
+
+//========================================
+// Disassembler (--dump-bytecode)
+//========================================
+
+static const char* op_name(uint8_t op) {
+    switch (op) {
+        case OP_STMT: return "STMT";
+        case OP_PUSH_CONST: return "PUSH_CONST";
+        case OP_LOAD_SLOT: return "LOAD_SLOT";
+        case OP_ADD: return "ADD";
+        case OP_SUB: return "SUB";
+        case OP_MUL: return "MUL";
+        case OP_DIV: return "DIV";
+        case OP_MOD: return "MOD";
+        case OP_PRINT_INT: return "PRINT_INT";
+        case OP_PRINT_STR: return "PRINT_STR";
+        case OP_STORE_SLOT: return "STORE_SLOT";
+        case OP_JUMP: return "JUMP";
+        case OP_JUMP_FALSE: return "JUMP_FALSE";
+        case OP_REPEAT: return "REPEAT";
+        case OP_LOOP: return "LOOP";
+        case OP_LOAD_LOCAL: return "LOAD_LOCAL";
+        case OP_STORE_LOCAL: return "STORE_LOCAL";
+        case OP_CALL: return "CALL";
+        case OP_TAIL_CALL: return "TAIL_CALL";
+        case OP_RETURN: return "RETURN";
+        case OP_ARRAY_NEW: return "ARRAY_NEW";
+        case OP_LOAD_ELEM: return "LOAD_ELEM";
+        case OP_STORE_ELEM: return "STORE_ELEM";
+        case OP_LOAD_ARRAY: return "LOAD_ARRAY";
+        case OP_VEC: return "VEC";
+        case OP_STORE_ARRAY: return "STORE_ARRAY";
+        case OP_FILL_ARRAY: return "FILL_ARRAY";
+        case OP_PRINT_ARRAY: return "PRINT_ARRAY";
+        case OP_HALT: return "HALT";
+        default: return "???";
+    }
+}
+
+/**
+ * @brief chunk의 명령어 목록을 사람이 읽을 수 있는 형태로 출력
+ */
+void bc_dump(const Chunk* ch, const SymTab* st, FILE* out) {
+    for (size_t pc = 0; pc < ch->count; ++pc) {
+        const Instr* in = &ch->code[pc];
+        switch (in->op) {
+            case OP_STMT: {
+                const StmtInfo* si = &ch->stmts[in->arg];
+                fprintf(out, "%04zu  %-11s %-6d ; line %" PRId64 ":%" PRId64 "\n", pc, op_name(in->op), (int)in->arg, si->line, si->col);
+                break;
+            }
+            case OP_PUSH_CONST:
+            case OP_JUMP:
+            case OP_JUMP_FALSE:
+            case OP_REPEAT:
+            case OP_LOOP:
+            case OP_LOAD_LOCAL:
+            case OP_STORE_LOCAL:
+                fprintf(out, "%04zu  %-11s %d\n", pc, op_name(in->op), (int)in->arg);
+                break;
+            case OP_CALL:
+            case OP_TAIL_CALL:
+                fprintf(out, "%04zu  %-11s %-6d ; %s\n", pc, op_name(in->op), (int)in->arg,
+                        st_name(st, ch->subs[in->arg].slot));
+                break;
+            case OP_VEC: {
+                static const char* const shapes[] = { "?", "array, number", "number, array", "array, array" };
+                fprintf(out, "%04zu  %-11s %-6d ; %c (%s)\n", pc, op_name(in->op), (int)in->arg,
+                        "+-*/%"[in->arg / 4 % VEC_NOPS], shapes[in->arg & 3]);
+                break;
+            }
+            case OP_LOAD_SLOT:
+            case OP_STORE_SLOT:
+            case OP_ARRAY_NEW:
+            case OP_LOAD_ELEM:
+            case OP_STORE_ELEM:
+            case OP_LOAD_ARRAY:
+            case OP_STORE_ARRAY:
+            case OP_FILL_ARRAY:
+                fprintf(out, "%04zu  %-11s %-6d ; %s\n", pc, op_name(in->op), (int)in->arg, st_name(st, in->arg));
+                break;
+            case OP_PRINT_STR: {
+                const StrRef* sr = &ch->strs[in->arg];
+                fprintf(out, "%04zu  %-11s %-6d ; \"%.*s\"\n", pc, op_name(in->op), (int)in->arg,
+                        (int)sr->len, ch->pool + sr->off);
+                break;
+            }
+            default:
+                fprintf(out, "%04zu  %s\n", pc, op_name(in->op));
+                break;
+        }
+    }
+}
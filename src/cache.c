@@ -0,0 +1,514 @@
+//========================================
+// System Includes
+//========================================
+#include "cache.h"
+#include "vec.h"
+#include "version.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//========================================
+// Key (소스 해시 / 경로)
+//========================================
+
+static inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+/**
+ * @brief 소스 내용의 64비트 해시 (8바이트씩 섞고 마지막에 avalanche)
+ * 변경 감지용이며 암호학적 해시가 아니다. 렉싱보다 훨씬 빨라 매 실행마다 계산해도 부담이 없다.
+ */
+uint64_t cache_hash(const char* data, size_t size) {
+    const uint64_t K1 = 0x9E3779B185EBCA87ull, K2 = 0xC2B2AE3D27D4EB4Full;
+    uint64_t h = 0x27D4EB2F165667C5ull ^ (uint64_t)size;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t w;
+        memcpy(&w, data + i, 8);
+        h = rotl64(h ^ (w * K2), 31) * K1;
+    }
+    uint64_t tail = 0;
+    for (size_t k = 0; i + k < size; ++k) tail |= (uint64_t)(unsigned char)data[i + k] << (8 * k);
+    h = rotl64(h ^ (tail * K2), 31) * K1;
+
+    h ^= h >> 33; h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33; h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * @brief 소스 경로 옆의 캐시 경로 ("prog.dit" → "prog.ditc", 그 외에는 ".ditc"를 덧붙임)
+ */
+char* cache_path(const char* filename) {
+    size_t n = strlen(filename);
+    if (n >= 4 && strcmp(filename + n - 4, ".dit") == 0) n -= 4;
+    char* path = malloc(n + 6);
+    if (!path) return NULL;
+    memcpy(path, filename, n);
+    memcpy(path + n, ".ditc", 6);
+    return path;
+}
+
+static size_t align8(size_t n) { return (n + 7) & ~(size_t)7; }
+
+/**
+ * @brief 헤더(checksum 필드 제외)와 내용을 합친 체크섬
+ */
+static uint64_t file_checksum(const DitcHeader* h, const char* payload, size_t len) {
+    DitcHeader copy = *h;
+    copy.checksum = 0;
+    return rotl64(cache_hash((const char*)&copy, sizeof(copy)), 17) ^ cache_hash(payload, len);
+}
+
+#ifndef _WIN32
+//========================================
+// Load (mmap + 검증)
+//========================================
+
+/**
+ * @brief pc가 속한 하위 루틴 본문 (subs는 위치 순서로 정렬됨, 본문 밖이면 -1)
+ */
+static long region_of(const Chunk* ch, size_t pc) {
+    size_t lo = 0, hi = ch->nsubs;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (pc < ch->subs[mid].entry) hi = mid;
+        else if (pc >= ch->subs[mid].end) lo = mid + 1;
+        else return (long)mid;
+    }
+    return -1;
+}
+
+/**
+ * @brief 하위 루틴 표 확인: 본문은 겹치지 않고 순서대로이며, 정의 문장의 JUMP가 본문을 건너뛰고,
+ * 본문은 OP_STMT로 시작해 RETURN / TAIL_CALL로 끝난다 (본문 밖으로 흘러 나가지 않도록)
+ */
+static bool verify_subs(const Chunk* ch, uint64_t nsyms) {
+    uint32_t prev_end = 0;
+    for (size_t k = 0; k < ch->nsubs; ++k) {
+        const Sub* sub = &ch->subs[k];
+        if (sub->slot < 0 || (uint64_t)sub->slot >= nsyms) return false;
+        if (sub->entry <= prev_end || sub->entry >= sub->end || sub->end >= ch->count) return false;
+        const Instr jump = ch->code[sub->entry - 1];
+        if (jump.op != OP_JUMP || jump.arg != (int32_t)sub->end || ch->code[sub->entry].op != OP_STMT) return false;
+        uint8_t last = ch->code[sub->end - 1].op;
+        if (last != OP_RETURN && last != OP_TAIL_CALL) return false;
+        // 지역 변수는 서로 다른 이름이고, 식 깊이는 명령어 수를 넘을 수 없다
+        if (sub->nparams > sub->nlocals || sub->nlocals > nsyms || sub->max_stack > ch->count) return false;
+        prev_end = sub->end;
+    }
+    return true;
+}
+
+/**
+ * @brief 스택 칸마다 배열 값인지 기록 (배열 값 연산이 VM의 vecs를 채운 칸만 읽도록)
+ */
+typedef struct {
+    uint8_t* is_vec;
+    size_t cap;
+} VecShapes;
+
+static bool shape_set(VecShapes* vs, int pos, bool is_vec) {
+    if ((size_t)pos >= vs->cap) {
+        size_t cap = vs->cap ? vs->cap : 64;
+        while (cap <= (size_t)pos) cap *= 2;
+        uint8_t* p = realloc(vs->is_vec, cap);
+        if (!p) return false;
+        vs->is_vec = p;
+        vs->cap = cap;
+    }
+    vs->is_vec[pos] = is_vec;
+    return true;
+}
+
+static bool shape_is_vec(const VecShapes* vs, int pos) { return (size_t)pos < vs->cap && vs->is_vec[pos]; }
+
+/**
+ * @brief 문장 안에 남은 배열 값이 있는지 (배열을 다시 할당하는 연산 전에는 없어야 보기(view)가 무효가 되지 않는다)
+ */
+static bool shape_any_vec(const VecShapes* vs, int from, int to) {
+    for (int pos = from; pos < to; ++pos) {
+        if (shape_is_vec(vs, pos)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 매핑된 바이트코드가 VM이 가정하는 불변식을 지키는지 확인
+ * (손상되거나 잘린 파일로 범위 밖을 읽지 않도록: 인덱스 범위, 스택 깊이, 마지막 OP_HALT)
+ * 하위 루틴 본문은 따로 검사한다: 점프와 오류 재개 지점은 같은 본문 안, 깊이는 본문의 max_stack 이하.
+ * 배열 연산은 컴파일러가 만드는 모양만 허용한다: 본문 안에서는 원소 읽기만, 배열 값은 같은 문장 안에서 만든 칸만.
+ */
+static bool verify_code(const Chunk* ch, uint64_t nsyms, VecShapes* vs) {
+    if (ch->count == 0 || ch->code[ch->count - 1].op != OP_HALT || ch->max_stack < 0) return false;
+    if (!verify_subs(ch, nsyms)) return false;
+    for (size_t i = 0; i < ch->nstmts; ++i) {
+        // 오류 시 재개 지점은 다음 문장 시작(또는 끝)이어야 스택이 초기화된다
+        uint32_t end = ch->stmts[i].end;
+        if (end >= ch->count || (ch->code[end].op != OP_STMT && ch->code[end].op != OP_HALT)) return false;
+    }
+    for (size_t i = 0; i < ch->nstrs; ++i) {
+        if ((uint64_t)ch->strs[i].off + ch->strs[i].len > ch->pool_len) return false;
+    }
+
+    // depth는 스택 전체 깊이(본문 안에서는 지역 변수 위), base 아래(REPEAT 카운터)는 식 연산이 꺼낼 수 없다
+    bool in_stmt = false;
+    int depth = 0, base = 0;
+    const Sub* sub = NULL;      // pc가 속한 본문
+    int limit = ch->max_stack;
+    uint32_t stmt_end = 0;
+    for (size_t pc = 0; pc < ch->count; ++pc) {
+        const Instr in = ch->code[pc];
+        long k = region_of(ch, pc);
+        if ((k < 0) != (sub == NULL) || (k >= 0 && sub != &ch->subs[k])) {
+            // 본문 경계: 들어갈 때는 본문의 OP_STMT에서 깊이가 정해진다
+            sub = k < 0 ? NULL : &ch->subs[k];
+            limit = sub ? (int)sub->max_stack : ch->max_stack;
+            in_stmt = false;
+        }
+        switch (in.op) {
+            case OP_STMT:
+                // 재개 지점이 앞쪽이면 같은 오류를 반복하며 멈추지 않으므로 뒤쪽만 허용
+                if (in.arg < 0 || (size_t)in.arg >= ch->nstmts || ch->stmts[in.arg].end <= pc) return false;
+                stmt_end = ch->stmts[in.arg].end;
+                if (sub ? stmt_end > sub->end : region_of(ch, stmt_end) >= 0) return false;
+                in_stmt = true;
+                // base는 문장이 속한 본문(또는 바깥)의 한도 안이어야 한다 (int로 바꾸기 전에 확인)
+                if (ch->stmts[in.arg].base > (uint32_t)limit) return false;
+                depth = base = (int)ch->stmts[in.arg].base;
+                break;
+            case OP_PUSH_CONST:
+                depth++;
+                break;
+            case OP_LOAD_SLOT:
+                if (in.arg < 0 || (uint64_t)in.arg >= nsyms) return false;
+                depth++;
+                break;
+            case OP_LOAD_ARRAY:
+                if (sub || in.arg < 0 || (uint64_t)in.arg >= nsyms) return false;
+                if (!shape_set(vs, depth++, true)) return false;
+                break;
+            case OP_LOAD_ELEM:
+                if (in.arg < 0 || (uint64_t)in.arg >= nsyms || depth - base < 1) return false;
+                break;
+            case OP_STORE_ELEM:
+                if (sub || in.arg < 0 || (uint64_t)in.arg >= nsyms || depth - base < 2) return false;
+                depth -= 2;
+                break;
+            case OP_ARRAY_NEW: case OP_FILL_ARRAY:
+                if (sub || in.arg < 0 || (uint64_t)in.arg >= nsyms || depth - base < 1) return false;
+                depth--;
+                if (in.op == OP_ARRAY_NEW && shape_any_vec(vs, base, depth)) return false;
+                break;
+            case OP_STORE_ARRAY:
+                if (sub || in.arg < 0 || (uint64_t)in.arg >= nsyms || depth - base < 1) return false;
+                if (!shape_is_vec(vs, --depth) || shape_any_vec(vs, base, depth)) return false;
+                break;
+            case OP_VEC: {
+                int shape = in.arg & 3;
+                if (sub || in.arg < 0 || shape == 0 || (in.arg >> 2) >= VEC_NOPS || depth - base < 2) return false;
+                if (shape_is_vec(vs, depth - 2) != ((shape & VEC_LEFT) != 0) ||
+                    shape_is_vec(vs, depth - 1) != ((shape & VEC_RIGHT) != 0)) return false;
+                depth--;
+                if (!shape_set(vs, depth - 1, true)) return false;
+                break;
+            }
+            case OP_PRINT_ARRAY:
+                if (sub || depth - base < 1 || !shape_is_vec(vs, --depth)) return false;
+                break;
+            case OP_STORE_SLOT:
+                if (in.arg < 0 || (uint64_t)in.arg >= nsyms || depth - base < 1) return false;
+                depth--;
+                break;
+            case OP_LOAD_LOCAL: case OP_STORE_LOCAL:
+                if (!sub || in.arg < 0 || (uint32_t)in.arg >= sub->nlocals) return false;
+                if (in.op == OP_STORE_LOCAL && depth - base < 1) return false;
+                depth += in.op == OP_LOAD_LOCAL ? 1 : -1;
+                break;
+            case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV: case OP_MOD:
+                if (depth - base < 2) return false;
+                depth--;
+                break;
+            case OP_PRINT_INT:
+                if (depth - base < 1) return false;
+                depth--;
+                break;
+            case OP_JUMP: case OP_JUMP_FALSE: case OP_REPEAT: case OP_LOOP:
+                // 목적지는 문장 경계여야 도착하면 스택이 그 문장의 base로 맞춰진다
+                if (in.arg < 0 || (size_t)in.arg >= ch->count) return false;
+                if (ch->code[in.arg].op != OP_STMT && ch->code[in.arg].op != OP_HALT) return false;
+                if (sub ? (uint32_t)in.arg < sub->entry || (uint32_t)in.arg >= sub->end
+                        : region_of(ch, (size_t)in.arg) >= 0) return false;
+                if ((in.op == OP_JUMP_FALSE || in.op == OP_REPEAT) && depth - base < 1) return false;
+                if (in.op == OP_LOOP && (depth != base || depth < 1)) return false;
+                if (in.op == OP_JUMP_FALSE || in.op == OP_LOOP) depth--;
+                break;
+            case OP_CALL: case OP_TAIL_CALL:
+                if (in.arg < 0 || (size_t)in.arg >= ch->nsubs) return false;
+                if (depth - base < (int64_t)ch->subs[in.arg].nparams) return false;
+                if (in.op == OP_TAIL_CALL && !sub) return false;
+                depth += 1 - (int)ch->subs[in.arg].nparams;
+                break;
+            case OP_RETURN:
+                if (!sub || depth - base < 1) return false;
+                break;
+            case OP_PRINT_STR:
+                if (in.arg < 0 || (size_t)in.arg >= ch->nstrs) return false;
+                break;
+            case OP_HALT:
+                if (sub) return false;
+                break;
+            default:
+                return false;
+        }
+        // 런타임 오류 보고에는 현재 문장이 필요하다
+        if (!in_stmt && in.op != OP_HALT) return false;
+        if (depth > limit) return false;
+        // 스칼라 결과를 top에 남기는 연산 (배열 값을 만드는 연산은 위에서 표시함)
+        bool scalar_result = in.op == OP_PUSH_CONST || in.op == OP_LOAD_SLOT || in.op == OP_LOAD_LOCAL ||
+                             (in.op >= OP_ADD && in.op <= OP_MOD) || in.op == OP_LOAD_ELEM || in.op == OP_CALL;
+        if (scalar_result && !shape_set(vs, depth - 1, false)) return false;
+        // 본문 안의 오류는 재개 지점으로 가므로 그 지점이 같은 본문 안이어야 한다 (END 문장만 본문 끝을 가리킴)
+        bool fallible = in.op == OP_LOAD_SLOT || in.op == OP_DIV || in.op == OP_MOD || in.op == OP_CALL ||
+                        in.op == OP_LOAD_ELEM;
+        if (sub && fallible && stmt_end >= sub->end) return false;
+    }
+    return true;
+}
+
+static bool verify_chunk(const Chunk* ch, uint64_t nsyms) {
+    VecShapes vs = {0};
+    bool ok = verify_code(ch, nsyms, &vs);
+    free(vs.is_vec);
+    return ok;
+}
+
+CacheStatus cache_load(DitCache* dc, const char* path, uint64_t src_hash, uint64_t src_size, uint32_t flags) {
+    memset(dc, 0, sizeof(*dc));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return CACHE_MISS;
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode) || (uint64_t)sb.st_size < sizeof(DitcHeader)) {
+        close(fd);
+        return CACHE_MISS;
+    }
+    size_t size = (size_t)sb.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return CACHE_MISS;
+
+    const DitcHeader* h = map;
+    char version[sizeof(h->version)] = {0};
+    strncpy(version, DAHDIT_VERSION, sizeof(version) - 1);
+    if (memcmp(h->magic, DITC_MAGIC, 4) != 0 || h->format != DITC_FORMAT ||
+        memcmp(h->version, version, sizeof(version)) != 0 ||
+        h->src_hash != src_hash || h->src_size != src_size ||
+        (h->flags & ~DITC_UNCACHEABLE) != flags) {
+        munmap(map, size);
+        return CACHE_MISS;
+    }
+    if (h->flags & DITC_UNCACHEABLE) {
+        munmap(map, size);
+        return CACHE_UNCACHEABLE;
+    }
+    if (file_checksum(h, (const char*)map + sizeof(DitcHeader), size - sizeof(DitcHeader)) != h->checksum) {
+        munmap(map, size);
+        return CACHE_MISS;
+    }
+
+    // 구간 경계 계산 (개수가 터무니없으면 곱셈 전에 걸러냄)
+    uint64_t limit = size;
+    if (h->ncode > limit || h->nstmts > limit || h->nsubs > limit || h->nstrs > limit ||
+        h->pool_len > limit ||
+        h->nsyms > limit || h->names_len > limit) {
+        munmap(map, size);
+        return CACHE_MISS;
+    }
+    size_t off = sizeof(DitcHeader);
+    size_t code_off = off;   off += align8((size_t)h->ncode * sizeof(Instr));
+    size_t stmts_off = off;  off += align8((size_t)h->nstmts * sizeof(StmtInfo));
+    size_t subs_off = off;   off += align8((size_t)h->nsubs * sizeof(Sub));
+    size_t strs_off = off;   off += align8((size_t)h->nstrs * sizeof(StrRef));
+    size_t pool_off = off;   off += align8((size_t)h->pool_len);
+    size_t names_off = off;  off += (size_t)h->names_len;
+    const char* base = map;
+    const char* names = base + names_off;
+
+    // 이름 개수 확인: 마지막 이름까지 null-terminated
+    uint64_t terminators = 0;
+    if (off <= size) {
+        for (const char* p = names; (p = memchr(p, '\0', (size_t)(names + h->names_len - p))) != NULL; ++p) {
+            terminators++;
+        }
+    }
+    if (off > size || terminators != h->nsyms ||
+        (h->names_len && names[h->names_len - 1] != '\0')) {
+        munmap(map, size);
+        return CACHE_MISS;
+    }
+
+    Chunk* ch = &dc->chunk;
+    ch->code = (Instr*)(base + code_off);
+    ch->count = ch->cap = (size_t)h->ncode;
+    ch->stmts = (StmtInfo*)(base + stmts_off);
+    ch->nstmts = ch->stmts_cap = (size_t)h->nstmts;
+    ch->subs = (Sub*)(base + subs_off);
+    ch->nsubs = ch->subs_cap = (size_t)h->nsubs;
+    ch->strs = (StrRef*)(base + strs_off);
+    ch->nstrs = ch->strs_cap = (size_t)h->nstrs;
+    ch->pool = (char*)(base + pool_off);
+    ch->pool_len = ch->pool_cap = (size_t)h->pool_len;
+    ch->max_stack = h->max_stack;
+    if (!verify_chunk(ch, h->nsyms)) {
+        munmap(map, size);
+        memset(dc, 0, sizeof(*dc));
+        return CACHE_MISS;
+    }
+
+    madvise(map, size, MADV_WILLNEED);
+    dc->map = map;
+    dc->size = size;
+    dc->names = names;
+    dc->nsyms = h->nsyms;
+    return CACHE_HIT;
+}
+
+void cache_close(DitCache* dc) {
+    if (dc->map) munmap(dc->map, dc->size);
+    memset(dc, 0, sizeof(*dc));
+}
+
+//========================================
+// Save (임시 파일에 쓴 뒤 rename: 다른 프로세스가 반쯤 쓰인 파일을 읽지 않도록)
+//========================================
+
+/**
+ * @brief 헤더 뒤 내용을 한 버퍼에 만듦 (패딩은 0으로 채워 같은 프로그램이면 같은 파일이 되게 함)
+ */
+static char* build_payload(const DitcHeader* h, const Chunk* ch, const SymTab* st, size_t* size) {
+    size_t code_len = align8(ch->count * sizeof(Instr));
+    size_t stmts_len = align8(ch->nstmts * sizeof(StmtInfo));
+    size_t subs_len = align8(ch->nsubs * sizeof(Sub));
+    size_t strs_len = align8(ch->nstrs * sizeof(StrRef));
+    size_t pool_len = align8(ch->pool_len);
+    *size = code_len + stmts_len + subs_len + strs_len + pool_len + (size_t)h->names_len;
+    char* buf = calloc(*size ? *size : 1, 1);
+    if (!buf) return NULL;
+
+    char* p = buf;
+    if (ch->count) memcpy(p, ch->code, ch->count * sizeof(Instr));
+    p += code_len;
+    for (size_t i = 0; i < ch->nstmts; ++i) {
+        StmtInfo si;
+        memset(&si, 0, sizeof(si));
+        si.line = ch->stmts[i].line;
+        si.col = ch->stmts[i].col;
+        si.end = ch->stmts[i].end;
+        si.base = ch->stmts[i].base;
+        memcpy(p + i * sizeof(StmtInfo), &si, sizeof(si));
+    }
+    p += stmts_len;
+    if (ch->nsubs) memcpy(p, ch->subs, ch->nsubs * sizeof(Sub));
+    p += subs_len;
+    if (ch->nstrs) memcpy(p, ch->strs, ch->nstrs * sizeof(StrRef));
+    p += strs_len;
+    if (ch->pool_len) memcpy(p, ch->pool, ch->pool_len);
+    p += pool_len;
+    for (int slot = 0; slot < st->count; ++slot) {
+        const char* name = st_name(st, slot);
+        size_t len = strlen(name) + 1;
+        memcpy(p, name, len);
+        p += len;
+    }
+    return buf;
+}
+
+bool cache_save(const char* path, uint64_t src_hash, uint64_t src_size, uint32_t flags,
+                const Chunk* ch, const SymTab* st) {
+    DitcHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, DITC_MAGIC, 4);
+    h.format = DITC_FORMAT;
+    strncpy(h.version, DAHDIT_VERSION, sizeof(h.version) - 1);
+    h.src_hash = src_hash;
+    h.src_size = src_size;
+    h.flags = ch ? flags : flags | DITC_UNCACHEABLE;
+
+    char* payload = NULL;
+    size_t payload_len = 0;
+    if (ch) {
+        h.max_stack = ch->max_stack;
+        h.ncode = ch->count;
+        h.nstmts = ch->nstmts;
+        h.nsubs = ch->nsubs;
+        h.nstrs = ch->nstrs;
+        h.pool_len = ch->pool_len;
+        h.nsyms = (uint64_t)st->count;
+        for (int slot = 0; slot < st->count; ++slot) h.names_len += strlen(st_name(st, slot)) + 1;
+        payload = build_payload(&h, ch, st, &payload_len);
+        if (!payload) return false;
+    }
+    h.checksum = file_checksum(&h, payload ? payload : "", payload_len);
+
+    size_t n = strlen(path);
+    char* tmp = malloc(n + 48);
+    FILE* fp = NULL;
+    if (tmp) {
+        // 같은 프로세스의 여러 스레드(배치 실행)가 같은 캐시를 동시에 저장할 수 있으므로 순번도 붙임
+        static atomic_uint seq;
+        snprintf(tmp, n + 48, "%s.%ld.%u.tmp", path, (long)getpid(), atomic_fetch_add(&seq, 1));
+        fp = fopen(tmp, "wb");
+    }
+    if (!fp) { free(tmp); free(payload); return false; }
+
+    bool ok = fwrite(&h, sizeof(h), 1, fp) == 1 &&
+              (payload_len == 0 || fwrite(payload, 1, payload_len, fp) == payload_len);
+    if (fclose(fp) != 0) ok = false;
+    if (ok) ok = rename(tmp, path) == 0;
+    if (!ok) remove(tmp);
+    free(tmp);
+    free(payload);
+    return ok;
+}
+#else
+//========================================
+// mmap이 없는 환경: 캐시를 사용하지 않음
+//========================================
+CacheStatus cache_load(DitCache* dc, const char* path, uint64_t src_hash, uint64_t src_size, uint32_t flags) {
+    (void)path; (void)src_hash; (void)src_size; (void)flags;
+    memset(dc, 0, sizeof(*dc));
+    return CACHE_MISS;
+}
+
+void cache_close(DitCache* dc) {
+    memset(dc, 0, sizeof(*dc));
+}
+
+bool cache_save(const char* path, uint64_t src_hash, uint64_t src_size, uint32_t flags,
+                const Chunk* ch, const SymTab* st) {
+    (void)path; (void)src_hash; (void)src_size; (void)flags; (void)ch; (void)st;
+    return false;
+}
+#endif
+
+/**
+ * @brief 캐시의 이름들을 순서대로 등록하여 바이트코드의 슬롯 번호와 맞춤 (st는 비어 있어야 함)
+ */
+bool cache_intern(const DitCache* dc, SymTab* st) {
+    const char* p = dc->names;
+    for (uint64_t i = 0; i < dc->nsyms; ++i) {
+        size_t len = strlen(p);
+        if (st_intern(st, p, len) != (int)i) return false;
+        p += len + 1;
+    }
+    return true;
+}
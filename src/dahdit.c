@@ -0,0 +1,93 @@
+//========================================
+// System Includes
+//========================================
+#include "dahdit.h"
+#include "diag.h"
+#include "interp.h"
+#include "output.h"
+#include <stdlib.h>
+
+//========================================
+// Context (Interp + 출력 버퍼 + 진단 콜백)
+//========================================
+struct DahditContext {
+    Output out;
+    Interp it;
+    DiagConfig diag;
+    DiagSink sink;  // config는 diag를 가리킴
+};
+
+DahditContext* dahdit_create(const DahditConfig* config) {
+    DahditConfig defaults = {0};
+    if (!config) config = &defaults;
+
+    DahditContext* ctx = malloc(sizeof(*ctx));
+    if (!ctx) return NULL;
+
+    OutFlush policy = config->line_buffered ? OUT_FLUSH_LINE : OUT_FLUSH_FULL;
+    if (config->write) out_init_sink(&ctx->out, config->write, config->user, policy);
+    else out_init(&ctx->out, 1, policy);
+
+    RunOptions opts = {0};
+    opts.optimize = config->optimize;
+    opts.parallel = config->parallel > 0 ? config->parallel : 0;
+    opts.flush = policy;
+    opts.jit = config->jit;
+    opts.no_cache = true;   // 라이브러리는 호출자의 디렉터리에 .ditc를 만들지 않는다
+    opts.vars_live_out = true;  // 변수는 다음 dahdit_run_*에서도 읽힌다
+    interp_init(&ctx->it, &opts, &ctx->out);
+
+    ctx->diag.format = config->diag_json ? DIAG_FORMAT_JSON : DIAG_FORMAT_TEXT;
+    ctx->diag.fold = config->diag_fold;
+    ctx->diag.max_errors = config->max_errors;
+    ctx->sink.fn = config->diag;
+    ctx->sink.user = config->user;
+    ctx->sink.config = &ctx->diag;
+    return ctx;
+}
+
+void dahdit_destroy(DahditContext* ctx) {
+    if (!ctx) return;
+    interp_free(&ctx->it);
+    out_free(&ctx->out);
+    free(ctx);
+}
+
+void dahdit_reset(DahditContext* ctx) {
+    interp_reset(&ctx->it);
+}
+
+/**
+ * @brief 실행하는 동안만 이 스레드의 진단 대상과 출력 설정을 컨텍스트의 것으로 바꿈
+ * 호출자가 캡처 중이더라도 진단은 컨텍스트 콜백으로 간다. 접어 둔 진단은 되돌릴 때 컨텍스트 콜백으로 내보낸다.
+ */
+typedef struct {
+    DiagSink sink;
+    DiagBuffer* capture;
+} DiagState;
+
+static DiagState enter(DahditContext* ctx) {
+    DiagState saved;
+    saved.sink = diag_set_sink(ctx->sink);
+    saved.capture = diag_capture(NULL);
+    return saved;
+}
+
+static bool leave(DahditContext* ctx, DiagState saved, bool ok) {
+    if (!out_flush(&ctx->out) || diag_stopped()) ok = false;
+    diag_capture(saved.capture);
+    diag_set_sink(saved.sink);
+    return ok;
+}
+
+bool dahdit_run_buffer(DahditContext* ctx, const char* name, const char* data, size_t size) {
+    DiagState saved = enter(ctx);
+    bool ok = interp_run_buffer(&ctx->it, name ? name : "<buffer>", data, size);
+    return leave(ctx, saved, ok);
+}
+
+bool dahdit_run_file(DahditContext* ctx, const char* path) {
+    DiagState saved = enter(ctx);
+    bool ok = interp_run_file(&ctx->it, path);
+    return leave(ctx, saved, ok);
+}
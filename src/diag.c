@@ -1,6 +1,419 @@
+#include <inttypes.h>
+#include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "diag.h"
+#include "profile.h"
 
-void diag_error(const char *file, int line, int col, const char *msg) {
-    fprintf(stderr, "%s:%d:%d: error: %s\n", file ? file : "<stdin>", line, col, msg);
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#endif
+
+// 프로세스 전체 출력 설정 (실행 전에 diag_configure로 정한 뒤 읽기만 함)
+static DiagConfig g_config;
+
+// 스레드마다 독립적인 캡처 대상 (NULL이면 싱크 또는 stderr로 직접 출력)
+static _Thread_local DiagBuffer* t_capture;
+// 스레드마다 독립적인 최종 출력 대상 (fn이 NULL이면 stderr). 임베딩 시 컨텍스트별 콜백
+static _Thread_local DiagSink t_sink;
+
+/**
+ * @brief 현재 스레드에 적용되는 출력 설정 (싱크의 설정, 없으면 프로세스 설정)
+ */
+static const DiagConfig* active_config(void) {
+    return t_sink.config ? t_sink.config : &g_config;
+}
+
+typedef struct {
+    char* buf;
+    size_t len, cap;
+} Bytes;
+
+// 스레드마다의 실행 상태: 오류 수 제한, 접기 대기 중인 진단, stderr 버퍼
+typedef struct {
+    unsigned origin_errors;     // 이 스레드에서 발생한 오류 수 (제한에 도달하면 이 스레드의 작업을 멈춤)
+    unsigned final_errors;      // 이 스레드에서 최종 출력한 오류 수 (제한에 도달하면 중단 진단 후 이후 진단을 버림)
+    bool stopped;
+    bool final_done;
+
+    bool pending;               // 접기: 아직 내보내지 않은 마지막 진단
+    Bytes pend_line;
+    DiagRecord pend;
+    uint64_t pend_count;
+    int64_t last_line, last_col;
+
+    Bytes out;                  // stderr가 터미널이 아닐 때 모아 쓰는 버퍼
+    Bytes scratch;              // JSON/횟수 포맷용
+    int tty;                    // stderr가 터미널인지 (-1: 아직 모름)
+} DiagState;
+
+static _Thread_local DiagState t_state = { .tty = -1 };
+
+static const struct {
+    const char* id;
+    const char* severity;
+} CODES[] = {
+    [DIAG_LEX]        = { "E101", "error" },
+    [DIAG_STRING]     = { "E102", "error" },
+    [DIAG_SYNTAX]     = { "E201", "error" },
+    [DIAG_COMPILE]    = { "E301", "error" },
+    [DIAG_UNDEFINED]  = { "E401", "error" },
+    [DIAG_DIV_ZERO]   = { "E402", "error" },
+    [DIAG_CALL_DEPTH] = { "E403", "error" },
+    [DIAG_INDEX]      = { "E404", "error" },
+    [DIAG_ARRAY_LENGTH] = { "E405", "error" },
+    [DIAG_NOMEM]      = { "E901", "error" },
+    [DIAG_INTERNAL]   = { "E902", "error" },
+    [DIAG_TOO_MANY]   = { "E903", "fatal error" },
+};
+
+/**
+ * @brief 바이트 버퍼에 n바이트(+ null) 공간 확보
+ */
+static bool bytes_reserve(Bytes* b, size_t n) {
+    if (b->len + n + 1 <= b->cap) return true;
+    size_t cap = b->cap ? b->cap : 256;
+    while (cap < b->len + n + 1) cap *= 2;
+    char* grown = realloc(b->buf, cap);
+    if (!grown) return false;
+    b->buf = grown; b->cap = cap;
+    return true;
+}
+
+static void bytes_put(Bytes* b, const char* s, size_t n) {
+    if (!bytes_reserve(b, n)) return;
+    memcpy(b->buf + b->len, s, n);
+    b->len += n;
+    b->buf[b->len] = '\0';
+}
+
+static void bytes_printf(Bytes* b, const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    char small[128];
+    int n = vsnprintf(small, sizeof(small), fmt, ap);
+    va_end(ap);
+    if (n > 0) bytes_put(b, small, (size_t)n < sizeof(small) ? (size_t)n : sizeof(small) - 1);
+}
+
+static void bytes_free(Bytes* b) {
+    free(b->buf);
+    memset(b, 0, sizeof(*b));
+}
+
+/**
+ * @brief 캡처 버퍼에 n바이트(+ null)와 레코드 하나의 공간 확보
+ */
+static bool reserve(DiagBuffer* buf, size_t n) {
+    if (buf->nrecs == buf->recs_cap) {
+        size_t cap = buf->recs_cap ? buf->recs_cap * 2 : 16;
+        DiagRecord* grown = realloc(buf->recs, cap * sizeof(*grown));
+        if (!grown) return false;
+        buf->recs = grown; buf->recs_cap = cap;
+    }
+    if (buf->len + n + 1 <= buf->cap) return true;
+    size_t cap = buf->cap ? buf->cap : 256;
+    while (cap < buf->len + n + 1) cap *= 2;
+    char* grown = realloc(buf->text, cap);
+    if (!grown) return false;
+    buf->text = grown; buf->cap = cap;
+    return true;
+}
+
+//========================================
+// 최종 출력 (싱크 콜백 또는 stderr)
+//========================================
+
+static void sink_write(const char* text, size_t len) {
+    DiagState* s = &t_state;
+    if (t_sink.fn) { t_sink.fn(t_sink.user, text, len); return; }
+    if (s->tty < 0) s->tty = isatty(fileno(stderr)) ? 1 : 0;
+    if (s->tty) { fwrite(text, 1, len, stderr); return; }
+
+    // 터미널이 아니면 줄마다 시스템 호출을 하지 않도록 모아서 씀
+    if (s->out.len + len > DIAG_BUFFER_SIZE && s->out.len) {
+        fwrite(s->out.buf, 1, s->out.len, stderr);
+        s->out.len = 0;
+    }
+    if (len > DIAG_BUFFER_SIZE || !bytes_reserve(&s->out, len)) {
+        fwrite(text, 1, len, stderr);
+        return;
+    }
+    bytes_put(&s->out, text, len);
+}
+
+static void json_string(Bytes* b, const char* s, size_t n) {
+    bytes_put(b, "\"", 1);
+    for (size_t i = 0; i < n; ++i) {
+        unsigned char c = (unsigned char)s[i];
+        if (c == '"' || c == '\\') {
+            char esc[2] = { '\\', (char)c };
+            bytes_put(b, esc, 2);
+        } else if (c < 0x20) {
+            bytes_printf(b, "\\u%04x", c);
+        } else {
+            bytes_put(b, s + i, 1);
+        }
+    }
+    bytes_put(b, "\"", 1);
+}
+
+/**
+ * @brief 진단 하나를 설정된 형식으로 출력 (count > 1이면 접힌 진단)
+ * @param line 기본 형식으로 포맷된 한 줄 (rec가 가리키는 구간)
+ */
+static void render(const DiagRecord* rec, const char* line, uint64_t count, int64_t last_line, int64_t last_col) {
+    Bytes* b = &t_state.scratch;
+    b->len = 0;
+    if (active_config()->format == DIAG_FORMAT_JSON) {
+        const char* msg = line + rec->msg_off;
+        size_t msg_len = rec->len - rec->msg_off;
+        if (msg_len && msg[msg_len - 1] == '\n') msg_len--;
+        bytes_put(b, "{", 1);
+        if (rec->code >= 0) {
+            bytes_put(b, "\"file\":", 7);
+            json_string(b, line, rec->file_len);
+            bytes_printf(b, ",\"line\":%" PRId64 ",\"column\":%" PRId64 ",\"severity\":\"%s\",\"code\":\"%s\",",
+                         rec->line, rec->col, rec->code == DIAG_TOO_MANY ? "fatal" : "error", CODES[rec->code].id);
+        } else if (msg_len >= 9 && memcmp(msg, "warning: ", 9) == 0) {
+            bytes_put(b, "\"severity\":\"warning\",", 21);
+            msg += 9; msg_len -= 9;
+        } else {
+            bytes_put(b, "\"severity\":\"error\",", 19);
+        }
+        bytes_put(b, "\"message\":", 10);
+        json_string(b, msg, msg_len);
+        if (rec->code >= 0) bytes_printf(b, ",\"count\":%" PRIu64, count);
+        if (count > 1) bytes_printf(b, ",\"last_line\":%" PRId64 ",\"last_column\":%" PRId64, last_line, last_col);
+        bytes_put(b, "}\n", 2);
+    } else if (count > 1) {
+        size_t n = rec->len && line[rec->len - 1] == '\n' ? rec->len - 1 : rec->len;
+        bytes_put(b, line, n);
+        bytes_printf(b, " (repeated %" PRIu64 " times, last at %" PRId64 ":%" PRId64 ")\n", count, last_line, last_col);
+    } else {
+        sink_write(line, rec->len);
+        return;
+    }
+    if (b->buf) sink_write(b->buf, b->len);
+}
+
+static void release_pending(void) {
+    DiagState* s = &t_state;
+    if (!s->pending) return;
+    s->pending = false;
+    render(&s->pend, s->pend_line.buf, s->pend_count, s->last_line, s->last_col);
+}
+
+static bool same_diag(const DiagRecord* a, const char* la, const DiagRecord* b, const char* lb) {
+    return a->code == b->code && a->file_len == b->file_len && a->len - a->msg_off == b->len - b->msg_off &&
+           memcmp(la, lb, a->file_len) == 0 && memcmp(la + a->msg_off, lb + b->msg_off, a->len - a->msg_off) == 0;
+}
+
+/**
+ * @brief 최종 출력 단계: 오류 수 제한과 접기를 적용 (소스 순서대로 도착한다)
+ */
+static void finish(const DiagRecord* rec, const char* line) {
+    DiagState* s = &t_state;
+    if (rec->code < 0) {
+        release_pending();
+        render(rec, line, 1, 0, 0);
+        return;
+    }
+    if (s->final_done) return;
+
+    if (active_config()->fold && rec->code != DIAG_TOO_MANY) {
+        if (s->pending && same_diag(&s->pend, s->pend_line.buf, rec, line)) {
+            s->pend_count++;
+            s->last_line = rec->line; s->last_col = rec->col;
+        } else {
+            release_pending();
+            s->pend_line.len = 0;
+            bytes_put(&s->pend_line, line, rec->len);
+            if (s->pend_line.len == rec->len) {
+                s->pending = true;
+                s->pend = *rec;
+                s->pend_count = 1;
+            } else {
+                render(rec, line, 1, 0, 0);
+            }
+        }
+    } else {
+        render(rec, line, 1, 0, 0);
+    }
+
+    unsigned max_errors = active_config()->max_errors;
+    if (rec->code != DIAG_TOO_MANY && max_errors && ++s->final_errors >= max_errors) {
+        release_pending();
+        s->final_done = s->stopped = true;
+        char msg[64];
+        snprintf(msg, sizeof(msg), "too many errors (limit %u), stopping", max_errors);
+        char file[1024];
+        size_t n = rec->file_len < sizeof(file) ? rec->file_len : sizeof(file) - 1;
+        memcpy(file, line, n);
+        file[n] = '\0';
+        char text[1200];
+        int len = snprintf(text, sizeof(text), "%s:%" PRId64 ":%" PRId64 ": %s: %s\n",
+                           file, rec->line, rec->col, CODES[DIAG_TOO_MANY].severity, msg);
+        if (len < 0 || (size_t)len >= sizeof(text)) return;
+        DiagRecord fatal = { .len = (uint32_t)len, .file_len = (uint32_t)n, .msg_off = (uint32_t)((size_t)len - strlen(msg) - 1),
+                             .code = DIAG_TOO_MANY, .line = rec->line, .col = rec->col };
+        render(&fatal, text, 1, 0, 0);
+    }
+}
+
+/**
+ * @brief 포맷된 진단 한 줄을 현재 스레드의 대상으로 보냄: 캡처 버퍼 → (제한/접기) → 싱크 콜백 또는 stderr
+ * (캡처 버퍼를 늘리지 못하면 바로 내보낸다)
+ */
+static void deliver(const DiagRecord* rec, const char* line) {
+    DiagBuffer* buf = t_capture;
+    if (buf && reserve(buf, rec->len)) {
+        DiagRecord* r = &buf->recs[buf->nrecs++];
+        *r = *rec;
+        r->off = buf->len;
+        memcpy(buf->text + buf->len, line, rec->len);
+        buf->len += rec->len;
+        buf->text[buf->len] = '\0';
+        return;
+    }
+    finish(rec, line);
+}
+
+/**
+ * @brief printf 형식으로 포맷하여 위치 없는 메시지로 deliver (짧은 메시지는 스택 버퍼 사용)
+ */
+static void deliver_v(const char* fmt, va_list ap) {
+    char small[256];
+    va_list copy;
+    va_copy(copy, ap);
+    int n = vsnprintf(small, sizeof(small), fmt, copy);
+    va_end(copy);
+    if (n < 0) return;
+    DiagRecord rec = { .code = -1 };
+    if ((size_t)n < sizeof(small)) {
+        rec.len = (uint32_t)n;
+        deliver(&rec, small);
+        return;
+    }
+
+    char* big = malloc((size_t)n + 1);
+    if (!big) {
+        rec.len = sizeof(small) - 1;
+        deliver(&rec, small);
+        return;
+    }
+    vsnprintf(big, (size_t)n + 1, fmt, ap);
+    rec.len = (uint32_t)n;
+    deliver(&rec, big);
+    free(big);
+}
+
+// 위치는 64비트: 2 GB를 넘는 스트림 입력에서도 정확한 줄/열을 보고
+#define DIAG_FMT "%s:%" PRId64 ":%" PRId64 ": %s: "
+
+void diag_error(DiagCode code, const char *file, int64_t line, int64_t col, const char *msg) {
+    PROF_COUNT(diagnostics, 1);
+    DiagState* s = &t_state;
+    if (s->stopped) return;
+    unsigned max_errors = active_config()->max_errors;
+    if (max_errors && ++s->origin_errors >= max_errors) s->stopped = true;
+    if (!file) file = "<stdin>";
+
+    char small[256];
+    int head = snprintf(small, sizeof(small), DIAG_FMT, file, line, col, CODES[code].severity);
+    if (head < 0) return;
+    size_t msg_len = strlen(msg);
+    size_t len = (size_t)head + msg_len + 1;
+    if (len > UINT32_MAX) return;
+    char* text = len < sizeof(small) ? small : malloc(len + 1);
+    if (!text) return;
+    if (text != small) snprintf(text, len + 1, DIAG_FMT, file, line, col, CODES[code].severity);
+    memcpy(text + head, msg, msg_len);
+    text[len - 1] = '\n';
+    text[len] = '\0';
+
+    DiagRecord rec = { .len = (uint32_t)len, .file_len = (uint32_t)strlen(file), .msg_off = (uint32_t)head,
+                       .code = (int16_t)code, .line = line, .col = col };
+    deliver(&rec, text);
+    if (text != small) free(text);
+}
+
+/**
+ * @brief 위치가 없는 메시지 (파일을 열 수 없음, 메모리 부족 등)를 진단과 같은 대상으로 출력
+ */
+void diag_message(const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    deliver_v(fmt, ap);
+    va_end(ap);
+}
+
+/**
+ * @brief 다른 스레드(또는 앞서 캡처한 구간)의 진단 [begin, end)를 이 스레드의 대상(캡처 버퍼, 싱크 또는 stderr)으로 넘김
+ */
+void diag_forward(const DiagBuffer* buf, size_t begin, size_t end) {
+    size_t lo = 0, hi = buf->nrecs;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (buf->recs[mid].off < begin) lo = mid + 1;
+        else hi = mid;
+    }
+    for (size_t i = lo; i < buf->nrecs && buf->recs[i].off < end; ++i) {
+        deliver(&buf->recs[i], buf->text + buf->recs[i].off);
+    }
+}
+
+void diag_configure(const DiagConfig* config) {
+    g_config = *config;
+}
+
+void diag_begin_run(void) {
+    DiagState* s = &t_state;
+    release_pending();
+    s->origin_errors = s->final_errors = 0;
+    s->stopped = s->final_done = false;
+}
+
+bool diag_stopped(void) {
+    return t_state.stopped;
+}
+
+void diag_sync(void) {
+    DiagState* s = &t_state;
+    release_pending();
+    if (s->out.len) fwrite(s->out.buf, 1, s->out.len, stderr);
+    bytes_free(&s->out);
+    bytes_free(&s->pend_line);
+    bytes_free(&s->scratch);
+}
+
+DiagSink diag_set_sink(DiagSink sink) {
+    diag_sync();
+    DiagSink prev = t_sink;
+    t_sink = sink;
+    return prev;
+}
+
+DiagBuffer* diag_capture(DiagBuffer* buf) {
+    DiagBuffer* prev = t_capture;
+    t_capture = buf;
+    return prev;
+}
+
+void diag_truncate(DiagBuffer* buf, size_t len) {
+    buf->len = len;
+    if (buf->text) buf->text[len] = '\0';
+    while (buf->nrecs > 0 && buf->recs[buf->nrecs - 1].off >= len) buf->nrecs--;
+}
+
+void diag_flush(DiagBuffer* buf, FILE* fp) {
+    if (fp && buf->len) fwrite(buf->text, 1, buf->len, fp);
+    free(buf->text);
+    free(buf->recs);
+    memset(buf, 0, sizeof(*buf));
 }
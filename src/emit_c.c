@@ -0,0 +1,783 @@
+//========================================
+// System Includes
+//========================================
+#include "emit_c.h"
+#include "arena.h"
+#include "bytecode.h"
+#include "diag.h"
+#include "lexer.h"
+#include "parser.h"
+#include "vec.h"
+#include "version.h"
+#include "vm.h"
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+//========================================
+// Text Buffer (생성 중인 C 코드)
+// 변수/임시 변수 선언은 본문을 번역한 뒤에야 알 수 있으므로 본문을 먼저 모은다.
+//========================================
+typedef struct {
+    char* data;
+    size_t len, cap;
+    bool nomem;
+} Text;
+
+static bool tx_reserve(Text* t, size_t extra) {
+    if (t->nomem) return false;
+    if (t->len + extra + 1 <= t->cap) return true;
+    size_t cap = t->cap ? t->cap : 4096;
+    while (cap < t->len + extra + 1) cap *= 2;
+    char* grown = realloc(t->data, cap);
+    if (!grown) { t->nomem = true; return false; }
+    t->data = grown;
+    t->cap = cap;
+    return true;
+}
+
+static void tx_printf(Text* t, const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    va_list copy;
+    va_copy(copy, ap);
+    int n = vsnprintf(NULL, 0, fmt, copy);
+    va_end(copy);
+    if (n >= 0 && tx_reserve(t, (size_t)n)) {
+        vsnprintf(t->data + t->len, (size_t)n + 1, fmt, ap);
+        t->len += (size_t)n;
+    }
+    va_end(ap);
+}
+
+/**
+ * @brief 임의의 바이트열을 C 문자열 리터럴로 씀
+ * 출력 가능한 ASCII만 그대로 두고 나머지는 3자리 8진 이스케이프 (뒤따르는 숫자와 섞이지 않음).
+ * '?'도 이스케이프하여 트라이그래프로 해석되지 않게 한다.
+ */
+static void tx_c_string(Text* t, const char* s, size_t len) {
+    if (!tx_reserve(t, len * 4 + 2)) return;
+    char* p = t->data + t->len;
+    *p++ = '"';
+    for (size_t i = 0; i < len; ++i) {
+        unsigned char c = (unsigned char)s[i];
+        if (c >= 0x20 && c < 0x7F && c != '"' && c != '\\' && c != '?') {
+            *p++ = (char)c;
+        } else {
+            *p++ = '\\';
+            *p++ = (char)('0' + (c >> 6));
+            *p++ = (char)('0' + ((c >> 3) & 7));
+            *p++ = (char)('0' + (c & 7));
+        }
+    }
+    *p++ = '"';
+    t->len = (size_t)(p - t->data);
+}
+
+/**
+ * @brief int32 상수를 C 식으로 (INT32_MIN은 리터럴로 쓸 수 없으므로 식으로)
+ */
+static void tx_int(Text* t, int32_t v) {
+    if (v == INT32_MIN) tx_printf(t, "(-2147483647 - 1)");
+    else tx_printf(t, "%" PRId32, v);
+}
+
+//========================================
+// Emitter State
+//========================================
+// 생성 코드를 이 문장 수마다 별도 함수로 나눔. C 컴파일러의 최적화 비용은 함수 크기에 대해
+// 선형보다 빠르게 늘어나므로 (한 함수에 3만 문장이면 수 분), 함수 크기를 묶어 두어 전체 빌드 시간을 선형으로 유지한다.
+#ifndef EMIT_C_PART_STMTS
+#define EMIT_C_PART_STMTS 256
+#endif
+
+typedef struct {
+    Text funcs;         // 완성된 dh_partN 함수들
+    Text part;          // 작성 중인 함수 본문
+    int part_temps;     // 작성 중인 함수의 임시 변수 수 (최대 스택 깊이)
+    size_t part_stmts;
+    size_t nparts;
+    SymTab* st;
+    VM vm;              // 런타임 오류 문구를 vm_report로 미리 포맷하는 데만 사용
+    uint8_t* used;      // 본문이 참조하는 슬롯 (USE_VAR / USE_ARRAY: 선언할 변수와 배열)
+    size_t used_cap;
+    int vec_temps;      // 배열 값 임시 변수 dh_v[] 수 (최상위 문장에만 있으므로 함수 사이에 공유)
+    uint64_t labels;    // 레이블 번호 (chunk마다 명령어 수만큼 할당: L<labels + pc>)
+    Text subs;          // 완성된 하위 루틴 함수 dh_sN들
+    Text body;          // 작성 중인 하위 루틴 본문
+    size_t nsubs_done;  // 번역한 하위 루틴 수
+    bool* called;       // 다른 함수에서 부르는 하위 루틴 (아니면 main에서 unused 경고를 막음)
+    size_t called_cap;
+    bool calls;         // 호출 깊이 카운터(dh_depth)가 필요한지
+} Emitter;
+
+static bool em_nomem(const Emitter* em) {
+    return em->funcs.nomem || em->part.nomem || em->subs.nomem || em->body.nomem;
+}
+
+static bool grow_called(Emitter* em, size_t n) {
+    if (n <= em->called_cap) return true;
+    size_t cap = em->called_cap ? em->called_cap : 16;
+    while (cap < n) cap *= 2;
+    bool* grown = realloc(em->called, cap * sizeof(bool));
+    if (!grown) return false;
+    memset(grown + em->called_cap, 0, (cap - em->called_cap) * sizeof(bool));
+    em->called = grown;
+    em->called_cap = cap;
+    return true;
+}
+
+/**
+ * @brief 작성 중인 본문을 임시 변수 선언과 함께 dh_partN 함수로 마무리
+ */
+static void close_part(Emitter* em) {
+    if (em->part_stmts == 0) return;
+    Text* f = &em->funcs;
+    tx_printf(f, "static void dh_part%zu(void) {\n", em->nparts++);
+    for (int k = 0; k < em->part_temps; ++k) tx_printf(f, "%s t%d = 0", k == 0 ? "    int32_t" : ",", k);
+    if (em->part_temps > 0) tx_printf(f, ";\n");
+    if (tx_reserve(f, em->part.len)) {
+        memcpy(f->data + f->len, em->part.data, em->part.len);
+        f->len += em->part.len;
+    }
+    tx_printf(f, "}\n\n");
+    em->part.len = 0;
+    em->part_temps = 0;
+    em->part_stmts = 0;
+}
+
+/**
+ * @brief 새 문장을 시작 (현재 함수가 가득 찼고 나눌 수 있는 자리면 먼저 마무리)
+ * @return 새 함수를 시작했으면 true
+ */
+static bool begin_stmt(Emitter* em, bool can_split) {
+    bool split = can_split && em->part_stmts >= EMIT_C_PART_STMTS;
+    if (split) close_part(em);
+    em->part_stmts++;
+    return split;
+}
+
+enum { USE_VAR = 1, USE_ARRAY = 2 };
+
+static bool mark_slot(Emitter* em, int32_t slot, uint8_t use) {
+    if ((size_t)slot >= em->used_cap) {
+        size_t cap = em->used_cap ? em->used_cap : 64;
+        while (cap <= (size_t)slot) cap *= 2;
+        uint8_t* grown = realloc(em->used, cap);
+        if (!grown) { em->part.nomem = true; return false; }
+        memset(grown + em->used_cap, 0, cap - em->used_cap);
+        em->used = grown;
+        em->used_cap = cap;
+    }
+    em->used[slot] |= use;
+    return true;
+}
+
+/**
+ * @brief 이미 포맷된 진단 텍스트를 출력하는 문장을 본문에 추가
+ */
+static void emit_diag(Emitter* em, const char* text, size_t len) {
+    begin_stmt(em, true);
+    tx_printf(&em->part, "    dh_diag(");
+    tx_c_string(&em->part, text, len);
+    tx_printf(&em->part, ");\n");
+}
+
+/**
+ * @brief 런타임 오류 경로: 인터프리터와 같은 진단을 출력하고 재개 지점 레이블로
+ */
+static void emit_fail(Emitter* em, Text* t, const StmtInfo* at, VmError err, int32_t slot, uint64_t label) {
+    DiagBuffer msg = {0};
+    DiagBuffer* prev = diag_capture(&msg);
+    (void)vm_report(&em->vm, at, err, slot);
+    diag_capture(prev);
+    if (!msg.text) { t->nomem = true; return; }
+
+    tx_printf(t, "{ dh_diag(");
+    tx_c_string(t, msg.text, msg.len);
+    tx_printf(t, "); goto L%" PRIu64 "; }\n", label);
+    diag_flush(&msg, NULL);
+}
+
+//========================================
+// Control Flow (goto 레이블과 함수 나누기)
+// 점프와 오류 경로는 모두 OP_STMT/OP_HALT로 가므로 그 자리에만 레이블을 둔다.
+// goto는 함수를 넘을 수 없으므로, 어떤 점프가 가로지르는 문장 경계에서는 함수를 나누지 않는다
+// (블록 전체와 REPEAT 카운터 임시 변수는 한 함수 안에 머문다).
+// 하위 루틴 본문은 별도 함수이며 그 안의 점프는 본문 안에서 끝난다 (자기 꼬리 호출은 본문 첫 문장으로).
+//========================================
+enum {
+    LBL_FORWARD = 1,    // 앞쪽에서 오는 goto의 목적지
+    LBL_BACK = 2,       // 뒤쪽(또는 자기 자신)에서 오는 goto의 목적지
+    NO_SPLIT = 4,       // 이 문장 앞에서 함수를 나눌 수 없음
+};
+
+/**
+ * @brief 원소별 연산이 실패할 수 있는지 (길이가 다를 수 있거나 0으로 나눌 수 있음)
+ */
+static bool vec_fallible(int32_t arg) {
+    int op = arg >> 2;
+    return (arg & 3) == VEC_BOTH || op == EXPR_OP_DIV || op == EXPR_OP_MOD;
+}
+
+static void add_edge(uint8_t* flags, int* cover, size_t src, size_t dst) {
+    if (dst > src) {
+        flags[dst] |= LBL_FORWARD;
+        cover[src + 1]++; cover[dst]--;         // (src, dst) 안에서 나누면 안 됨
+    } else {
+        flags[dst] |= LBL_BACK;
+        cover[dst + 1]++; cover[src + 1]--;     // (dst, src] 안에서 나누면 안 됨
+    }
+}
+
+/**
+ * @brief ch->entry 이후 명령어 위치마다 레이블 필요 여부와 함수를 나눌 수 있는지 계산 (메모리 부족이면 NULL)
+ * 그 앞(이전 묶음에서 번역한 하위 루틴)으로 가는 점프는 없다.
+ */
+static uint8_t* plan_flow(const Chunk* ch) {
+    uint8_t* flags = calloc(ch->count + 1, 1);
+    int* cover = calloc(ch->count + 2, sizeof(int));
+    if (!flags || !cover) {
+        free(flags);
+        free(cover);
+        return NULL;
+    }
+    const StmtInfo* cur = NULL;
+    size_t body = 0;    // pc 이후에 끝나는 첫 하위 루틴
+    for (size_t pc = ch->entry; pc < ch->count; ++pc) {
+        Instr in = ch->code[pc];
+        while (body < ch->nsubs && ch->subs[body].end <= pc) body++;
+        switch (in.op) {
+            case OP_STMT: cur = &ch->stmts[in.arg]; break;
+            case OP_CALL:
+                // 본문 안의 호출은 깊이 초과 시 함수에서 돌아가므로 goto가 없음
+                if (body < ch->nsubs && ch->subs[body].entry <= pc) break;
+                add_edge(flags, cover, pc, cur->end);
+                break;
+            case OP_LOAD_SLOT: case OP_DIV: case OP_MOD:
+            case OP_ARRAY_NEW: case OP_LOAD_ELEM: case OP_STORE_ELEM:
+                add_edge(flags, cover, pc, cur->end);
+                break;
+            case OP_VEC:
+                if (vec_fallible(in.arg)) add_edge(flags, cover, pc, cur->end);
+                break;
+            case OP_JUMP: case OP_JUMP_FALSE: case OP_REPEAT: case OP_LOOP:
+                add_edge(flags, cover, pc, (size_t)in.arg);
+                break;
+            case OP_TAIL_CALL: {
+                // 자기 자신이면 본문 첫 문장으로 돌아가는 goto (pc가 속한 하위 루틴은 entry가 pc 이하인 마지막 것)
+                const Sub* sub = &ch->subs[in.arg];
+                if (sub->entry <= pc && pc < sub->end) add_edge(flags, cover, pc, sub->entry);
+                break;
+            }
+            default: break;
+        }
+    }
+    int depth = 0;
+    for (size_t pc = 0; pc <= ch->count; ++pc) {
+        depth += cover[pc];
+        if (depth > 0) flags[pc] |= NO_SPLIT;
+    }
+    free(cover);
+    return flags;
+}
+
+/**
+ * @brief 문장 경계가 아닌 명령어 하나를 C 문장으로 번역
+ * @param self 번역 중인 하위 루틴 번호 (최상위 문장이면 -1)
+ * @param sp 스택 깊이 (명령어의 효과를 반영하여 갱신)
+ */
+static void emit_op(Emitter* em, Text* t, const Chunk* ch, Instr in, const StmtInfo* cur, uint64_t base,
+                    long self, int* sp) {
+    switch ((OpCode)in.op) {
+        case OP_PUSH_CONST:
+            tx_printf(t, "    t%d = ", (*sp)++);
+            tx_int(t, in.arg);
+            tx_printf(t, ";\n");
+            break;
+
+        case OP_LOAD_SLOT:
+            if (!mark_slot(em, in.arg, USE_VAR)) break;
+            tx_printf(t, "    if (!d%" PRId32 ") ", in.arg);
+            emit_fail(em, t, cur, VM_ERR_UNDEFINED, in.arg, base + cur->end);
+            tx_printf(t, "    t%d = v%" PRId32 ";\n", (*sp)++, in.arg);
+            break;
+
+        case OP_ADD: case OP_SUB: case OP_MUL: {
+            static const char* const fn[] = { "dh_add", "dh_sub", "dh_mul" };
+            int top = --*sp;
+            tx_printf(t, "    t%d = %s(t%d, t%d);\n", top - 1, fn[in.op - OP_ADD], top - 1, top);
+            break;
+        }
+
+        case OP_DIV: case OP_MOD: {
+            int top = --*sp;
+            tx_printf(t, "    if (t%d == 0) ", top);
+            emit_fail(em, t, cur, in.op == OP_DIV ? VM_ERR_DIV_ZERO : VM_ERR_MOD_ZERO, 0, base + cur->end);
+            tx_printf(t, "    t%d = %s(t%d, t%d);\n", top - 1, in.op == OP_DIV ? "dh_div" : "dh_mod", top - 1, top);
+            break;
+        }
+
+        case OP_PRINT_INT:
+            tx_printf(t, "    dh_print_int(t%d);\n", --*sp);
+            break;
+
+        case OP_PRINT_STR: {
+            StrRef r = ch->strs[in.arg];
+            tx_printf(t, "    dh_print_str(");
+            tx_c_string(t, ch->pool + r.off, r.len);
+            tx_printf(t, ", %" PRIu32 ");\n", r.len);
+            break;
+        }
+
+        case OP_STORE_SLOT:
+            if (!mark_slot(em, in.arg, USE_VAR)) break;
+            tx_printf(t, "    v%" PRId32 " = t%d; d%" PRId32 " = 1;\n", in.arg, --*sp, in.arg);
+            break;
+
+        case OP_JUMP:
+            tx_printf(t, "    goto L%" PRIu64 ";\n", base + (uint64_t)in.arg);
+            break;
+
+        case OP_JUMP_FALSE:
+            tx_printf(t, "    if (!t%d) goto L%" PRIu64 ";\n", --*sp, base + (uint64_t)in.arg);
+            break;
+
+        case OP_REPEAT:
+            tx_printf(t, "    if (t%d <= 0) goto L%" PRIu64 ";\n", *sp - 1, base + (uint64_t)in.arg);
+            break;
+
+        case OP_LOOP:
+            tx_printf(t, "    if (--t%d > 0) goto L%" PRIu64 ";\n", --*sp, base + (uint64_t)in.arg);
+            break;
+
+        case OP_LOAD_LOCAL:
+            tx_printf(t, "    t%d = l%" PRId32 ";\n", (*sp)++, in.arg);
+            break;
+
+        case OP_STORE_LOCAL:
+            tx_printf(t, "    l%" PRId32 " = t%d;\n", in.arg, --*sp);
+            break;
+
+        case OP_CALL:
+        case OP_TAIL_CALL: {
+            const Sub* sub = &ch->subs[in.arg];
+            int args = *sp - (int)sub->nparams;
+            if (in.op == OP_TAIL_CALL && in.arg == self) {
+                // 자기 꼬리 호출: 매개변수를 바꾸고 나머지 지역 변수를 비운 뒤 본문 처음으로
+                for (uint32_t i = 0; i < sub->nlocals; ++i) {
+                    if (i < sub->nparams) tx_printf(t, "    l%" PRIu32 " = t%d;\n", i, args + (int)i);
+                    else tx_printf(t, "    l%" PRIu32 " = 0;\n", i);
+                }
+                tx_printf(t, "    goto L%" PRIu64 ";\n", base + sub->entry);
+                break;
+            }
+            if ((size_t)in.arg != (size_t)self && (size_t)in.arg < em->called_cap) em->called[in.arg] = true;
+            if (in.op == OP_TAIL_CALL) {
+                tx_printf(t, "    return dh_s%" PRId32 "(", in.arg);
+            } else {
+                // 깊이 초과는 dh_unwind를 세우고 본문마다 바로 돌아가며, 최상위에서 호출한 문장이 진단하고 건너뜀
+                em->calls = true;
+                if (self >= 0) tx_printf(t, "    if (dh_depth >= %d) { dh_unwind = 1; return 0; }\n", VM_MAX_CALL_DEPTH);
+                tx_printf(t, "    dh_depth++; t%d = dh_s%" PRId32 "(", args, in.arg);
+            }
+            for (uint32_t i = 0; i < sub->nparams; ++i) tx_printf(t, "%st%d", i ? ", " : "", args + (int)i);
+            if (in.op == OP_TAIL_CALL) {
+                tx_printf(t, ");\n");
+            } else if (self >= 0) {
+                tx_printf(t, "); dh_depth--;\n    if (dh_unwind) return 0;\n");
+            } else {
+                tx_printf(t, "); dh_depth--;\n    if (dh_unwind) { dh_unwind = 0; ");
+                emit_fail(em, t, cur, VM_ERR_CALL_DEPTH, 0, base + cur->end);
+                tx_printf(t, "    }\n");
+            }
+            *sp = args + 1;
+            break;
+        }
+
+        case OP_RETURN:
+            tx_printf(t, "    return t%d;\n", *sp - 1);
+            break;
+
+        case OP_ARRAY_NEW: {
+            if (!mark_slot(em, in.arg, USE_ARRAY)) break;
+            int top = --*sp;
+            tx_printf(t, "    if (t%d < 0) ", top);
+            emit_fail(em, t, cur, VM_ERR_ARRAY_LENGTH, in.arg, base + cur->end);
+            tx_printf(t, "    dh_array_new(&a%" PRId32 ", (size_t)t%d);\n", in.arg, top);
+            break;
+        }
+
+        case OP_LOAD_ELEM:
+        case OP_STORE_ELEM: {
+            // 음수 첨자는 부호 없는 값으로 보면 길이보다 크다
+            if (!mark_slot(em, in.arg, USE_ARRAY)) break;
+            int index = in.op == OP_LOAD_ELEM ? *sp - 1 : (*sp -= 2);
+            tx_printf(t, "    if ((uint32_t)t%d >= a%" PRId32 ".len) ", index, in.arg);
+            emit_fail(em, t, cur, VM_ERR_INDEX, in.arg, base + cur->end);
+            if (in.op == OP_LOAD_ELEM) tx_printf(t, "    t%d = a%" PRId32 ".data[t%d];\n", index, in.arg, index);
+            else tx_printf(t, "    a%" PRId32 ".data[t%d] = t%d;\n", in.arg, index, index + 1);
+            break;
+        }
+
+        case OP_LOAD_ARRAY:
+            if (!mark_slot(em, in.arg, USE_ARRAY)) break;
+            tx_printf(t, "    dh_v[%d].data = a%" PRId32 ".data; dh_v[%d].len = a%" PRId32 ".len;\n",
+                      *sp, in.arg, *sp, in.arg);
+            if (++*sp > em->vec_temps) em->vec_temps = *sp;
+            break;
+
+        case OP_VEC: {
+            static const char* const fn[] = { "dh_vadd", "dh_vsub", "dh_vmul", "dh_vdiv", "dh_vmod" };
+            int op = in.arg >> 2, shape = in.arg & 3;
+            int top = --*sp;
+            if (shape == VEC_BOTH) {
+                tx_printf(t, "    if (dh_v[%d].len != dh_v[%d].len) ", top - 1, top);
+                emit_fail(em, t, cur, VM_ERR_LENGTH_MISMATCH, 0, base + cur->end);
+            }
+            if (op == EXPR_OP_DIV || op == EXPR_OP_MOD) {
+                if (shape & VEC_RIGHT) tx_printf(t, "    if (dh_has_zero(&dh_v[%d])) ", top);
+                else tx_printf(t, "    if (t%d == 0) ", top);
+                emit_fail(em, t, cur, op == EXPR_OP_DIV ? VM_ERR_DIV_ZERO : VM_ERR_MOD_ZERO, 0, base + cur->end);
+            }
+            // 결과는 왼쪽 칸에 (왼쪽이 배열 값이면 그 칸이 피연산자이기도 함). 오른쪽이 수이면 r은 쓰지 않는다
+            tx_printf(t, "    %s(&dh_v[%d], %d, t%d, &dh_v[%d], t%d);\n", fn[op], top - 1, shape, top - 1,
+                      shape & VEC_RIGHT ? top : top - 1, top);
+            break;
+        }
+
+        case OP_STORE_ARRAY:
+            if (!mark_slot(em, in.arg, USE_ARRAY)) break;
+            tx_printf(t, "    dh_array_copy(&a%" PRId32 ", &dh_v[%d]);\n", in.arg, --*sp);
+            break;
+
+        case OP_FILL_ARRAY:
+            if (!mark_slot(em, in.arg, USE_ARRAY)) break;
+            tx_printf(t, "    dh_array_fill(&a%" PRId32 ", t%d);\n", in.arg, --*sp);
+            break;
+
+        case OP_PRINT_ARRAY:
+            tx_printf(t, "    dh_print_ints(&dh_v[%d]);\n", --*sp);
+            break;
+
+        case OP_STMT: case OP_HALT: case OP_COUNT:
+            break;
+    }
+}
+
+/**
+ * @brief 하위 루틴 k의 본문을 static int32_t dh_s<k>(매개변수...) 함수로 번역
+ * 지역 변수는 l<i>, 매개변수가 아닌 지역 변수는 0으로 시작한다.
+ */
+static void emit_sub(Emitter* em, const Chunk* ch, const uint8_t* flow, uint64_t base, size_t k) {
+    const Sub* sub = &ch->subs[k];
+    Text* body = &em->body;
+    body->len = 0;
+    const StmtInfo* cur = NULL;
+    int sp = 0, temps = 0;
+
+    for (size_t pc = sub->entry; pc < sub->end && !body->nomem; ++pc) {
+        Instr in = ch->code[pc];
+        if (in.op == OP_STMT) {
+            if (flow[pc] & (LBL_FORWARD | LBL_BACK)) tx_printf(body, "L%" PRIu64 ":;\n", base + pc);
+            cur = &ch->stmts[in.arg];
+            sp = (int)cur->base;
+            tx_printf(body, "    /* %" PRId64 ":%" PRId64 " */\n", cur->line, cur->col);
+        } else {
+            emit_op(em, body, ch, in, cur, base, (long)k, &sp);
+        }
+        if (sp > temps) temps = sp;
+    }
+
+    Text* f = &em->subs;
+    tx_printf(f, "static int32_t dh_s%zu(", k);
+    for (uint32_t i = 0; i < sub->nparams; ++i) tx_printf(f, "%sint32_t l%" PRIu32, i ? ", " : "", i);
+    tx_printf(f, "%s) {\n", sub->nparams ? "" : "void");
+    for (uint32_t i = sub->nparams; i < sub->nlocals; ++i) {
+        tx_printf(f, "%s l%" PRIu32 " = 0", i == sub->nparams ? "    int32_t" : ",", i);
+    }
+    if (sub->nlocals > sub->nparams) tx_printf(f, ";\n");
+    for (int i = 0; i < temps; ++i) tx_printf(f, "%s t%d = 0", i == 0 ? "    int32_t" : ",", i);
+    if (temps > 0) tx_printf(f, ";\n");
+    // 읽지 않는 매개변수/지역 변수 경고 방지
+    for (uint32_t i = 0; i < sub->nlocals; ++i) tx_printf(f, "%s(void)l%" PRIu32 ";", i ? " " : "    ", i);
+    if (sub->nlocals > 0) tx_printf(f, "\n");
+    if (tx_reserve(f, body->len)) {
+        memcpy(f->data + f->len, body->data, body->len);
+        f->len += body->len;
+    }
+    tx_printf(f, "}\n\n");
+    if (body->nomem) f->nomem = true;
+}
+
+/**
+ * @brief chunk의 명령어를 C 문장으로 번역하여 본문에 덧붙임
+ * 스택 깊이는 컴파일 시 정해지므로 스택 칸 k는 임시 변수 tk가 된다 (REPEAT 카운터는 문장 base 아래 칸).
+ * 점프는 goto가 되고, 오류가 난 문장은 goto로 재개 지점에 가서 다음 문장부터 이어간다.
+ * 새로 정의된 하위 루틴은 각자의 함수가 되고, 최상위 문장은 그 본문을 건너뛰며 번역한다.
+ */
+static void emit_chunk(Emitter* em, const Chunk* ch) {
+    uint8_t* flow = plan_flow(ch);
+    if (!flow || !grow_called(em, ch->nsubs)) { free(flow); em->part.nomem = true; return; }
+    const StmtInfo* cur = NULL;
+    uint64_t base = em->labels;
+    em->labels += ch->count;
+    int sp = 0;
+
+    size_t next = em->nsubs_done;   // 다음에 건너뛸 본문
+    for (; em->nsubs_done < ch->nsubs && !em_nomem(em); ++em->nsubs_done) emit_sub(em, ch, flow, base, em->nsubs_done);
+
+    for (size_t pc = ch->entry; pc < ch->count && !em_nomem(em); ++pc) {
+        if (next < ch->nsubs && pc == ch->subs[next].entry) {
+            pc = ch->subs[next++].end - 1;
+            continue;
+        }
+        Text* t = &em->part;
+        Instr in = ch->code[pc];
+        if (in.op == OP_STMT || in.op == OP_HALT) {
+            // 앞에서 오는 goto의 레이블은 이전 함수 끝에 (끝에 떨어지면 다음 함수가 이어 실행)
+            bool full = in.op == OP_STMT && em->part_stmts >= EMIT_C_PART_STMTS && !(flow[pc] & NO_SPLIT);
+            if (full && (flow[pc] & LBL_FORWARD)) tx_printf(t, "L%" PRIu64 ":;\n", base + pc);
+            bool split = in.op == OP_STMT && begin_stmt(em, !(flow[pc] & NO_SPLIT));
+            t = &em->part;
+            if (split ? (flow[pc] & LBL_BACK) : (flow[pc] & (LBL_FORWARD | LBL_BACK))) {
+                tx_printf(t, "L%" PRIu64 ":;\n", base + pc);
+            }
+            if (in.op == OP_HALT) continue;
+            cur = &ch->stmts[in.arg];
+            sp = (int)cur->base;
+            tx_printf(t, "    /* %" PRId64 ":%" PRId64 " */\n", cur->line, cur->col);
+        } else {
+            emit_op(em, t, ch, in, cur, base, -1, &sp);
+        }
+        if (sp > em->part_temps) em->part_temps = sp;
+    }
+    free(flow);
+}
+
+//========================================
+// Program Translation
+//========================================
+
+/**
+ * @brief 한 문장씩 파싱 → 컴파일 → 번역 (기본 모드, 블록은 END까지 모아서 번역)
+ * 구문/컴파일 진단은 그 문장 자리에 넣어 인터프리터와 같은 순서로 출력되게 한다.
+ */
+static bool emit_streaming(Emitter* em, Lexer* lx, Chunk* ch) {
+    Arena arena; arena_init(&arena, 0);
+    Parser ps; ps_init(&ps, lx, em->st, &arena);
+    Stmt s;
+
+    for (;;) {
+        DiagBuffer diags = {0};
+        DiagBuffer* prev = diag_capture(&diags);
+        bool more = ps_next_stmt(&ps, &s);
+        bool compiled = false;
+        if (more) {
+            if (!bc_in_block(ch)) bc_reset_stmts(ch);
+            compiled = bc_compile_stmt(ch, &s, em->st, lx->filename) && !bc_in_block(ch) && bc_finish(ch);
+            arena_reset(&arena);
+        } else {
+            bc_end_blocks(ch, lx->filename);
+        }
+        diag_capture(prev);
+
+        if (diags.len) {
+            emit_diag(em, diags.text, diags.len);
+            diag_forward(&diags, 0, diags.len);
+        }
+        diag_flush(&diags, NULL);
+        if (!more || em_nomem(em)) break;
+        if (compiled) emit_chunk(em, ch);
+    }
+
+    ps_free(&ps);
+    arena_free(&arena);
+    return !em_nomem(em);
+}
+
+/**
+ * @brief 전체 프로그램을 컴파일(-O이면 최적화)한 뒤 번역. 진단은 모두 실행보다 먼저 나온다.
+ */
+static bool emit_whole(Emitter* em, Lexer* lx, Chunk* ch, const RunOptions* opts) {
+    DiagBuffer diags = {0};
+    DiagBuffer* prev = diag_capture(&diags);
+    bool ok = compile_whole(lx, em->st, ch, opts);
+    diag_capture(prev);
+
+    if (diags.len) {
+        emit_diag(em, diags.text, diags.len);
+        diag_forward(&diags, 0, diags.len);
+    }
+    diag_flush(&diags, NULL);
+    if (ok) emit_chunk(em, ch);
+    return ok && !em_nomem(em);
+}
+
+// 생성 코드의 런타임: 정수 연산 규칙은 arith.h와 같다
+static const char PRELUDE[] =
+    "#include <inttypes.h>\n"
+    "#include <stdint.h>\n"
+    "#include <stdio.h>\n"
+    "\n"
+    "static inline int32_t dh_add(int32_t a, int32_t b) { return (int32_t)((uint32_t)a + (uint32_t)b); }\n"
+    "static inline int32_t dh_sub(int32_t a, int32_t b) { return (int32_t)((uint32_t)a - (uint32_t)b); }\n"
+    "static inline int32_t dh_mul(int32_t a, int32_t b) { return (int32_t)((uint32_t)a * (uint32_t)b); }\n"
+    "static inline int32_t dh_div(int32_t a, int32_t b) { return b == -1 ? dh_sub(0, a) : a / b; }\n"
+    "static inline int32_t dh_mod(int32_t a, int32_t b) { return b == -1 ? 0 : a % b; }\n"
+    "\n"
+    "static inline void dh_print_int(int32_t v) { printf(\"%\" PRId32 \"\\n\", v); }\n"
+    "static inline void dh_print_str(const char* s, size_t n) { fwrite(s, 1, n, stdout); putchar('\\n'); }\n"
+    "static inline void dh_diag(const char* text) { fputs(text, stderr); }\n"
+    "\n";
+
+// 배열을 쓰는 프로그램에만 붙는 런타임: 배열 a<slot>과 스택 칸별 배열 값 dh_v[k] (데이터는 배열이나 칸의 버퍼)
+// 원소별 연산은 단순한 반복문이며 벡터화는 C 컴파일러에 맡긴다. shape는 vec.h의 VEC_LEFT/RIGHT/BOTH.
+static const char ARRAY_PRELUDE[] =
+    "#include <stdlib.h>\n"
+    "#include <string.h>\n"
+    "\n"
+    "typedef struct { int32_t* data; size_t len, cap; } dh_arr;\n"
+    "typedef struct { const int32_t* data; size_t len; int32_t* buf; size_t cap; } dh_vec;\n"
+    "\n"
+    "static inline int32_t* dh_alloc(size_t n) {\n"
+    "    int32_t* p = malloc((n ? n : 1) * sizeof(int32_t));\n"
+    "    if (!p) { fflush(stdout); fputs(\"Out of memory\\n\", stderr); exit(1); }\n"
+    "    return p;\n"
+    "}\n"
+    "static inline void dh_array_reserve(dh_arr* a, size_t n) {\n"
+    "    if (n <= a->cap && a->data) return;\n"
+    "    free(a->data);\n"
+    "    a->data = dh_alloc(n);\n"
+    "    a->cap = n;\n"
+    "}\n"
+    "static inline void dh_array_new(dh_arr* a, size_t n) {\n"
+    "    dh_array_reserve(a, n);\n"
+    "    memset(a->data, 0, n * sizeof(int32_t));\n"
+    "    a->len = n;\n"
+    "}\n"
+    "static inline void dh_array_copy(dh_arr* a, const dh_vec* v) {\n"
+    "    if (a->data == v->data) return;\n"
+    "    dh_array_reserve(a, v->len);\n"
+    "    if (v->len) memcpy(a->data, v->data, v->len * sizeof(int32_t));\n"
+    "    a->len = v->len;\n"
+    "}\n"
+    "static inline void dh_array_fill(dh_arr* a, int32_t x) { for (size_t i = 0; i < a->len; ++i) a->data[i] = x; }\n"
+    "static inline int dh_has_zero(const dh_vec* v) {\n"
+    "    for (size_t i = 0; i < v->len; ++i) if (v->data[i] == 0) return 1;\n"
+    "    return 0;\n"
+    "}\n"
+    "static inline void dh_print_ints(const dh_vec* v) {\n"
+    "    for (size_t i = 0; i < v->len; ++i) printf(i ? \" %\" PRId32 : \"%\" PRId32, v->data[i]);\n"
+    "    putchar('\\n');\n"
+    "}\n"
+    "\n"
+    "#define DH_VEC_OP(name, f) \\\n"
+    "static inline void name(dh_vec* d, int shape, int32_t x, const dh_vec* r, int32_t y) { \\\n"
+    "    size_t n = shape & 1 ? d->len : r->len; \\\n"
+    "    int32_t* out = d->buf && d->cap >= n ? d->buf : dh_alloc(n); \\\n"
+    "    const int32_t* a = d->data; const int32_t* b = r->data; \\\n"
+    "    if (shape == 3) for (size_t i = 0; i < n; ++i) out[i] = f(a[i], b[i]); \\\n"
+    "    else if (shape == 1) for (size_t i = 0; i < n; ++i) out[i] = f(a[i], y); \\\n"
+    "    else for (size_t i = 0; i < n; ++i) out[i] = f(x, b[i]); \\\n"
+    "    if (out != d->buf) { free(d->buf); d->buf = out; d->cap = n; } \\\n"
+    "    d->data = out; d->len = n; \\\n"
+    "}\n"
+    "DH_VEC_OP(dh_vadd, dh_add)\n"
+    "DH_VEC_OP(dh_vsub, dh_sub)\n"
+    "DH_VEC_OP(dh_vmul, dh_mul)\n"
+    "DH_VEC_OP(dh_vdiv, dh_div)\n"
+    "DH_VEC_OP(dh_vmod, dh_mod)\n"
+    "\n";
+
+/**
+ * @brief 생성 파일 머리 주석에 쓸 원본 이름 ("*" 뒤의 "/"는 주석을 닫지 않게 띄움)
+ */
+static void write_source_name(FILE* out, const char* name) {
+    for (const char* p = name; *p; ++p) {
+        fputc(*p, out);
+        if (*p == '*' && p[1] == '/') fputc(' ', out);
+    }
+}
+
+/**
+ * @brief 변수 선언, 하위 루틴 함수 dh_sN들, dh_partN 함수들, 그것을 차례로 부르는 main 순으로 씀
+ * 변수는 파일 범위 static이다: 주소를 내보내지 않으므로 C 컴파일러는 함수 안에서 레지스터에 둘 수 있다.
+ */
+static bool write_program(const Emitter* em, const char* filename, const RunOptions* opts, FILE* out) {
+    fprintf(out, "/* Generated by dahdit %s --emit-c from ", DAHDIT_VERSION);
+    write_source_name(out, filename);
+    fprintf(out, "%s */\n", opts->optimize ? " (-O)" : "");
+    fputs(PRELUDE, out);
+    bool arrays = false;
+    for (size_t slot = 0; slot < em->used_cap; ++slot) arrays = arrays || (em->used[slot] & USE_ARRAY);
+    if (arrays) fputs(ARRAY_PRELUDE, out);
+
+    for (size_t slot = 0; slot < em->used_cap && slot < (size_t)em->st->count; ++slot) {
+        if (em->used[slot] & USE_VAR) {
+            fprintf(out, "static int32_t v%zu; static unsigned char d%zu; /* %s */\n",
+                    slot, slot, st_name(em->st, (int)slot));
+        }
+        if (em->used[slot] & USE_ARRAY) fprintf(out, "static dh_arr a%zu; /* %s */\n", slot, st_name(em->st, (int)slot));
+    }
+    if (em->vec_temps > 0) fprintf(out, "static dh_vec dh_v[%d];\n", em->vec_temps);
+    fputs("\n", out);
+    if (em->calls) fputs("static int dh_depth, dh_unwind;\n\n", out);  // 하위 루틴 호출 깊이 (꼬리 호출 제외), 깊이 초과로 푸는 중
+    fwrite(em->subs.data, 1, em->subs.len, out);
+    fwrite(em->funcs.data, 1, em->funcs.len, out);
+
+    fputs("int main(void) {\n", out);
+    if (opts->flush == OUT_FLUSH_LINE) fputs("    setvbuf(stdout, NULL, _IOLBF, BUFSIZ);\n", out);
+    else if (opts->flush != OUT_FLUSH_AUTO) fputs("    setvbuf(stdout, NULL, _IOFBF, 1 << 16);\n", out);
+    for (size_t k = 0; k < em->nsubs_done; ++k) {
+        if (!em->called[k]) fprintf(out, "    (void)dh_s%zu;\n", k);
+    }
+    for (size_t k = 0; k < em->nparts; ++k) fprintf(out, "    dh_part%zu();\n", k);
+    fputs("    return fflush(stdout) == 0 ? 0 : 1;\n}\n", out);
+    return fflush(out) == 0 && !ferror(out);
+}
+
+/**
+ * @brief 프로그램을 C 번역 단위로 변환
+ *
+ * 인터프리터와 같은 파서/컴파일러로 바이트코드를 만든 뒤 그것을 C로 옮기므로,
+ * 오류 검사와 건너뛰는 범위가 실행 경로와 항상 일치한다.
+ * 변수 이름은 파일 안에서만 의미가 있으므로 선언 주석으로만 남긴다.
+ *
+ * @return 변환했으면 true, 파일을 열 수 없거나 메모리가 부족하거나 쓰기에 실패하면 false.
+ */
+bool emit_c_file(const char* filename, const RunOptions* opts, FILE* out) {
+    Lexer lx;
+    if (!lx_open(&lx, filename)) {
+        diag_message("Cannot open: %s\n", filename);
+        return false;
+    }
+
+    SymTab st; st_init(&st);
+    Chunk ch; bc_init(&ch);
+    Emitter em = {0};
+    em.st = &st;
+    vm_init(&em.vm, &st, lx.filename, NULL);
+
+    bool ok = whole_program(opts) ? emit_whole(&em, &lx, &ch, opts)
+                                  : emit_streaming(&em, &lx, &ch);
+    close_part(&em);
+    ok = ok && !em_nomem(&em);
+    if (!ok) diag_message("Out of memory\n");
+    else if (!write_program(&em, lx.filename, opts, out)) {
+        diag_message("Cannot write C output\n");
+        ok = false;
+    }
+
+    free(em.funcs.data);
+    free(em.part.data);
+    free(em.subs.data);
+    free(em.body.data);
+    free(em.used);
+    free(em.called);
+    bc_free(&ch);
+    st_free(&st);
+    lx_close(&lx);
+    return ok;
+}
@@ -5,176 +5,565 @@
 #include "lexer.h"
 #include "diag.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "parser.h"
 #include "symtab.h"
+#include "bytecode.h"
+#include "vm.h"
+#include "program.h"
+#include "optimize.h"
+#include "arena.h"
+#include "profile.h"
+#include "parallel.h"
+#include "pipeline.h"
+#include "stream.h"
+#include "cache.h"
+#include "jit.h"
+#include "state.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 
 /**
- * @brief 표현식(Expr)을 스택 기반으로 평가하고 최종 정수 값을 반환.(스택을 사용하여 계산)
+ * @brief ps에서 문장을 하나씩 파싱 → 컴파일 → 실행 (--dump-bytecode이면 ch에 모으기만 함)
+ * 블록(WHILE/IF/REPEAT ... END)은 END까지 ch에 모은 뒤 한 번에 실행한다. 입력 끝에서 닫히지 않은
+ * 블록은 호출한 쪽이 bc_end_blocks로 정리한다 (표준 입력은 블록이 여러 묶음에 걸칠 수 있음).
+ * @param src_mem 소스 버퍼 크기 (--profile 메모리 집계용)
+ * @return 메모리 부족이면 false.
+ */
+static bool run_stmts(Parser* ps, Arena* arena, Chunk* ch, VM* vm, const RunOptions* opts, size_t src_mem) {
+    Stmt s;
+    bool ok = true;
+    (void)src_mem;
+
+    for (;;) {
+        PROF_ENTER(PROF_PARSE);
+        bool more = ps_next_stmt(ps, &s);
+        PROF_LEAVE();
+        if (!more || diag_stopped()) break;
+        PROF_COUNT(stmts, s.kind != STMT_NONE);
+        PROF_MEMORY(src_mem, ps_memory(ps), st_memory(ps->st));
+
+        PROF_ENTER(PROF_COMPILE);
+        if (!opts->dump_bytecode && !bc_in_block(ch)) bc_reset_stmts(ch);
+        bool compiled = bc_compile_stmt(ch, &s, ps->st, ps->filename);
+        arena_reset(arena);
+        bool run = compiled && !opts->dump_bytecode && !bc_in_block(ch);
+        if (run && !bc_finish(ch)) ok = false;
+        PROF_LEAVE();
+        if (!ok) break;
+        if (!run) continue;
+
+        PROF_ENTER(PROF_EXEC);
+        ok = vm_run(vm, ch);
+        PROF_LEAVE();
+        if (!ok || diag_stopped()) break;
+    }
+    return ok;
+}
+
+/**
+ * @brief 문장을 하나씩 파싱 → 컴파일 → 실행 (기본 모드)
+ * --dump-bytecode이면 실행하지 않고 전체 프로그램을 하나의 chunk로 모아 출력한다.
+ */
+static bool run_streaming(Lexer* lx, SymTab* st, Chunk* ch, VM* vm, const RunOptions* opts) {
+    // 문장 하나 분량의 식/문자열만 담는 arena: 컴파일이 끝나면 바로 비운다
+    Arena arena; arena_init(&arena, 0);
+    Parser ps; ps_init(&ps, lx, st, &arena);
+    bool ok = run_stmts(&ps, &arena, ch, vm, opts, lx_memory(lx));
+    bc_end_blocks(ch, lx->filename);
+
+    if (ok && opts->dump_bytecode) {
+        ok = bc_finish(ch);
+        if (ok) bc_dump(ch, st, stdout);
+    }
+
+    ps_free(&ps);
+    arena_free(&arena);
+    return ok;
+}
+
+/**
+ * @brief 표준 입력을 문장 경계에서 끊어 읽으며, 완결된 문장이 도착하는 대로 실행 (dahdit -)
+ * 읽은 묶음마다 이어지는 위치(line/col)로 렉서를 열고, 실행한 부분은 버리므로
+ * 메모리는 입력 길이와 무관하게 가장 긴 문장 하나 정도로 유지된다.
+ * 입력을 기다리기 전에 출력을 비워 생산자 → 인터프리터 간 지연을 줄인다 (--flush=explicit 제외).
+ * @return 메모리 부족이면 false. 읽기 오류는 *read_failed로 알린다.
+ */
+static bool run_stdin(const char* name, SymTab* st, Chunk* ch, VM* vm, const RunOptions* opts, bool* read_failed) {
+    SourceStream ss; ss_init(&ss, 0);
+    Arena arena; arena_init(&arena, 0);
+    int64_t line = 1, col = 1;
+    bool ok = true;
+    const char* data;
+    size_t size;
+
+    for (;;) {
+        if (vm->out->policy != OUT_FLUSH_EXPLICIT) out_flush(vm->out);
+        if (!ss_next(&ss, &data, &size)) break;
+
+        Lexer lx; lx_open_slice(&lx, name, data, size, line, col);
+        Parser ps; ps_init(&ps, &lx, st, &arena);
+        ok = run_stmts(&ps, &arena, ch, vm, opts, ss.cap);
+        bool fatal = ps.cur.kind != TK_EOF;
+        line = lx.line; col = lx.col;
+        ps_free(&ps);
+        lx_close(&lx);
+        if (!ok || fatal || diag_stopped()) break;
+    }
+    bc_end_blocks(ch, name);
+    if (ss.nomem) ok = false;
+    *read_failed = ss.failed;
+    if (ok && !ss.failed && opts->dump_bytecode) {
+        ok = bc_finish(ch);
+        if (ok) bc_dump(ch, st, stdout);
+    }
+
+    ss_free(&ss);
+    arena_free(&arena);
+    return ok;
+}
+
+/**
+ * @brief 전체 프로그램을 하나의 chunk로 만든 뒤 실행하는 모드인지 (-O, --parallel, --jit)
+ */
+bool whole_program(const RunOptions* opts) {
+    return opts->optimize || opts->parallel > 0 || opts->jit;
+}
+
+/**
+ * @brief 전체 프로그램을 먼저 파싱(--parallel이면 여러 스레드에서)하고,
+ * -O이면 최적화한 뒤 하나의 chunk로 컴파일
+ * @return 메모리 부족이면 false.
+ */
+bool compile_whole(Lexer* lx, SymTab* st, Chunk* ch, const RunOptions* opts) {
+    Program prog; prog_init(&prog);
+    bool ok;
+    if (opts->parallel > 0) {
+        PROF_ENTER(PROF_PARSE);
+        ok = par_parse(&prog, lx, st, opts->parallel);
+        PROF_LEAVE();
+    } else {
+        Parser ps; ps_init(&ps, lx, st, &prog.arena);
+        ok = prog_parse(&prog, &ps);
+        PROF_MEMORY(lx_memory(lx), ps_memory(&ps) + prog.cap * sizeof(Stmt), st_memory(st));
+        ps_free(&ps);
+    }
+
+    if (ok && opts->optimize) {
+        OptStats stats;
+        FILE* report = opts->opt_report ? stderr : NULL;
+        if (report) diag_sync();    // 보고는 stderr에 직접 쓰므로 앞선 진단을 먼저 내보냄
+        PROF_ENTER(PROF_OPTIMIZE);
+        if (!opt_program(&prog, st, lx->filename, report, opts->vars_live_out, &stats)) {
+            diag_message("warning: optimizer ran out of memory, continuing with partially optimized program\n");
+        }
+        PROF_LEAVE();
+        if (report) opt_print_stats(&stats, report);
+    }
+
+    if (ok) {
+        PROF_ENTER(PROF_COMPILE);
+        for (size_t i = 0; i < prog.count; ++i) {
+            bc_compile_stmt(ch, &prog.stmts[i], st, lx->filename);
+        }
+        bc_end_blocks(ch, lx->filename);
+        ok = bc_finish(ch);
+        PROF_LEAVE();
+    }
+
+    prog_free(&prog);
+    return ok;
+}
+
+/**
+ * @brief 전체 프로그램을 컴파일한 뒤 한 번에 실행 (-O, --parallel)
+ */
+static bool run_whole(Lexer* lx, SymTab* st, Chunk* ch, VM* vm, const RunOptions* opts) {
+    bool ok = compile_whole(lx, st, ch, opts);
+    if (ok && !diag_stopped()) {
+        if (opts->dump_bytecode) bc_dump(ch, st, stdout);
+        else {
+            PROF_ENTER(PROF_EXEC);
+            ok = vm_run(vm, ch);
+            PROF_LEAVE();
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief 컴파일 캐시(.ditc)를 거쳐 실행
  *
- * Dashdit 파서가 생성한 표현식 항목(ExprItem)은 피연산자가 연산자보다 앞서는 형태로
- * 암묵적인 후위 표기법(RPN)처럼 동작.
+ * 캐시가 유효하면 렉싱/파싱/컴파일 없이 매핑한 바이트코드를 바로 실행한다.
+ * 없거나 오래된 경우 전체 프로그램을 컴파일하여 캐시를 새로 쓰고 그 결과를 실행한다.
+ * 컴파일 진단이 있는 프로그램은 진단과 실행 출력의 순서가 모드에 따라 달라지므로
+ * 캐시 불가로 기록해 두고 일반 경로로 실행하게 한다.
  *
- * @param expr 평가할 표현식 구조체.
- * @param st 변수 조회를 위한 심볼 테이블.
- * @param filename 오류 보고를 위한 파일 이름.
- * @param line, col 오류 보고를 위한 위치 정보.
- * @param out 최종 평가된 정수 값을 저장할 포인터.
- * @return 평가 성공 시 true, 오류 발생 시 false (단, 호출자가 오류를 처리하고 진행할 수 있음).
- */
-static bool eval_expr(const Expr* expr, SymTab* st, const char* filename, int line, int col, int32_t* out) {
-    int32_t stack[MAX_EXPR_ITEMS];
-    int sp = 0;
-
-    for (int i = 0; i < expr->count; ++i) {
-        ExprItem item = expr->items[i];
-        switch (item.kind) {
-            case EXPR_ITEM_NUMBER:
-                if (sp >= MAX_EXPR_ITEMS) {
-                    diag_error(filename, line, col, "Expression stack overflow (number)");
-                    return false;
-                }
-                stack[sp++] = item.as.number;
-                break;
-            case EXPR_ITEM_VAR: {
-                int32_t value;
-                if (!st_get(st, item.as.var, &value)) {
-                    char msg[96];
-                    snprintf(msg, sizeof(msg), "undefined variable '%s'", item.as.var);
-                    diag_error(filename, line, col, msg);
-                    return false;
-                }
-                if (sp >= MAX_EXPR_ITEMS) {
-                    diag_error(filename, line, col, "Expression stack overflow (variable)");
-                    return false;
-                }
-                stack[sp++] = value;
-                break;
-            }
-            case EXPR_ITEM_OP: {
-                if (sp < 2) {
-                    diag_error(filename, line, col, "not enough operands for operator");
-                    return false;
-                }
-                int32_t rhs = stack[--sp];
-                int32_t lhs = stack[--sp];
-                int32_t result = 0;
-
-                switch (item.as.op) {
-                    case EXPR_OP_ADD:
-                        result = lhs + rhs;
-                        break;
-                    case EXPR_OP_SUB:
-                        result = lhs - rhs;
-                        break;
-                    case EXPR_OP_MUL: // Added Multiplication
-                        result = lhs * rhs;
-                        break;
-                    case EXPR_OP_DIV: // Added Division
-                        if (rhs == 0) {
-                            diag_error(filename, line, col, "Division by zero");
-                            return false;
-                        }
-                        result = lhs / rhs;
-                        break;
-                    case EXPR_OP_MOD: // Added Modulo
-                        if (rhs == 0) {
-                            diag_error(filename, line, col, "Modulo by zero");
-                            return false;
-                        }
-                        result = lhs % rhs;
-                        break;
-                    default:
-                        diag_error(filename, line, col, "Unknown operator in expression");
-                        return false;
-                }
-                stack[sp++] = result;
-                break;
-            }
+ * @param ok 처리한 경우 실행 결과 (메모리 부족이면 false).
+ * @return 캐시 경로로 처리했으면 true, 일반 경로로 실행해야 하면 false (lx/st/ch는 처음 상태).
+ */
+static bool run_cached(Lexer* lx, SymTab* st, Chunk* ch, VM* vm, const RunOptions* opts, bool* ok) {
+    char* path = cache_path(lx->filename);
+    if (!path) return false;
+    uint64_t hash = cache_hash(lx->buf, lx->size);
+    uint32_t flags = opts->optimize ? DITC_OPTIMIZED : 0;
+    bool handled = false;
+
+    DitCache dc;
+    CacheStatus status = cache_load(&dc, path, hash, lx->size, flags);
+    if (status == CACHE_HIT) {
+        if (cache_intern(&dc, st)) {
+            PROF_ENTER(PROF_EXEC);
+            *ok = vm_run(vm, &dc.chunk);
+            PROF_LEAVE();
+            handled = true;
+        }
+        cache_close(&dc);
+    } else if (status == CACHE_MISS) {
+        DiagBuffer diags = {0};
+        DiagBuffer* prev = diag_capture(&diags);
+        bool built = compile_whole(lx, st, ch, opts);
+        diag_capture(prev);
+        bool clean = built && diags.len == 0;
+        diag_flush(&diags, NULL);
+        if (built) cache_save(path, hash, lx->size, flags, clean ? ch : NULL, st);
+        if (clean) {
+            PROF_ENTER(PROF_EXEC);
+            *ok = vm_run(vm, ch);
+            PROF_LEAVE();
+            handled = true;
         }
     }
+    free(path);
 
-    if (sp != 1) {
-        diag_error(filename, line, col, "expression did not reduce to a value");
-        return false;
+    if (!handled) {
+        // 일반 경로가 처음부터 다시 시작할 수 있도록 되돌림 (캐시는 빈 심볼 테이블에서만 사용)
+        st_clear(st);
+        bc_reset(ch);
+        lx_rewind(lx);
+        diag_begin_run();   // 버린 진단은 오류 수에 넣지 않음
     }
+    return handled;
+}
+
+//========================================
+// Hot Programs (--jit)
+//========================================
 
-    *out = stack[0];
-    return true;
+static void hot_free(HotProgram* hp) {
+    jit_free(hp->jit);
+    bc_free(&hp->ch);
+    free(hp->names);
+    memset(hp, 0, sizeof(*hp));
 }
 
 /**
- * @brief 단일 문장(Statement)의 실행을 처리.
- * run_program 함수의 중첩 깊이를 줄이기 위해 분리.
- *
- * @param s 실행할 문장 구조체.
- * @param st 심볼 테이블.
- * @param filename 오류 보고를 위한 파일 이름.
- * @return 치명적인 오류가 발생하지 않았으면 true (다음 문장으로 계속 진행).
- */
-static bool handle_statement(const Stmt* s, SymTab* st, const char* filename) {
-    switch (s->kind) {
-        case STMT_PRINT: {
-            int32_t value;
-            if (!eval_expr(&s->printStmt.expr, st, filename, s->line, s->col, &value)) {
-                return true;
+ * @brief 같은 소스의 보관된 프로그램을 찾음. 심볼 테이블이 초기화된 뒤라면, 빈 테이블에서 컴파일한
+ * 프로그램은 이름을 같은 순서로 다시 등록하여 슬롯 번호를 되살린다.
+ * @param stale 키는 같지만 쓸 수 없는 항목 (새로 컴파일한 결과를 그 자리에 둠)
+ */
+static HotProgram* hot_find(Interp* it, uint64_t hash, size_t size, HotProgram** stale) {
+    for (int i = 0; i < INTERP_HOT_PROGRAMS; ++i) {
+        HotProgram* hp = &it->hot[i];
+        if (!hp->used || hp->src_hash != hash || hp->src_size != size) continue;
+        if (hp->generation == it->st.generation) return hp;
+        if (hp->names && it->st.count == 0) {
+            const char* p = hp->names;
+            bool ok = true;
+            for (size_t slot = 0; ok && slot < hp->nsyms; ++slot) {
+                size_t len = strlen(p);
+                ok = st_intern(&it->st, p, len) == (int)slot;
+                p += len + 1;
             }
-            printf("%d\n", value);
-            break;
+            if (ok) { hp->generation = it->st.generation; return hp; }
+            st_clear(&it->st);
         }
+        *stale = hp;
+        return NULL;
+    }
+    return NULL;
+}
 
-        case STMT_PRINT_STR: {
-            printf("%s\n", s->printStrStmt.text);
-            break;
-        }
+/**
+ * @brief 새 프로그램을 둘 자리 (빈 자리, 없으면 가장 오래 쓰지 않은 항목을 비움)
+ */
+static HotProgram* hot_victim(Interp* it) {
+    HotProgram* victim = &it->hot[0];
+    for (int i = 0; i < INTERP_HOT_PROGRAMS; ++i) {
+        if (!it->hot[i].used) return &it->hot[i];
+        if (it->hot[i].last_use < victim->last_use) victim = &it->hot[i];
+    }
+    return victim;
+}
 
-        case STMT_VAR: {
-            if (!s->varStmt.has_value) {
-                diag_error(filename, s->line, s->col, "VAR without initializer is not supported yet");
-                return true;
-            }
-            int32_t value;
-            if (!eval_expr(&s->varStmt.value_expr, st, filename, s->line, s->col, &value)) {
-                return true;
-            }
-            if (!st_set(st, s->varStmt.name, value)) {
-                diag_error(filename, s->line, s->col, "Symbol table full");
-                return true;
-            }
-            break;
+/**
+ * @brief 심볼 테이블의 이름들을 슬롯 순서로 이어 붙임 (실패 시 NULL)
+ */
+static char* copy_names(const SymTab* st) {
+    size_t total = 1;
+    for (int slot = 0; slot < st->count; ++slot) total += strlen(st_name(st, slot)) + 1;
+    char* names = malloc(total);
+    if (!names) return NULL;
+    char* p = names;
+    for (int slot = 0; slot < st->count; ++slot) {
+        size_t len = strlen(st_name(st, slot)) + 1;
+        memcpy(p, st_name(st, slot), len);
+        p += len;
+    }
+    return names;
+}
+
+/**
+ * @brief --jit 실행: 보관된 프로그램이면 렉싱/파싱/컴파일 없이 실행하고, 아니면 전체 프로그램을
+ * 컴파일하여 보관한다. INTERP_JIT_RUNS번째 실행부터는 기계어로 번역한 코드로 실행한다.
+ *
+ * 컴파일 진단이 있는 프로그램은 다시 실행할 때 진단을 재현해야 하므로 보관하지 않는다.
+ * @return 메모리 부족이면 false.
+ */
+static bool run_hot(Interp* it, Lexer* lx) {
+    uint64_t hash = cache_hash(lx->buf, lx->size);
+    HotProgram* stale = NULL;
+    HotProgram* hp = hot_find(it, hash, lx->size, &stale);
+    bool ok;
+
+    if (!hp) {
+        bool fresh = it->st.count == 0;
+        DiagBuffer diags = {0};
+        DiagBuffer* prev = diag_capture(&diags);
+        bc_reset(&it->ch);
+        bool built = compile_whole(lx, &it->st, &it->ch, &it->opts);
+        diag_capture(prev);
+        bool clean = built && diags.len == 0;
+        if (diags.len > 0) diag_forward(&diags, 0, diags.len);
+        diag_flush(&diags, NULL);
+        if (!built) return false;
+        if (diag_stopped()) return true;
+
+        if (!clean) {
+            PROF_ENTER(PROF_EXEC);
+            ok = vm_run(&it->vm, &it->ch);
+            PROF_LEAVE();
+            return ok;
         }
 
-        default:
-            diag_error(filename, s->line, s->col, "Internal error: Unknown statement kind");
-            break;
+        hp = stale ? stale : hot_victim(it);
+        hot_free(hp);
+        hp->used = true;
+        hp->src_hash = hash;
+        hp->src_size = lx->size;
+        hp->generation = it->st.generation;
+        if (fresh && (hp->names = copy_names(&it->st)) != NULL) hp->nsyms = (size_t)it->st.count;
+        hp->ch = it->ch;        // chunk 소유권을 넘기고 작업용 chunk는 새로 시작
+        bc_init(&it->ch);
+    }
+
+    hp->last_use = ++it->tick;
+    if (++hp->runs >= INTERP_JIT_RUNS && !hp->jit && !hp->jit_failed) {
+        hp->jit = jit_compile(&hp->ch);
+        hp->jit_failed = hp->jit == NULL;
+    }
+
+    PROF_ENTER(PROF_EXEC);
+    ok = hp->jit ? jit_run(hp->jit, &it->vm) : vm_run(&it->vm, &hp->ch);
+    PROF_LEAVE();
+    return ok;
+}
+
+//========================================
+// Interpreter
+//========================================
+
+void interp_init(Interp* it, const RunOptions* opts, Output* out) {
+    RunOptions defaults = {0};
+    it->opts = opts ? *opts : defaults;
+    st_init(&it->st);
+    bc_init(&it->ch);
+    vm_init(&it->vm, &it->st, NULL, out);
+    memset(it->hot, 0, sizeof(it->hot));
+    it->tick = 0;
+}
+
+void interp_free(Interp* it) {
+    for (int i = 0; i < INTERP_HOT_PROGRAMS; ++i) hot_free(&it->hot[i]);
+    vm_free(&it->vm);
+    bc_free(&it->ch);
+    st_free(&it->st);
+}
+
+void interp_reset(Interp* it) {
+    st_clear(&it->st);
+    bc_reset(&it->ch);
+    vm_reset_arrays(&it->vm);
+}
+
+/**
+ * @brief 열린 렉서의 프로그램을 옵션에 맞는 경로로 실행
+ * @param cache 컴파일 캐시를 써도 되는 소스인지 (실제 파일)
+ */
+static bool run_lexer(Interp* it, Lexer* lx, bool cache) {
+    const RunOptions* opts = &it->opts;
+    SymTab* st = &it->st;
+    Chunk* ch = &it->ch;
+    VM* vm = &it->vm;
+    vm->filename = lx->filename;
+    bc_reset(ch);
+    diag_begin_run();
+
+    // 캐시: 실행 결과만 필요한 경우 (덤프/최적화 보고는 컴파일 과정을 보여 줘야 함).
+    // 캐시의 슬롯 번호를 그대로 쓰므로 변수가 남아 있지 않은 상태에서만 사용
+    bool cacheable = cache && st->count == 0 && !opts->vars_live_out &&
+                     !opts->no_cache && !opts->dump_bytecode && !opts->opt_report &&
+                     lx->size > 0 && lx->size <= DITC_MAX_SOURCE;
+
+    bool ok;
+    if (opts->jit && !opts->dump_bytecode && !opts->opt_report) {
+        ok = run_hot(it, lx);
+    }
+    else if (cacheable && run_cached(lx, st, ch, vm, opts, &ok)) {
+        // 캐시 경로에서 실행 완료
+    }
+    else if (whole_program(opts)) {
+        ok = run_whole(lx, st, ch, vm, opts);
+    }
+    else {
+        ok = run_streaming(lx, st, ch, vm, opts);
     }
-    return true;
+    if (!ok) diag_message("Out of memory\n");
+    return ok;
 }
 
+#ifndef _WIN32
 /**
- * @brief Dashdit 프로그램을 로드, 파싱 및 실행
+ * @brief --pipeline으로 실행할지 (전체 프로그램 모드와 바이트코드 덤프가 우선)
+ */
+static bool pipelined(const RunOptions* opts) {
+    return opts->pipeline && !whole_program(opts) && !opts->dump_bytecode;
+}
+
+/**
+ * @brief 렉서 스레드가 입력을 읽어 가며 토큰화하고 파서/실행기가 뒤따르는 파이프라인으로 실행
+ * 소스를 미리 적재하지 않으므로 컴파일 캐시는 쓰지 않는다.
+ */
+static bool run_pipeline(Interp* it, const char* filename, bool is_stdin) {
+    const char* name = is_stdin ? LX_STDIN_NAME : filename;
+    int fd = is_stdin ? 0 : open(filename, O_RDONLY);
+    if (fd < 0) {
+        diag_message("Cannot open: %s\n", filename);
+        return false;
+    }
+    bool read_failed = false;
+    bc_reset(&it->ch);
+    diag_begin_run();
+    it->vm.filename = name;
+    bool ok = pipe_run(name, fd, &it->st, &it->ch, &it->vm, &read_failed);
+    if (!is_stdin) close(fd);
+    if (read_failed) diag_message("Cannot read: %s\n", filename);
+    if (!ok) diag_message("Out of memory\n");
+    return ok && !read_failed;
+}
+#endif
+
+/**
+ * @brief 파일의 프로그램을 실행
+ *
+ * 기본적으로 문장을 하나 파싱할 때마다 바이트코드로 컴파일한 뒤 VM으로 즉시 실행한다.
+ * 최적화(-O)나 병렬 파싱(--parallel)을 켜면 전체 프로그램을 먼저 파싱하므로
+ * 구문 오류 진단이 실행보다 먼저 출력된다.
+ * filename이 "-"이면 표준 입력에서 문장이 도착하는 대로 실행한다 (-O/--parallel/--jit은 입력 끝까지 읽은 뒤 실행).
+ * --pipeline이면 파일/표준 입력 모두 렉서 스레드가 읽어 가며 토큰화한다.
  *
- * @param filename .dit 파일 경로.
- * @return 프로그램이 성공적으로 실행되었거나 (비치명적인 오류 포함), 파일을 열 수 없으면 false.
+ * @return 프로그램이 실행되었으면 (비치명적인 오류 포함) true, 파일을 열거나 읽을 수 없거나 메모리가 부족하면 false.
  */
-bool run_program(const char* filename) {
+bool interp_run_file(Interp* it, const char* filename) {
+    const RunOptions* opts = &it->opts;
+    bool is_stdin = strcmp(filename, "-") == 0;
+
+#ifndef _WIN32
+    if (pipelined(opts)) return run_pipeline(it, filename, is_stdin);
+#endif
+
+    // 표준 입력 스트리밍: 전체 프로그램이 필요한 모드가 아니면 소스를 미리 적재하지 않는다
+    if (is_stdin && !whole_program(opts)) {
+        bool read_failed = false;
+        bc_reset(&it->ch);
+        diag_begin_run();
+        it->vm.filename = LX_STDIN_NAME;
+        bool ok = run_stdin(LX_STDIN_NAME, &it->st, &it->ch, &it->vm, opts, &read_failed);
+        if (read_failed) diag_message("Cannot read: %s\n", filename);
+        if (!ok) diag_message("Out of memory\n");
+        return ok && !read_failed;
+    }
+
     Lexer lx;
     if (!lx_open(&lx, filename)) {
-        fprintf(stderr, "Cannot open: %s\n", filename);
+        diag_message("Cannot open: %s\n", filename);
         return false;
     }
+    bool ok = run_lexer(it, &lx, !is_stdin);
+    lx_close(&lx);
+    return ok;
+}
 
-    Parser ps; ps_init(&ps, &lx);
-    SymTab st; st_init(&st);
-    Stmt s;
+/**
+ * @brief 메모리에 있는 프로그램을 실행 (복사하지 않음, 캐시 사용 안 함)
+ * @param name 진단에 표시할 이름
+ */
+bool interp_run_buffer(Interp* it, const char* name, const char* data, size_t size) {
+    Lexer lx;
+    lx_open_buffer(&lx, name, data, size);
+    bool ok = run_lexer(it, &lx, false);
+    lx_close(&lx);
+    return ok;
+}
+
+/**
+ * @brief Dashdit 프로그램을 로드, 파싱 및 실행 (명령줄 도구: 표준 출력 / 표준 에러)
+ *
+ * @param filename .dit 파일 경로 또는 "-".
+ * @param opts 실행 옵션 (NULL이면 기본값).
+ * @return 프로그램이 성공적으로 실행되었거나 (비치명적인 오류 포함), 파일을 열 수 없거나 오류 수 제한으로 중단되면 false.
+ */
+bool run_program(const char* filename, const RunOptions* opts) {
+    RunOptions defaults = {0};
+    if (!opts) opts = &defaults;
+#ifdef DAHDIT_PROFILE
+    if (opts->profile) prof_start();
+#endif
 
-    // 다음 문장을 파싱하고, handle_statement를 호출
-    while (ps_next_stmt(&ps, &s)) {
-        handle_statement(&s, &st, lx.filename);
+    RunOptions run_opts = *opts;
+    if (run_opts.save_state) run_opts.vars_live_out = true;
+
+    Output out; out_init(&out, 1, opts->flush);
+    Interp it; interp_init(&it, &run_opts, &out);
+    StateImage img = {0};
+    bool ok = true;
+    if (opts->load_state) {
+        StateStatus status = state_load(&img, opts->load_state, &it.st);
+        if (status != STATE_OK) {
+            diag_message("Cannot load state: %s: %s\n", opts->load_state, state_error(status));
+            ok = false;
+        }
     }
+    if (ok) ok = interp_run_file(&it, filename);
+    if (diag_stopped()) ok = false;     // 오류 수 제한으로 중단된 프로그램의 상태는 저장하지 않음
+    if (ok && opts->save_state) {
+        if (!state_save(opts->save_state, &it.st)) {
+            diag_message("Cannot save state: %s\n", opts->save_state);
+            ok = false;
+        }
+    }
+    interp_free(&it);
+    state_close(&img);
+    out_free(&out);
+    diag_sync();
 
-    lx_close(&lx);
-    return true;
-}
\ No newline at end of file
+#ifdef DAHDIT_PROFILE
+    if (opts->profile) prof_report(stderr);
+#endif
+    return ok;
+}
@@ -0,0 +1,545 @@
+//========================================
+// System Includes
+//========================================
+#include "jit.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__linux__)
+#define JIT_X64 1
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef JIT_X64
+
+// 생성 함수의 인자 (System V: rdi, rsi, rdx, rcx, r8)
+typedef void (*JitFn)(int32_t* values, uint8_t* defined, int32_t* spill, VM* vm, Output* out);
+
+struct JitCode {
+    void* mem;
+    size_t size;
+    JitFn fn;
+    int max_stack;
+};
+
+//========================================
+// Registers
+//========================================
+enum { RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI, R8, R9, R10, R11, R12, R13, R14, R15 };
+
+// 함수 전체에서 고정 (callee-saved)
+#define R_VALUES  RBX
+#define R_DEFINED RBP
+#define R_SPILL   R12   // 깊이 NREGS 이상의 피연산자 (VM 스택)
+#define R_VM      R13
+#define R_OUT     R14
+
+// 문장 base 위의 피연산자 스택 깊이 d → 레지스터. rax/rdx는 idiv, r11은 메모리 피연산자용으로 비워 둔다.
+// 출력/진단 호출은 식 스택이 비어 있을 때만 일어나므로 caller-saved 레지스터를 써도 된다.
+// base 아래의 REPEAT 카운터와 레지스터를 넘친 피연산자는 VM 스택 메모리(spill + d*4)에 둔다.
+static const int STACK_REGS[] = { RCX, RSI, RDI, R8, R9, R10 };
+#define NREGS ((int)(sizeof(STACK_REGS) / sizeof(STACK_REGS[0])))
+
+enum { CC_E = 0x4, CC_NE = 0x5, CC_LE = 0xE, CC_G = 0xF };
+
+//========================================
+// Assembler (코드 버퍼와 나중에 채울 점프 위치)
+//========================================
+typedef struct {
+    size_t pos;             // rel32 위치
+    size_t pc;              // 목적지 바이트코드 위치
+} Fixup;
+
+typedef struct {
+    size_t pos;             // 오류 경로로 가는 rel32 위치
+    const StmtInfo* at;
+    VmError err;
+    int32_t slot;
+    size_t resume;          // 오류 후 이어서 실행할 바이트코드 위치 (다음 문장)
+} Stub;
+
+typedef struct {
+    uint8_t* buf;
+    size_t len, cap;
+    Fixup* fixups;
+    size_t nfixups, fixups_cap;
+    Stub* stubs;
+    size_t nstubs, stubs_cap;
+    int base;               // 현재 문장의 base (그 아래는 REPEAT 카운터)
+    bool nomem;
+} Asm;
+
+static bool grow(void** arr, size_t* cap, size_t need, size_t elem) {
+    if (need <= *cap) return true;
+    size_t n = *cap ? *cap : 256;
+    while (n < need) n *= 2;
+    void* p = realloc(*arr, n * elem);
+    if (!p) return false;
+    *arr = p; *cap = n;
+    return true;
+}
+
+static void put8(Asm* a, uint8_t b) {
+    if (a->nomem || !grow((void**)&a->buf, &a->cap, a->len + 1, 1)) { a->nomem = true; return; }
+    a->buf[a->len++] = b;
+}
+
+static void put32(Asm* a, uint32_t v) {
+    for (int i = 0; i < 4; ++i) put8(a, (uint8_t)(v >> (8 * i)));
+}
+
+static void put64(Asm* a, uint64_t v) {
+    for (int i = 0; i < 8; ++i) put8(a, (uint8_t)(v >> (8 * i)));
+}
+
+static void patch32(Asm* a, size_t pos, uint32_t v) {
+    if (a->nomem) return;
+    for (int i = 0; i < 4; ++i) a->buf[pos + (size_t)i] = (uint8_t)(v >> (8 * i));
+}
+
+//========================================
+// Instruction Encoding (필요한 것만)
+//========================================
+static void rex(Asm* a, bool w, int reg, int rm) {
+    uint8_t r = (uint8_t)(0x40 | (w ? 8 : 0) | ((reg >> 3) & 1) << 2 | ((rm >> 3) & 1));
+    if (r != 0x40) put8(a, r);
+}
+
+// op r/m32(rm), r32(reg): mov 89, add 01, sub 29, xor 31, test 85
+static void op_rr(Asm* a, uint8_t op, int reg, int rm) {
+    rex(a, false, reg, rm);
+    put8(a, op);
+    put8(a, (uint8_t)(0xC0 | (reg & 7) << 3 | (rm & 7)));
+}
+
+static void mov_rr64(Asm* a, int dst, int src) {
+    rex(a, true, src, dst);
+    put8(a, 0x89);
+    put8(a, (uint8_t)(0xC0 | (src & 7) << 3 | (dst & 7)));
+}
+
+static void imul_rr(Asm* a, int dst, int src) {
+    rex(a, false, dst, src);
+    put8(a, 0x0F); put8(a, 0xAF);
+    put8(a, (uint8_t)(0xC0 | (dst & 7) << 3 | (src & 7)));
+}
+
+// 81 /digit imm32: add 0, sub 5, cmp 7
+static void op_ri(Asm* a, int digit, int r, int32_t imm) {
+    rex(a, false, 0, r);
+    put8(a, 0x81);
+    put8(a, (uint8_t)(0xC0 | digit << 3 | (r & 7)));
+    put32(a, (uint32_t)imm);
+}
+
+static void imul_ri(Asm* a, int r, int32_t imm) {
+    rex(a, false, r, r);
+    put8(a, 0x69);
+    put8(a, (uint8_t)(0xC0 | (r & 7) << 3 | (r & 7)));
+    put32(a, (uint32_t)imm);
+}
+
+// F7 /digit: neg 3, idiv 7
+static void op_f7(Asm* a, int digit, int r) {
+    rex(a, false, 0, r);
+    put8(a, 0xF7);
+    put8(a, (uint8_t)(0xC0 | digit << 3 | (r & 7)));
+}
+
+static void mov_ri(Asm* a, int r, int32_t imm) {
+    rex(a, false, 0, r);
+    put8(a, (uint8_t)(0xB8 + (r & 7)));
+    put32(a, (uint32_t)imm);
+}
+
+static void mov_ri64(Asm* a, int r, uint64_t imm) {
+    rex(a, true, 0, r);
+    put8(a, (uint8_t)(0xB8 + (r & 7)));
+    put64(a, imm);
+}
+
+// op [base + disp32] 형식 (reg 필드는 레지스터 또는 /digit)
+static void op_mem(Asm* a, uint8_t op, int reg, int base, int32_t disp) {
+    rex(a, false, reg, base);
+    put8(a, op);
+    put8(a, (uint8_t)(0x80 | (reg & 7) << 3 | (base & 7)));
+    if ((base & 7) == RSP) put8(a, 0x24);   // rsp/r12는 SIB 필요
+    put32(a, (uint32_t)disp);
+}
+
+static void push_r(Asm* a, int r) {
+    if (r >= 8) put8(a, 0x41);
+    put8(a, (uint8_t)(0x50 + (r & 7)));
+}
+
+static void pop_r(Asm* a, int r) {
+    if (r >= 8) put8(a, 0x41);
+    put8(a, (uint8_t)(0x58 + (r & 7)));
+}
+
+static void call_abs(Asm* a, uint64_t target) {
+    mov_ri64(a, RAX, target);
+    put8(a, 0xFF); put8(a, 0xD0);   // call rax
+}
+
+// rel32 위치를 돌려줌 (patch_here 또는 fixup으로 채움)
+static size_t jcc(Asm* a, int cc) {
+    put8(a, 0x0F); put8(a, (uint8_t)(0x80 | cc));
+    put32(a, 0);
+    return a->len - 4;
+}
+
+static size_t jmp(Asm* a) {
+    put8(a, 0xE9);
+    put32(a, 0);
+    return a->len - 4;
+}
+
+static void patch_here(Asm* a, size_t pos) {
+    patch32(a, pos, (uint32_t)(a->len - (pos + 4)));
+}
+
+static void jump_to_pc(Asm* a, size_t pos, size_t pc) {
+    if (a->nomem || !grow((void**)&a->fixups, &a->fixups_cap, a->nfixups + 1, sizeof(Fixup))) { a->nomem = true; return; }
+    a->fixups[a->nfixups].pos = pos;
+    a->fixups[a->nfixups].pc = pc;
+    a->nfixups++;
+}
+
+static void jump_to_stub(Asm* a, size_t pos, const StmtInfo* at, VmError err, int32_t slot) {
+    if (a->nomem || !grow((void**)&a->stubs, &a->stubs_cap, a->nstubs + 1, sizeof(Stub))) { a->nomem = true; return; }
+    Stub* s = &a->stubs[a->nstubs++];
+    s->pos = pos; s->at = at; s->err = err; s->slot = slot; s->resume = at->end;
+}
+
+static void prologue(Asm* a) {
+    push_r(a, RBX); push_r(a, RBP); push_r(a, R12); push_r(a, R13); push_r(a, R14);   // 5개: 호출 시 16바이트 정렬
+    mov_rr64(a, R_VALUES, RDI);
+    mov_rr64(a, R_DEFINED, RSI);
+    mov_rr64(a, R_SPILL, RDX);
+    mov_rr64(a, R_VM, RCX);
+    mov_rr64(a, R_OUT, R8);
+}
+
+static void epilogue(Asm* a) {
+    pop_r(a, R14); pop_r(a, R13); pop_r(a, R12); pop_r(a, RBP); pop_r(a, RBX);
+    put8(a, 0xC3);
+}
+
+//========================================
+// Operand Stack
+//========================================
+
+static bool in_reg(const Asm* a, int d) {
+    return d >= a->base && d - a->base < NREGS;
+}
+
+// 깊이 d의 값을 담은 레지스터 (메모리에 있으면 scratch로 읽음)
+static int get(Asm* a, int d, int scratch) {
+    if (in_reg(a, d)) return STACK_REGS[d - a->base];
+    op_mem(a, 0x8B, scratch, R_SPILL, d * 4);
+    return scratch;
+}
+
+static void put(Asm* a, int d, int r) {
+    if (in_reg(a, d)) {
+        if (STACK_REGS[d - a->base] != r) op_rr(a, 0x89, r, STACK_REGS[d - a->base]);
+    } else {
+        op_mem(a, 0x89, r, R_SPILL, d * 4);
+    }
+}
+
+/**
+ * @brief ra = ra / rb 또는 ra % rb (rb != 0 확인 후). rb == -1은 arith.h 규칙대로 따로 처리
+ */
+static void emit_divmod(Asm* a, bool mod, int ra, int rb) {
+    op_ri(a, 7, rb, -1);                        // cmp rb, -1
+    size_t general = jcc(a, CC_NE);
+    if (mod) op_rr(a, 0x31, ra, ra);            // x % -1 = 0
+    else op_f7(a, 3, ra);                       // x / -1 = -x (INT32_MIN은 그대로)
+    size_t done = jmp(a);
+    patch_here(a, general);
+    if (ra != RAX) op_rr(a, 0x89, ra, RAX);
+    put8(a, 0x99);                              // cdq
+    op_f7(a, 7, rb);                            // idiv rb
+    int result = mod ? RDX : RAX;
+    if (ra != result) op_rr(a, 0x89, result, ra);
+    patch_here(a, done);
+}
+
+/**
+ * @brief 스택 top(깊이 d)에 상수와의 산술 적용 (PUSH_CONST + 연산자를 합친 형태)
+ */
+static void emit_arith_imm(Asm* a, uint8_t op, int d, int32_t c, const StmtInfo* cur) {
+    int r = get(a, d, RAX);
+    switch (op) {
+        case OP_ADD: op_ri(a, 0, r, c); break;
+        case OP_SUB: op_ri(a, 5, r, c); break;
+        case OP_MUL: imul_ri(a, r, c); break;
+        case OP_DIV:
+        case OP_MOD:
+            if (c == 0) {
+                jump_to_stub(a, jmp(a), cur, op == OP_DIV ? VM_ERR_DIV_ZERO : VM_ERR_MOD_ZERO, 0);
+                return;
+            }
+            if (c == -1) {
+                if (op == OP_MOD) op_rr(a, 0x31, r, r);
+                else op_f7(a, 3, r);
+                break;
+            }
+            if (r != RAX) op_rr(a, 0x89, r, RAX);
+            put8(a, 0x99);
+            mov_ri(a, R11, c);
+            op_f7(a, 7, R11);
+            r = op == OP_MOD ? RDX : RAX;
+            break;
+    }
+    put(a, d, r);
+}
+
+static void emit_arith(Asm* a, uint8_t op, int d, const StmtInfo* cur) {
+    int rb = get(a, d + 1, R11);
+    int ra = get(a, d, RAX);
+    switch (op) {
+        case OP_ADD: op_rr(a, 0x01, rb, ra); break;
+        case OP_SUB: op_rr(a, 0x29, rb, ra); break;
+        case OP_MUL: imul_rr(a, ra, rb); break;
+        case OP_DIV:
+        case OP_MOD:
+            op_rr(a, 0x85, rb, rb);             // test rb, rb
+            jump_to_stub(a, jcc(a, CC_E), cur, op == OP_DIV ? VM_ERR_DIV_ZERO : VM_ERR_MOD_ZERO, 0);
+            emit_divmod(a, op == OP_MOD, ra, rb);
+            break;
+    }
+    put(a, d, ra);
+}
+
+static bool is_arith(uint8_t op) {
+    return op == OP_ADD || op == OP_SUB || op == OP_MUL || op == OP_DIV || op == OP_MOD;
+}
+
+//========================================
+// Translation
+//========================================
+
+/**
+ * @brief 바이트코드를 번역. 지원하지 않거나 검증에 실패하면 false (a->nomem은 메모리 부족)
+ * @param native 각 바이트코드 위치의 기계어 오프셋 (합쳐져서 없는 위치는 SIZE_MAX)
+ */
+static bool translate(Asm* a, const Chunk* ch, size_t* native) {
+    const Instr* code = ch->code;
+    const StmtInfo* cur = NULL;
+    int depth = 0;
+
+    prologue(a);
+    for (size_t pc = 0; pc < ch->count; ++pc) {
+        native[pc] = a->len;
+        const Instr in = code[pc];
+        switch (in.op) {
+            case OP_STMT:
+                if (in.arg < 0 || (size_t)in.arg >= ch->nstmts) return false;
+                cur = &ch->stmts[in.arg];
+                if (cur->end <= pc || cur->end >= ch->count || cur->base > (uint32_t)ch->max_stack) return false;
+                depth = a->base = (int)cur->base;
+                break;
+
+            case OP_PUSH_CONST:
+                if (depth + 1 > ch->max_stack) return false;
+                if (depth >= 1 && pc + 1 < ch->count && is_arith(code[pc + 1].op)) {
+                    if (!cur) return false;
+                    emit_arith_imm(a, code[pc + 1].op, depth - 1, in.arg, cur);
+                    native[++pc] = SIZE_MAX;
+                    break;
+                }
+                if (in_reg(a, depth)) mov_ri(a, STACK_REGS[depth - a->base], in.arg);
+                else { op_mem(a, 0xC7, 0, R_SPILL, depth * 4); put32(a, (uint32_t)in.arg); }   // mov dword [spill + d*4], imm
+                depth++;
+                break;
+
+            case OP_LOAD_SLOT:
+                if (!cur || in.arg < 0 || in.arg > INT32_MAX / 4 || depth + 1 > ch->max_stack) return false;
+                op_mem(a, 0x80, 7, R_DEFINED, in.arg); put8(a, 0);     // cmp byte [defined + slot], 0
+                jump_to_stub(a, jcc(a, CC_E), cur, VM_ERR_UNDEFINED, in.arg);
+                if (in_reg(a, depth)) {
+                    op_mem(a, 0x8B, STACK_REGS[depth - a->base], R_VALUES, in.arg * 4);
+                } else {
+                    op_mem(a, 0x8B, RAX, R_VALUES, in.arg * 4);
+                    put(a, depth, RAX);
+                }
+                depth++;
+                break;
+
+            case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV: case OP_MOD:
+                if (!cur || depth - a->base < 2) return false;
+                emit_arith(a, in.op, depth - 2, cur);
+                depth--;
+                break;
+
+            case OP_STORE_SLOT: {
+                if (depth - a->base < 1 || in.arg < 0 || in.arg > INT32_MAX / 4) return false;
+                int r = get(a, --depth, RAX);
+                op_mem(a, 0x89, r, R_VALUES, in.arg * 4);
+                op_mem(a, 0xC6, 0, R_DEFINED, in.arg); put8(a, 1);     // mov byte [defined + slot], 1
+                break;
+            }
+
+            case OP_PRINT_INT: {
+                if (depth != a->base + 1) return false;    // 호출이 피연산자 레지스터를 덮어쓰므로 식 스택이 비는 경우만
+                int r = get(a, --depth, RAX);
+                if (r != RSI) op_rr(a, 0x89, r, RSI);
+                mov_rr64(a, RDI, R_OUT);
+                call_abs(a, (uint64_t)(uintptr_t)&out_int_line);
+                break;
+            }
+
+            case OP_PRINT_STR: {
+                if (depth != a->base || in.arg < 0 || (size_t)in.arg >= ch->nstrs) return false;
+                const StrRef* sr = &ch->strs[in.arg];
+                mov_rr64(a, RDI, R_OUT);
+                mov_ri64(a, RSI, (uint64_t)(uintptr_t)(ch->pool + sr->off));
+                mov_ri(a, RDX, (int32_t)sr->len);
+                call_abs(a, (uint64_t)(uintptr_t)&out_line);
+                break;
+            }
+
+            case OP_JUMP:
+                if (in.arg < 0 || (size_t)in.arg >= ch->count) return false;
+                jump_to_pc(a, jmp(a), (size_t)in.arg);
+                break;
+
+            case OP_JUMP_FALSE: {
+                if (depth - a->base < 1 || in.arg < 0 || (size_t)in.arg >= ch->count) return false;
+                int r = get(a, --depth, RAX);
+                op_rr(a, 0x85, r, r);                                   // test r, r
+                jump_to_pc(a, jcc(a, CC_E), (size_t)in.arg);
+                break;
+            }
+
+            case OP_REPEAT: {
+                // 횟수를 카운터 칸(메모리)에 두고, 0 이하면 블록을 건너뜀 (본문 문장의 base는 depth)
+                if (depth != a->base + 1 || in.arg < 0 || (size_t)in.arg >= ch->count) return false;
+                int r = get(a, depth - 1, RAX);
+                op_mem(a, 0x89, r, R_SPILL, (depth - 1) * 4);
+                op_rr(a, 0x85, r, r);
+                jump_to_pc(a, jcc(a, CC_LE), (size_t)in.arg);
+                break;
+            }
+
+            case OP_LOOP:
+                if (depth != a->base || depth < 1 || in.arg < 0 || (size_t)in.arg >= ch->count) return false;
+                op_mem(a, 0xFF, 1, R_SPILL, (depth - 1) * 4);         // dec dword [spill + (base-1)*4]
+                jump_to_pc(a, jcc(a, CC_G), (size_t)in.arg);
+                depth--;
+                break;
+
+            case OP_HALT:
+                epilogue(a);
+                break;
+
+            default:
+                return false;
+        }
+    }
+    epilogue(a);    // OP_HALT로 끝나지 않는 chunk 대비
+
+    // 오류 경로: 진단 후 다음 문장으로 (vm_report가 false면 오류 수 제한: 바로 반환)
+    for (size_t i = 0; i < a->nstubs; ++i) {
+        const Stub* s = &a->stubs[i];
+        patch_here(a, s->pos);
+        mov_rr64(a, RDI, R_VM);
+        mov_ri64(a, RSI, (uint64_t)(uintptr_t)s->at);
+        mov_ri(a, RDX, (int32_t)s->err);
+        mov_ri(a, RCX, s->slot);
+        call_abs(a, (uint64_t)(uintptr_t)&vm_report);
+        put8(a, 0x84); put8(a, 0xC0);   // test al, al
+        jump_to_pc(a, jcc(a, CC_NE), s->resume);
+        epilogue(a);
+    }
+
+    for (size_t i = 0; i < a->nfixups; ++i) {
+        size_t pc = a->fixups[i].pc;
+        if (native[pc] == SIZE_MAX || (code[pc].op != OP_STMT && code[pc].op != OP_HALT)) return false;
+        patch32(a, a->fixups[i].pos, (uint32_t)(native[pc] - (a->fixups[i].pos + 4)));
+    }
+    return !a->nomem;
+}
+
+bool jit_supported(void) {
+    return true;
+}
+
+JitCode* jit_compile(const Chunk* ch) {
+    if (ch->count == 0 || ch->max_stack < 0 || ch->max_stack > INT32_MAX / 4) return NULL;
+    if (ch->nsubs > 0 || ch->entry != 0) return NULL;  // 하위 루틴 프레임은 번역하지 않음
+    size_t* native = malloc(ch->count * sizeof(size_t));
+    if (!native) return NULL;
+
+    Asm a = {0};
+    bool ok = translate(&a, ch, native) && a.len < ((size_t)1 << 31);
+    free(native);
+    free(a.fixups);
+    free(a.stubs);
+
+    JitCode* jc = NULL;
+    if (ok) {
+        long page = sysconf(_SC_PAGESIZE);
+        size_t ps = page > 0 ? (size_t)page : 4096;
+        size_t size = (a.len + ps - 1) / ps * ps;
+        // W^X: 쓰기 가능한 상태로 채운 뒤 실행 전용으로 바꿈 (정책상 PROT_EXEC가 막히면 인터프리터 사용)
+        void* mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem != MAP_FAILED) {
+            memcpy(mem, a.buf, a.len);
+            jc = mprotect(mem, size, PROT_READ | PROT_EXEC) == 0 ? malloc(sizeof(*jc)) : NULL;
+            if (jc) {
+                jc->mem = mem;
+                jc->size = size;
+                jc->max_stack = ch->max_stack;
+                memcpy(&jc->fn, &mem, sizeof(jc->fn));
+            } else {
+                munmap(mem, size);
+            }
+        }
+    }
+    free(a.buf);
+    return jc;
+}
+
+bool jit_run(const JitCode* jc, VM* vm) {
+    if (!vm_reserve(vm, jc->max_stack)) return false;
+    jc->fn(vm->st->values, vm->st->defined, vm->stack, vm, vm->out);
+    return true;
+}
+
+void jit_free(JitCode* jc) {
+    if (!jc) return;
+    munmap(jc->mem, jc->size);
+    free(jc);
+}
+
+#else   // !JIT_X64: 항상 인터프리터로 실행
+
+struct JitCode {
+    int unused;
+};
+
+bool jit_supported(void) {
+    return false;
+}
+
+JitCode* jit_compile(const Chunk* ch) {
+    (void)ch;
+    return NULL;
+}
+
+bool jit_run(const JitCode* jc, VM* vm) {
+    (void)jc; (void)vm;
+    return false;
+}
+
+void jit_free(JitCode* jc) {
+    (void)jc;
+}
+
+#endif
@@ -2,40 +2,186 @@
 // System Includes
 //========================================
 #include "lexer.h"
-#include "morse_table.h"
+#include "morse_index.h"
 #include "diag.h"
+#include "profile.h"
 #include <ctype.h>
 #include <string.h>
+#include <stdlib.h>
+
+// 한 번에 읽는 모스 부호 런의 최대 길이 (넘치면 다음 토큰으로 이어짐)
+#define MORSE_RUN_MAX 15
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 /**
- * @brief 파일 포인터에서 다음 문자를 읽고 위치 정보를 업데이트
+ * @brief 버퍼에서 다음 문자를 읽고 위치 정보를 업데이트
  */
-static int nextc(Lexer* lx) {
-    int c = fgetc(lx->fp);
+static inline int nextc(Lexer* lx) {
+    if (lx->p >= lx->end) return EOF;
+    int c = (unsigned char)*lx->p++;
     if (c == '\n') { lx->line++; lx->col = 1; }
-    else if (c != EOF) { lx->col++; }
+    else { lx->col++; }
     return c;
 }
 
+//========================================
+// Source Loading (소스 적재)
+//========================================
+
+#ifndef _WIN32
 /**
- * @brief Lexer를 초기화하고 입력 파일오픈
+ * @brief 파이프처럼 크기를 알 수 없는 입력을 끝까지 읽어 힙 버퍼에 적재 (mmap 대체 경로)
+ */
+static bool load_by_read(Lexer* lx, int fd) {
+    size_t cap = 64 * 1024, len = 0;
+    char* data = malloc(cap);
+    if (!data) return false;
+    for (;;) {
+        if (len == cap) {
+            char* grown = realloc(data, cap * 2);
+            if (!grown) { free(data); return false; }
+            data = grown; cap *= 2;
+        }
+        ssize_t n = read(fd, data + len, cap - len);
+        if (n < 0) { free(data); return false; }
+        if (n == 0) break;
+        len += (size_t)n;
+    }
+    lx->buf = data; lx->size = len; lx->src = LX_SRC_HEAP;
+    return true;
+}
+
+/**
+ * @brief 파일 전체를 버퍼로 확보. 일반 파일은 mmap, 그 외(파이프 등)는 read()로 적재
+ * "-"는 표준 입력을 끝까지 읽는다.
+ */
+static bool load_source(Lexer* lx, const char* filename) {
+    if (strcmp(filename, "-") == 0) return load_by_read(lx, 0);
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat sb;
+    bool ok = false;
+    if (fstat(fd, &sb) == 0 && S_ISREG(sb.st_mode)) {
+        if (sb.st_size == 0) {
+            lx->buf = NULL; lx->size = 0; lx->src = LX_SRC_NONE;
+            ok = true;
+        } else {
+            void* map = mmap(NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+                madvise(map, (size_t)sb.st_size, MADV_SEQUENTIAL);
+                lx->buf = map; lx->size = (size_t)sb.st_size; lx->src = LX_SRC_MMAP;
+                ok = true;
+            }
+        }
+    }
+    if (!ok) ok = load_by_read(lx, fd);
+    close(fd);
+    return ok;
+}
+#else
+/**
+ * @brief mmap이 없는 환경: stdio로 파일 전체를 힙 버퍼에 적재
+ */
+static bool load_source(Lexer* lx, const char* filename) {
+    bool is_stdin = strcmp(filename, "-") == 0;
+    FILE* fp = is_stdin ? stdin : fopen(filename, "rb");
+    if (!fp) return false;
+    size_t cap = 64 * 1024, len = 0;
+    char* data = malloc(cap);
+    while (data) {
+        if (len == cap) {
+            char* grown = realloc(data, cap * 2);
+            if (!grown) { free(data); data = NULL; break; }
+            data = grown; cap *= 2;
+        }
+        size_t n = fread(data + len, 1, cap - len, fp);
+        len += n;
+        if (n == 0) break;
+    }
+    if (!is_stdin) fclose(fp);
+    if (!data) return false;
+    lx->buf = data; lx->size = len; lx->src = LX_SRC_HEAP;
+    return true;
+}
+#endif
+
+/**
+ * @brief Lexer를 초기화하고 입력 파일을 버퍼로 적재 ("-"이면 표준 입력 전체)
  * @return 성공 시 true, 실패 시 false.
  */
 bool lx_open(Lexer* lx, const char* filename) {
-    lx->filename = filename;
-    lx->fp = fopen(filename, "r");
-    if (!lx->fp) return false;
+    lx->filename = strcmp(filename, "-") == 0 ? LX_STDIN_NAME : filename;
+    if (!load_source(lx, filename)) return false;
+    lx->p = lx->buf;
+    lx->end = lx->buf + lx->size;
     lx->line = 1; lx->col = 1;
+    lx->scan = scan_ops();
     lx->cur = nextc(lx);
     return true;
 }
 
 /**
- * @brief Lexer 사용을 마친 후 파일을 종료
+ * @brief 이미 메모리에 있는 소스로 Lexer를 초기화 (벤치마크, 임베딩용)
+ * data는 lx_close 이후까지 호출자가 유지해야 하며 Lexer가 해제하지 않는다.
+ */
+void lx_open_buffer(Lexer* lx, const char* name, const char* data, size_t size) {
+    lx_open_slice(lx, name, data, size, 1, 1);
+}
+
+/**
+ * @brief 더 큰 소스의 일부분을 렉싱하도록 초기화 (병렬 파싱의 청크)
+ * line/col은 data[0]을 읽기 직전의 위치로, 전체를 처음부터 렉싱했을 때와 같은 위치를 보고하게 한다.
+ * 토큰 오프셋은 data 기준이다.
+ */
+void lx_open_slice(Lexer* lx, const char* name, const char* data, size_t size, int64_t line, int64_t col) {
+    lx->filename = name;
+    lx->buf = size ? data : NULL;
+    lx->size = size;
+    lx->src = size ? LX_SRC_BORROWED : LX_SRC_NONE;
+    lx->p = lx->buf;
+    lx->end = lx->buf + size;
+    lx->line = line; lx->col = col;
+    lx->scan = scan_ops();
+    lx->cur = nextc(lx);
+}
+
+/**
+ * @brief 소스 버퍼는 그대로 두고 처음 위치로 되돌림 (lx_open으로 연 경우에만, 슬라이스는 시작 위치를 모름)
+ */
+void lx_rewind(Lexer* lx) {
+    lx->p = lx->buf;
+    lx->line = 1; lx->col = 1;
+    lx->cur = nextc(lx);
+}
+
+/**
+ * @brief Lexer 사용을 마친 후 소스 버퍼를 해제
  */
 void lx_close(Lexer* lx) {
-    if (lx->fp) fclose(lx->fp);
-    lx->fp = NULL;
+#ifndef _WIN32
+    if (lx->src == LX_SRC_MMAP) munmap((void*)lx->buf, lx->size);
+#endif
+    if (lx->src == LX_SRC_HEAP) free((void*)lx->buf);
+    lx->buf = lx->p = lx->end = NULL;
+    lx->size = 0;
+    lx->src = LX_SRC_NONE;
+}
+
+/**
+ * @brief lookahead를 q 위치의 문자로 옮김 (nextc를 반복 호출한 것과 같은 결과)
+ * 현재 문자부터 q 직전까지 개행이 없어야 한다 (스캔 커널이 찾은 위치).
+ */
+static inline void skip_to(Lexer* lx, const char* q) {
+    lx->col += q - lx->p;
+    lx->p = q;
+    lx->cur = nextc(lx);
 }
 
 /**
@@ -47,119 +193,206 @@ static void skip_ws_and_comments(Lexer* lx) {
         while (lx->cur == ' ' || lx->cur == '\t' || lx->cur == '\r') {
             lx->cur = nextc(lx);
         }
-        // 주석: # ~ 라인 끝
+        // 주석: # ~ 라인 끝 (개행 위치를 한 번에 찾음)
         if (lx->cur == '#') {
-            while (lx->cur != '\n' && lx->cur != EOF) lx->cur = nextc(lx);
+            skip_to(lx, lx->scan->find_eol(lx->p, lx->end));
         } else break;
     }
 }
 
 /**
- * @brief 모스 부호 시퀀스(code)를 해당하는 단일 문자(char)로 디코딩
+ * @brief (길이, 비트 패턴) 인덱스를 해당하는 단일 문자(char)로 디코딩
+ *
+ * 인덱스는 (1 << 길이) | 선(-) 위치 비트마스크로, 스캔 커널이 돌려준 마스크로 바로 만든다.
+ * 연산자 우선 규칙은 morse_gen이 테이블 생성 시 이미 반영했다.
+ * @return 등록된 부호면 해당 문자, 아니면 '\0'.
  */
-static char decode_morse(const char* code) {
-    // 연산자와 '='는 동일한 모스 부호를 쓰는 알파벳보다 항상 우선한다.
-    if (strcmp(code, ".-.-.") == 0) return '+';   // +
-    if (strcmp(code, "-....-") == 0) return '-';  // -
-    if (strcmp(code, "-.-") == 0) return '*';     // * (K와 충돌)
-    if (strcmp(code, "-..-.") == 0) return '/';   // /
-    if (strcmp(code, "...-.-") == 0) return '%';  // %
-    if (strcmp(code, "-...-") == 0) return '=';   // =
+static inline char decode_morse(unsigned idx, int len) {
+    if (len > MORSE_INDEX_MAX_LEN) return '\0';
+    return MORSE_INDEX[idx];
+}
 
-    for (int i = 0; i < MORSE_TABLE_LEN; ++i) {
-        if (strcmp(MORSE_TABLE[i].code, code) == 0) return MORSE_TABLE[i].ch;
-    }
-    return '\0';
+/**
+ * @brief 현재 lookahead 문자(cur)의 소스 버퍼 내 오프셋 (EOF면 버퍼 크기)
+ */
+static inline uint64_t cur_off(const Lexer* lx) {
+    return lx->cur == EOF ? (uint64_t)lx->size : (uint64_t)(lx->p - lx->buf) - 1;
+}
+
+/**
+ * @brief 오류 수 제한에 도달하면 남은 입력을 버리고 EOF 토큰을 반환 (진단 폭주 시 바로 끝냄)
+ */
+static Token stop_lexing(Lexer* lx, Token tok) {
+    lx->p = lx->end;
+    lx->cur = EOF;
+    tok.kind = TK_EOF;
+    tok.len = 0;
+    tok.off = cur_off(lx);
+    return tok;
 }
 
 Token lx_next(Lexer* lx) {
-    skip_ws_and_comments(lx);
+    for (;;) {
+        skip_ws_and_comments(lx);
 
-    Token tok = { .kind = TK_EOF, .ch = 0, .line = lx->line, .col = lx->col };
+        Token tok = { .kind = TK_EOF, .ch = 0, .len = 0, .off = cur_off(lx) };
+        lx->tok_line = lx->line; lx->tok_col = lx->col;
 
-    if (lx->cur == EOF) { tok.kind = TK_EOF; return tok; }
+        if (lx->cur == EOF) { tok.kind = TK_EOF; return tok; }
 
-    //========================================
-    // 문자열 리터럴 인식 (TK_STRING)
-    //========================================
-    if (lx->cur == '"') {
-        tok.kind = TK_STRING;
-        int n = 0;
-        lx->cur = nextc(lx);
-        while (lx->cur != '"' && lx->cur != '\n' && lx->cur != EOF) {
-            if (n < (int)sizeof(tok.text)-1) tok.text[n++] = (char)lx->cur;
-            lx->cur = nextc(lx);
-        }
-        tok.text[n] = '\0';
-        if (lx->cur != '"') {
-            diag_error(lx->filename, tok.line, tok.col, "unterminated string literal");
-        } else {
+        //========================================
+        // 문자열 리터럴 인식 (TK_STRING)
+        // 스팬은 따옴표를 제외한 내용 부분만 가리킨다 (길이 제한 없음)
+        //========================================
+        if (lx->cur == '"') {
+            tok.kind = TK_STRING;
             lx->cur = nextc(lx);
+            tok.off = cur_off(lx);
+            if (lx->cur != '"' && lx->cur != '\n' && lx->cur != EOF) {
+                skip_to(lx, lx->scan->find_quote_or_eol(lx->p, lx->end));
+            }
+            tok.len = (uint32_t)(cur_off(lx) - tok.off);
+            if (lx->cur != '"') {
+                diag_error(DIAG_STRING, lx->filename, lx->tok_line, lx->tok_col, "unterminated string literal");
+            } else {
+                lx->cur = nextc(lx);
+            }
+            return tok;
         }
-        return tok;
-    }
 
-    //========================================
-    // 단일 문자 / 구분자 인식
-    //========================================
-    if (lx->cur == '\n') { lx->cur = nextc(lx); tok.kind = TK_NEWLINE; return tok; }
-    if (lx->cur == '/') { lx->cur = nextc(lx); tok.kind = TK_SLASH; return tok; }
-    if (lx->cur == '=') { lx->cur = nextc(lx); tok.kind = TK_EQ; return tok; }
-    if (lx->cur == ';') { lx->cur = nextc(lx); tok.kind = TK_SEMI; return tok; }
-
-    //========================================
-    // 모스 부호 인식 및 디코딩
-    //========================================
-    if (lx->cur == '.' || lx->cur == '-') {
-        char buf[16]; int n = 0;
-        while ((lx->cur == '.' || lx->cur == '-') && n < (int)sizeof(buf)-1) {
-            buf[n++] = (char)lx->cur;
-            lx->cur = nextc(lx);
-        }
+        //========================================
+        // 단일 문자 / 구분자 인식
+        //========================================
+        tok.len = 1;
+        if (lx->cur == '\n') { lx->cur = nextc(lx); tok.kind = TK_NEWLINE; return tok; }
+        if (lx->cur == '/') { lx->cur = nextc(lx); tok.kind = TK_SLASH; return tok; }
+        if (lx->cur == '=') { lx->cur = nextc(lx); tok.kind = TK_EQ; return tok; }
+        if (lx->cur == ';') { lx->cur = nextc(lx); tok.kind = TK_SEMI; return tok; }
 
-        buf[n] = '\0';
-        char ch = decode_morse(buf);
+        //========================================
+        // 모스 부호 인식 및 디코딩
+        //========================================
+        if (lx->cur == '.' || lx->cur == '-') {
+            // 현재 문자(p - 1)부터 점/선 런을 한 번에 분류
+            unsigned dashes = 0;
+            int n = (int)lx->scan->morse_run(lx->p - 1, lx->end, MORSE_RUN_MAX, &dashes);
+            unsigned idx = (1u << n) | dashes;
+            skip_to(lx, lx->p - 1 + n);
+            tok.len = (uint32_t)n;
 
-        if (ch == '\0') {
-            char msg[64];
-            snprintf(msg, sizeof(msg), "unknown morse sequence '%s'", buf);
-            diag_error(lx->filename, tok.line, tok.col, msg);
-            // 에러 토큰 대신, 진행을 위해 TK_LETTER('?')
-            tok.kind = TK_LETTER; tok.ch = '?';
+            char ch = decode_morse(idx, n);
+
+            if (ch == '\0') {
+                char msg[64];
+                snprintf(msg, sizeof(msg), "unknown morse sequence '%.*s'", n, lx->buf + tok.off);
+                diag_error(DIAG_LEX, lx->filename, lx->tok_line, lx->tok_col, msg);
+                if (diag_stopped()) return stop_lexing(lx, tok);
+                // 에러 토큰 대신, 진행을 위해 TK_LETTER('?')
+                tok.kind = TK_LETTER; tok.ch = '?';
+                return tok;
+            }
+
+            if (ch == '+') {
+                tok.kind = TK_PLUS;
+            } else if (ch == '-') {
+                tok.kind = TK_MINUS;
+            } else if (ch == '*') {
+                tok.kind = TK_STAR;
+            } else if (ch == '%') {
+                tok.kind = TK_PERCENT;
+            } else if (ch == '=') {
+                tok.kind = TK_EQ;
+            } else if (ch == '/') {
+                tok.kind = TK_DIV;
+                tok.ch = ch;
+            } else {
+                //========================================
+                // 나머지 문자 (A-Z, 0-9, 한글 초성 매핑 문자 등)
+                //========================================
+                tok.kind = TK_LETTER;
+                tok.ch = ch;
+            }
             return tok;
         }
 
-        if (ch == '+') {
-            tok.kind = TK_PLUS;
-        } else if (ch == '-') {
-            tok.kind = TK_MINUS;
-        } else if (ch == '*') {
-            tok.kind = TK_STAR;
-        } else if (ch == '%') {
-            tok.kind = TK_PERCENT;
-        } else if (ch == '=') {
-            tok.kind = TK_EQ;
-        } else if (ch == '/') {
-            tok.kind = TK_DIV;
-            tok.ch = ch;
-        } else {
-            //========================================
-            // 나머지 문자 (A-Z, 0-9, 한글 초성 매핑 문자 등)
-            //========================================
-            tok.kind = TK_LETTER;
-            tok.ch = ch;
+        //========================================
+        // 알 수 없는 문자 처리 → 무시하고 계속 (재귀 대신 루프로 다음 토큰을 찾음)
+        //========================================
+        {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "unexpected character '%c'", lx->cur);
+            diag_error(DIAG_LEX, lx->filename, lx->tok_line, lx->tok_col, msg);
+            if (diag_stopped()) return stop_lexing(lx, tok);
+            lx->cur = nextc(lx);
         }
-        return tok;
     }
+}
+
+/**
+ * @brief 토큰 스팬이 가리키는 원문(문자열 리터럴 내용 등)을 반환
+ * 반환된 포인터는 lx_close 전까지 유효하며 null-terminated가 아니다. 길이는 tok->len.
+ */
+const char* lx_token_text(const Lexer* lx, const Token* tok) {
+    return lx->buf ? lx->buf + tok->off : "";
+}
+
+//========================================
+// Token Stream (SoA 일괄 토큰화)
+//========================================
+
+static bool ts_grow(TokenStream* ts) {
+    size_t cap = ts->cap ? ts->cap * 2 : 1024;
+    uint8_t* kinds = realloc(ts->kinds, cap * sizeof(*kinds));
+    if (kinds) ts->kinds = kinds;
+    char* chs = realloc(ts->chs, cap * sizeof(*chs));
+    if (chs) ts->chs = chs;
+    uint32_t* lens = realloc(ts->lens, cap * sizeof(*lens));
+    if (lens) ts->lens = lens;
+    uint64_t* offs = realloc(ts->offs, cap * sizeof(*offs));
+    if (offs) ts->offs = offs;
+    int64_t* lines = realloc(ts->lines, cap * sizeof(*lines));
+    if (lines) ts->lines = lines;
+    int64_t* cols = realloc(ts->cols, cap * sizeof(*cols));
+    if (cols) ts->cols = cols;
+    if (!kinds || !chs || !lens || !offs || !lines || !cols) return false;
+    ts->cap = cap;
+    return true;
+}
 
-    //========================================
-    // 알 수 없는 문자 처리 → 무시하고 계속
-    //========================================
-    {
-        char msg[64];
-        snprintf(msg, sizeof(msg), "unexpected character '%c'", lx->cur);
-        diag_error(lx->filename, tok.line, tok.col, msg);
-        lx->cur = nextc(lx);
-        return lx_next(lx);
+/**
+ * @brief 파일 전체를 한 번에 토큰화하여 구조체 배열(SoA) 형태의 토큰 스트림 생성
+ * 마지막 항목은 항상 TK_EOF. 스팬은 lx의 소스 버퍼를 가리키므로 lx_close 전까지만 유효.
+ * @return 성공 시 true, 메모리 부족 시 false.
+ */
+bool lx_tokenize(Lexer* lx, TokenStream* ts) {
+    memset(ts, 0, sizeof(*ts));
+    ts->filename = lx->filename;
+    ts->src = lx->buf;
+    PROF_ENTER(PROF_LEX);
+    for (;;) {
+        Token tok = lx_next(lx);
+        PROF_COUNT(tokens, 1);
+        if (ts->count == ts->cap && !ts_grow(ts)) { PROF_LEAVE(); return false; }
+        size_t i = ts->count++;
+        ts->kinds[i] = tok.kind;
+        ts->chs[i] = tok.ch;
+        ts->lens[i] = tok.len;
+        ts->offs[i] = tok.off;
+        ts->lines[i] = lx->tok_line;
+        ts->cols[i] = lx->tok_col;
+        if (tok.kind == TK_EOF) { PROF_LEAVE(); return true; }
     }
 }
+
+/**
+ * @brief 소스 버퍼가 차지하는 바이트 수 (--profile 메모리 집계용)
+ */
+size_t lx_memory(const Lexer* lx) {
+    return lx->src == LX_SRC_BORROWED ? 0 : lx->size;
+}
+
+void ts_free(TokenStream* ts) {
+    free(ts->kinds); free(ts->chs); free(ts->lens);
+    free(ts->offs); free(ts->lines); free(ts->cols);
+    memset(ts, 0, sizeof(*ts));
+}
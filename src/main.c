@@ -1,11 +1,188 @@
+#include "batch.h"
+#include "diag.h"
+#include "emit_c.h"
 #include "interp.h"
+#include "output.h"
+#include "parallel.h"
+#include "watch.h"
+#include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+
+static void usage(const char* prog) {
+    fprintf(stderr, "usage: %s [-O] [--opt-report] [--dump-bytecode] [--parallel[=N]] [--pipeline] [--profile] [--flush=full|line|explicit] [--no-cache] [--jit] [--emit-c[=FILE]] [--watch] [--load-state=FILE] [--save-state=FILE] [--jobs=N] [--manifest=FILE] [--diag-format=text|json] [--diag-fold] [--max-errors=N] <file.dit | -> ...\n", prog);
+}
+
+/**
+ * @brief 배치 목록에서 표준 입력("-") 항목 수
+ */
+static int stdin_entries(const BatchList* files) {
+    int n = 0;
+    for (int i = 0; i < files->count; ++i) n += strcmp(files->files[i], "-") == 0;
+    return n;
+}
 
 int main(int argc, char** argv) {
-    if (argc < 2) {
-        fprintf(stderr, "usage: %s <file.dit>\n", argv[0]);
-        return 1;
+    RunOptions opts = {0};
+    BatchList files; batch_list_init(&files);
+    int jobs = 0;
+    bool manifest = false;
+    const char* emit_c = NULL;  // --emit-c: C 출력 경로 ("-"이면 표준 출력)
+    bool watch = false;
+    DiagConfig diag = { .format = DIAG_FORMAT_TEXT };
+    bool diag_opts = false;     // 기본 진단 형식이 아닌지 (--watch/--emit-c와 함께 쓸 수 없음)
+    int status = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--dump-bytecode") == 0) {
+            opts.dump_bytecode = true;
+        } else if (strcmp(argv[i], "-O") == 0) {
+            opts.optimize = true;
+        } else if (strcmp(argv[i], "--opt-report") == 0) {
+            opts.optimize = true;
+            opts.opt_report = true;
+        } else if (strcmp(argv[i], "--parallel") == 0) {
+            opts.parallel = par_default_threads();
+        } else if (strncmp(argv[i], "--parallel=", 11) == 0) {
+            opts.parallel = atoi(argv[i] + 11);
+            if (opts.parallel < 1) {
+                fprintf(stderr, "invalid thread count: %s\n", argv[i] + 11);
+                usage(argv[0]);
+                goto done;
+            }
+        } else if (strcmp(argv[i], "--pipeline") == 0) {
+            opts.pipeline = true;
+        } else if (strcmp(argv[i], "--profile") == 0) {
+#ifdef DAHDIT_PROFILE
+            opts.profile = true;
+#else
+            fprintf(stderr, "--profile is not available: rebuild with -DDAHDIT_PROFILE=ON\n");
+            goto done;
+#endif
+        } else if (strcmp(argv[i], "--jit") == 0) {
+            opts.jit = true;
+        } else if (strcmp(argv[i], "--emit-c") == 0) {
+            emit_c = "-";
+        } else if (strncmp(argv[i], "--emit-c=", 9) == 0) {
+            emit_c = argv[i] + 9;
+        } else if (strcmp(argv[i], "--watch") == 0) {
+            watch = true;
+        } else if (strncmp(argv[i], "--save-state=", 13) == 0) {
+            opts.save_state = argv[i] + 13;
+        } else if (strcmp(argv[i], "--save-state") == 0 && i + 1 < argc) {
+            opts.save_state = argv[++i];
+        } else if (strncmp(argv[i], "--load-state=", 13) == 0) {
+            opts.load_state = argv[i] + 13;
+        } else if (strcmp(argv[i], "--load-state") == 0 && i + 1 < argc) {
+            opts.load_state = argv[++i];
+        } else if (strcmp(argv[i], "--no-cache") == 0) {
+            opts.no_cache = true;
+        } else if (strncmp(argv[i], "--jobs=", 7) == 0) {
+            jobs = atoi(argv[i] + 7);
+            if (jobs < 1) {
+                fprintf(stderr, "invalid job count: %s\n", argv[i] + 7);
+                usage(argv[0]);
+                goto done;
+            }
+        } else if (strncmp(argv[i], "--manifest=", 11) == 0) {
+            manifest = true;
+            if (!batch_list_load(&files, argv[i] + 11)) {
+                fprintf(stderr, "Cannot read manifest: %s\n", argv[i] + 11);
+                goto done;
+            }
+        } else if (strncmp(argv[i], "--diag-format=", 14) == 0) {
+            if (strcmp(argv[i] + 14, "text") == 0) {
+                diag.format = DIAG_FORMAT_TEXT;
+            } else if (strcmp(argv[i] + 14, "json") == 0) {
+                diag.format = DIAG_FORMAT_JSON;
+                diag_opts = true;
+            } else {
+                fprintf(stderr, "unknown diagnostic format: %s\n", argv[i] + 14);
+                usage(argv[0]);
+                goto done;
+            }
+        } else if (strcmp(argv[i], "--diag-fold") == 0) {
+            diag.fold = true;
+            diag_opts = true;
+        } else if (strncmp(argv[i], "--max-errors=", 13) == 0) {
+            char* end;
+            unsigned long n = strtoul(argv[i] + 13, &end, 10);
+            if (end == argv[i] + 13 || *end != '\0' || argv[i][13] == '-' || n > 1000000000UL) {
+                fprintf(stderr, "invalid error limit: %s\n", argv[i] + 13);
+                usage(argv[0]);
+                goto done;
+            }
+            diag.max_errors = (unsigned)n;
+            diag_opts = diag_opts || n > 0;
+        } else if (strncmp(argv[i], "--flush=", 8) == 0) {
+            if (!out_parse_policy(argv[i] + 8, &opts.flush)) {
+                fprintf(stderr, "unknown flush policy: %s\n", argv[i] + 8);
+                usage(argv[0]);
+                goto done;
+            }
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            fprintf(stderr, "unknown option: %s\n", argv[i]);
+            usage(argv[0]);
+            goto done;
+        } else if (!batch_list_add(&files, argv[i])) {
+            fprintf(stderr, "Out of memory\n");
+            goto done;
+        }
+    }
+
+    if (diag_opts && (watch || emit_c)) {
+        // --watch는 진단을 문장별로 다시 내보내고, --emit-c는 프로그램을 실행하지 않는다
+        fprintf(stderr, "--diag-format/--diag-fold/--max-errors cannot be used with --watch/--emit-c\n");
+        goto done;
+    }
+    diag_configure(&diag);
+
+    bool state = opts.load_state || opts.save_state;
+    if (state && (watch || emit_c || files.count != 1 || manifest || jobs > 0 || opts.dump_bytecode)) {
+        // 상태 이미지는 한 프로그램의 변수 전체이므로 실제로 실행하는 단일 프로그램에만
+        fprintf(stderr, "--load-state/--save-state take a single file (no --watch/--emit-c/--dump-bytecode/--jobs/--manifest)\n");
+        goto done;
     }
-    if (!run_program(argv[1])) return 1;
-    return 0;
+
+    if (watch) {
+        // 기본 모드(문장 단위 실행)만 문장별 기록으로 이어서 실행할 수 있다
+        if (files.count != 1 || manifest || jobs > 0 || strcmp(files.files[0], "-") == 0 || emit_c ||
+            opts.dump_bytecode || opts.optimize || opts.parallel > 0 || opts.jit || opts.profile) {
+            fprintf(stderr, "--watch takes a single file in the default mode (no -O/--parallel/--jit/--dump-bytecode/--profile/--emit-c)\n");
+            goto done;
+        }
+        watch_run(files.files[0]);
+    } else if (emit_c) {
+        // 실행하지 않고 C로 변환만 한다
+        if (files.count != 1 || manifest || opts.dump_bytecode || opts.profile) {
+            fprintf(stderr, "--emit-c takes a single file and no --dump-bytecode/--profile\n");
+            goto done;
+        }
+        bool to_stdout = strcmp(emit_c, "-") == 0;
+        FILE* out = to_stdout ? stdout : fopen(emit_c, "w");
+        if (!out) {
+            fprintf(stderr, "Cannot write: %s\n", emit_c);
+            goto done;
+        }
+        if (emit_c_file(files.files[0], &opts, out)) status = 0;
+        if (!to_stdout && fclose(out) != 0) status = 1;
+        if (status != 0 && !to_stdout) remove(emit_c);
+    } else if (files.count == 1 && jobs == 0 && !manifest) {
+        if (run_program(files.files[0], &opts)) status = 0;
+    } else if (files.count == 0 && !manifest) {
+        usage(argv[0]);
+    } else if (opts.dump_bytecode || opts.opt_report || opts.profile) {
+        // 이 옵션들은 stdout/stderr에 직접 쓰므로 여러 프로그램의 출력이 섞인다
+        fprintf(stderr, "--dump-bytecode, --opt-report and --profile take a single file\n");
+    } else if (stdin_entries(&files) > 1) {
+        // 표준 입력은 한 번만 읽을 수 있으므로 두 번째 "-"는 빈 프로그램이 된다
+        fprintf(stderr, "'-' (standard input) can be given only once\n");
+    } else {
+        if (batch_run(&files, jobs > 0 ? jobs : par_default_threads(), &opts)) status = 0;
+    }
+
+done:
+    diag_sync();
+    batch_list_free(&files);
+    return status;
 }
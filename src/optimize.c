@@ -0,0 +1,656 @@
+//========================================
+// System Includes
+//========================================
+#include "optimize.h"
+#include "arith.h"
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+//========================================
+// 분석 상태
+//
+// 문장 순서대로 한 번 훑는다. 블록(WHILE/IF/REPEAT ... END)이 있으므로 분석은 보수적이다.
+// - 정방향: 상수 전파 + 폴딩, 이용 가능한 식(available expression) 기반 공통 부분식 제거.
+//   상수와 이용 가능한 식은 기본 블록(제어 문장 사이의 직선 구간) 안에서만 유효하다 (epoch).
+//   변수는 한 번 정의되면 미정의로 돌아가지 않으므로, "정의됨"은 그것이 확인된 블록 본문이 닫힐 때까지 유효하다 (region).
+// - 역방향: 변수 생존(liveness) 분석으로 읽히지 않는 VAR 저장 제거. 제어 문장을 지나면 모든 변수를 살아 있다고 본다.
+// 실패할 수 있는 연산(미정의 변수 참조, 0이 될 수 있는 나눗셈/나머지)은 진단이 달라지지 않도록
+// 접거나 제거하지 않는다.
+// 하위 루틴(SUB ... END) 본문은 호출될 때 실행되므로 분석하지 않고 그대로 둔다. 본문의 VAR는 지역 변수라
+// 호출이 전역 변수를 바꾸지는 않지만, 전역을 읽거나 출력할 수 있으므로 호출은 실패할 수 있는 값으로 보고
+// 호출이 있는 문장 앞의 저장은 살려 둔다.
+// 배열은 이름의 뜻이 ARRAY 문장 위치에 따라 바뀌고 원소별로 바뀌므로, 배열로 선언되는 이름이 나오는 문장은
+// 단순화하거나 제거하지 않는 장벽으로 둔다 (대입 대상인 변수만 알 수 없는 값으로 바꿈).
+//========================================
+
+typedef enum { DEF_NO = 0, DEF_MAYBE, DEF_YES } DefState;
+
+typedef struct {
+    uint8_t def;        // DefState
+    bool known;         // 값이 컴파일 시 상수로 알려짐 (def == DEF_YES 함의, known_epoch가 현재일 때만)
+    int32_t value;
+    uint32_t ver;       // 저장될 때마다 증가 (이용 가능한 식 무효화용)
+    uint32_t known_epoch;
+    uint32_t def_depth; // DEF_YES가 확인된 region 깊이와 id
+    uint32_t def_region;
+} SlotState;
+
+// RPN 슬라이스 하나(부분식)에 대한 평가 정보
+typedef struct {
+    int start;          // 결과 배열 내 시작 위치
+    bool is_const;
+    int32_t value;
+    bool may_fail;      // 실행 시 진단이 발생할 수 있음
+    uint32_t hash;
+} Val;
+
+// 이용 가능한 식: holder 변수가 items 슬라이스의 값을 들고 있음
+typedef struct {
+    uint32_t hash;
+    int next;           // 같은 버킷의 다음 항목 (-1 끝)
+    size_t items_off;   // item 풀 내 위치
+    int items_len;
+    int32_t holder;
+    uint32_t holder_ver;
+    uint32_t epoch;     // 등록된 기본 블록
+    size_t deps_off;    // 피연산자 (slot, ver) 쌍 풀 내 위치
+    int ndeps;
+} Avail;
+
+typedef struct {
+    int32_t slot;
+    uint32_t ver;
+} Dep;
+
+typedef struct {
+    const SymTab* st;
+    const char* filename;
+    FILE* report;
+    OptStats* stats;
+    bool* array_name;   // 어디서든 ARRAY로 선언되는 이름
+
+    SlotState* slots;
+    int nslots;
+    uint32_t epoch;     // 현재 기본 블록 번호
+    uint32_t* regions;  // 열린 블록 본문 id (0은 프로그램 전체)
+    size_t depth, regions_cap;
+    uint32_t next_region;
+
+    Val* vals;          // 표현식 평가용 스택
+    int vals_cap;
+
+    Avail* avail;
+    size_t navail, avail_cap;
+    int* buckets;       // 해시 버킷 → Avail 인덱스
+    uint32_t nbuckets;  // 2의 거듭제곱
+    ExprItem* items;    // Avail 슬라이스 풀
+    size_t nitems, items_cap;
+    Dep* deps;
+    size_t ndeps, deps_cap;
+} Opt;
+
+static bool grow(void** arr, size_t* cap, size_t need, size_t elem) {
+    if (need <= *cap) return true;
+    size_t n = *cap ? *cap : 64;
+    while (n < need) n *= 2;
+    void* p = realloc(*arr, n * elem);
+    if (!p) return false;
+    *arr = p; *cap = n;
+    return true;
+}
+
+static uint32_t mix(uint32_t h, uint32_t v) {
+    h ^= v + 0x9e3779b9u + (h << 6) + (h >> 2);
+    return h;
+}
+
+static uint32_t item_hash(const ExprItem* item) {
+    uint32_t payload = item->kind == EXPR_ITEM_NUMBER ? (uint32_t)item->as.number :
+                       item->kind == EXPR_ITEM_VAR ? (uint32_t)item->as.slot :
+                       item->kind == EXPR_ITEM_CALL ? mix((uint32_t)item->as.call.slot, (uint32_t)item->as.call.argc) :
+                       (uint32_t)item->as.op;
+    return mix((uint32_t)item->kind * 0x85ebca6bu, payload);
+}
+
+static bool items_equal(const ExprItem* a, const ExprItem* b, int n) {
+    for (int i = 0; i < n; ++i) {
+        if (a[i].kind != b[i].kind) return false;
+        switch (a[i].kind) {
+            case EXPR_ITEM_NUMBER: if (a[i].as.number != b[i].as.number) return false; break;
+            case EXPR_ITEM_VAR: if (a[i].as.slot != b[i].as.slot) return false; break;
+            case EXPR_ITEM_OP: if (a[i].as.op != b[i].as.op) return false; break;
+            case EXPR_ITEM_CALL:
+                if (a[i].as.call.slot != b[i].as.call.slot || a[i].as.call.argc != b[i].as.call.argc) return false;
+                break;
+        }
+    }
+    return true;
+}
+
+static bool is_op_fallible(ExprOp op) {
+    return op == EXPR_OP_DIV || op == EXPR_OP_MOD;
+}
+
+static int32_t fold_op(ExprOp op, int32_t lhs, int32_t rhs) {
+    switch (op) {
+        case EXPR_OP_ADD: return ar_add(lhs, rhs);
+        case EXPR_OP_SUB: return ar_sub(lhs, rhs);
+        case EXPR_OP_MUL: return ar_mul(lhs, rhs);
+        case EXPR_OP_DIV: return ar_div(lhs, rhs);
+        case EXPR_OP_MOD: return ar_mod(lhs, rhs);
+    }
+    return 0;
+}
+
+
+//========================================
+// Available Expressions (공통 부분식)
+//========================================
+
+static bool avail_valid(const Opt* o, const Avail* a) {
+    if (a->epoch != o->epoch || o->slots[a->holder].ver != a->holder_ver) return false;
+    for (int i = 0; i < a->ndeps; ++i) {
+        const Dep* d = &o->deps[a->deps_off + (size_t)i];
+        if (o->slots[d->slot].ver != d->ver) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 슬라이스와 같은 식을 들고 있는 유효한 변수를 찾음
+ * @return holder 슬롯, 없으면 -1.
+ */
+static int32_t avail_find(const Opt* o, const ExprItem* items, int len, uint32_t hash) {
+    if (o->nbuckets == 0) return -1;
+    for (int e = o->buckets[hash & (o->nbuckets - 1)]; e >= 0; e = o->avail[e].next) {
+        const Avail* a = &o->avail[e];
+        if (a->hash != hash || a->items_len != len) continue;
+        if (!items_equal(o->items + a->items_off, items, len)) continue;
+        if (avail_valid(o, a)) return a->holder;
+    }
+    return -1;
+}
+
+static bool avail_rehash(Opt* o, uint32_t nbuckets) {
+    int* buckets = malloc(nbuckets * sizeof(int));
+    if (!buckets) return false;
+    for (uint32_t i = 0; i < nbuckets; ++i) buckets[i] = -1;
+    for (size_t e = 0; e < o->navail; ++e) {
+        uint32_t b = o->avail[e].hash & (nbuckets - 1);
+        o->avail[e].next = buckets[b];
+        buckets[b] = (int)e;
+    }
+    free(o->buckets);
+    o->buckets = buckets;
+    o->nbuckets = nbuckets;
+    return true;
+}
+
+/**
+ * @brief VAR holder = items 가 실패 없이 실행된 뒤, 그 식을 이용 가능한 식으로 등록
+ */
+static bool avail_add(Opt* o, const ExprItem* items, int len, uint32_t hash, int32_t holder) {
+    if (o->navail + 1 > (size_t)o->nbuckets && !avail_rehash(o, o->nbuckets ? o->nbuckets * 2 : 256)) return false;
+    if (!grow((void**)&o->avail, &o->avail_cap, o->navail + 1, sizeof(Avail))) return false;
+    if (!grow((void**)&o->items, &o->items_cap, o->nitems + (size_t)len, sizeof(ExprItem))) return false;
+
+    int ndeps = 0;
+    for (int i = 0; i < len; ++i) ndeps += items[i].kind == EXPR_ITEM_VAR;
+    if (!grow((void**)&o->deps, &o->deps_cap, o->ndeps + (size_t)ndeps, sizeof(Dep))) return false;
+
+    Avail* a = &o->avail[o->navail];
+    a->hash = hash;
+    a->items_off = o->nitems;
+    a->items_len = len;
+    a->holder = holder;
+    a->holder_ver = o->slots[holder].ver;
+    a->epoch = o->epoch;
+    a->deps_off = o->ndeps;
+    a->ndeps = ndeps;
+    memcpy(o->items + o->nitems, items, (size_t)len * sizeof(ExprItem));
+    o->nitems += (size_t)len;
+    for (int i = 0; i < len; ++i) {
+        if (items[i].kind != EXPR_ITEM_VAR) continue;
+        o->deps[o->ndeps].slot = items[i].as.slot;
+        o->deps[o->ndeps].ver = o->slots[items[i].as.slot].ver;
+        o->ndeps++;
+    }
+
+    uint32_t b = hash & (o->nbuckets - 1);
+    a->next = o->buckets[b];
+    o->buckets[b] = (int)o->navail++;
+    return true;
+}
+
+
+//========================================
+// Forward Pass (상수 전파/폴딩, 공통 부분식 제거)
+//========================================
+
+static bool is_known(const Opt* o, int32_t slot) {
+    return o->slots[slot].known && o->slots[slot].known_epoch == o->epoch;
+}
+
+static bool is_defined(const Opt* o, int32_t slot) {
+    const SlotState* x = &o->slots[slot];
+    return x->def == DEF_YES && x->def_depth <= o->depth && o->regions[x->def_depth] == x->def_region;
+}
+
+static void set_defined(Opt* o, int32_t slot) {
+    SlotState* x = &o->slots[slot];
+    if (is_defined(o, slot)) return;    // 바깥 region에서 확인된 사실을 좁히지 않음
+    x->def = DEF_YES;
+    x->def_depth = (uint32_t)o->depth;
+    x->def_region = o->regions[o->depth];
+}
+
+static bool push_region(Opt* o) {
+    if (!grow((void**)&o->regions, &o->regions_cap, o->depth + 2, sizeof(uint32_t))) return false;
+    o->regions[++o->depth] = ++o->next_region;
+    return true;
+}
+
+static void pop_region(Opt* o) {
+    if (o->depth > 0) o->depth--;
+}
+
+/**
+ * @brief 표현식 하나를 제자리에서 단순화
+ *
+ * RPN을 앞에서부터 읽으며 결과를 같은 배열 앞쪽에 다시 쓴다 (결과 길이 ≤ 원래 길이).
+ * 각 스택 값은 결과 배열에서 자신의 부분식이 차지하는 슬라이스를 기억한다.
+ *
+ * @param res 식 전체의 평가 정보.
+ */
+static bool simplify_expr(Opt* o, Expr* expr, Val* res) {
+    if (expr->count > o->vals_cap) {
+        size_t cap = (size_t)o->vals_cap;
+        if (!grow((void**)&o->vals, &cap, (size_t)expr->count, sizeof(Val))) return false;
+        o->vals_cap = (int)cap;
+    }
+
+    ExprItem* items = expr->items;
+    Val* vals = o->vals;
+    int n = 0, sp = 0;
+
+    for (int i = 0; i < expr->count; ++i) {
+        ExprItem item = items[i];
+        Val v = { .start = n, .is_const = false, .value = 0, .may_fail = false };
+
+        if (item.kind == EXPR_ITEM_VAR && is_known(o, item.as.slot)) {
+            item.kind = EXPR_ITEM_NUMBER;
+            item.as.number = o->slots[item.as.slot].value;
+            o->stats->propagated++;
+        }
+
+        if (item.kind == EXPR_ITEM_NUMBER) {
+            v.is_const = true;
+            v.value = item.as.number;
+            items[n++] = item;
+            v.hash = item_hash(&item);
+        } else if (item.kind == EXPR_ITEM_VAR) {
+            v.may_fail = !is_defined(o, item.as.slot);
+            items[n++] = item;
+            v.hash = item_hash(&item);
+        } else if (item.kind == EXPR_ITEM_CALL) {
+            // 인자 슬라이스 뒤에 호출을 붙임. 결과는 알 수 없고 호출 자체가 부수 효과를 낼 수 있음
+            sp -= item.as.call.argc;
+            v.start = item.as.call.argc > 0 ? vals[sp].start : n;
+            v.may_fail = true;
+            v.hash = item_hash(&item);
+            for (int k = 0; k < item.as.call.argc; ++k) v.hash = mix(v.hash, vals[sp + k].hash);
+            items[n++] = item;
+        } else {
+            Val rhs = vals[--sp];
+            Val lhs = vals[--sp];
+            ExprOp op = item.as.op;
+            bool div_ok = !is_op_fallible(op) || (rhs.is_const && rhs.value != 0);
+
+            if (lhs.is_const && rhs.is_const && div_ok) {
+                // 상수 폴딩: 두 피연산자 슬라이스를 결과 상수 하나로 교체
+                n = lhs.start;
+                items[n].kind = EXPR_ITEM_NUMBER;
+                items[n].as.number = fold_op(op, lhs.value, rhs.value);
+                v.start = n++;
+                v.is_const = true;
+                v.value = items[v.start].as.number;
+                v.hash = item_hash(&items[v.start]);
+                o->stats->folded++;
+            } else {
+                items[n++] = item;
+                v.start = lhs.start;
+                v.may_fail = lhs.may_fail || rhs.may_fail || !div_ok;
+                v.hash = mix(mix(lhs.hash, rhs.hash), item_hash(&item));
+
+                // 공통 부분식: 같은 값을 이미 들고 있는 변수가 있으면 그 변수 참조로 교체
+                if (!v.may_fail) {
+                    int32_t holder = avail_find(o, items + v.start, n - v.start, v.hash);
+                    if (holder >= 0) {
+                        n = v.start;
+                        items[n].kind = EXPR_ITEM_VAR;
+                        items[n].as.slot = holder;
+                        v.hash = item_hash(&items[n]);
+                        n++;
+                        o->stats->cse++;
+                    }
+                }
+            }
+        }
+        vals[sp++] = v;
+    }
+
+    expr->count = n;
+    *res = vals[0];
+    return true;
+}
+
+static bool expr_reads(const Expr* e, int32_t slot) {
+    for (int i = 0; i < e->count; ++i) {
+        if (e->items[i].kind == EXPR_ITEM_VAR && e->items[i].as.slot == slot) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 식이 그 시점에 수 하나로 컴파일되는지 (컴파일러가 거부하지 않는지)
+ * 호출은 정의된 하위 루틴과 인자 수가 맞거나 첨자 하나인 배열 원소여야 하고, 배열 전체는 수가 아니다.
+ */
+static bool scalar_ok(const Expr* e, const int32_t* argc, const uint8_t* arr) {
+    for (int i = 0; i < e->count; ++i) {
+        const ExprItem* it = &e->items[i];
+        if (it->kind == EXPR_ITEM_VAR && arr[it->as.slot]) return false;
+        if (it->kind != EXPR_ITEM_CALL) continue;
+        int32_t slot = it->as.call.slot;
+        if (argc[slot] >= 0 ? argc[slot] != it->as.call.argc : !arr[slot] || it->as.call.argc != 1) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 하위 루틴 본문(SUB부터 짝이 되는 END까지)인 문장을 표시
+ * 컴파일러와 같이 최상위의 SUB만 본문을 열고, 본문 안 블록의 END를 세어 짝을 찾는다.
+ * 조건 식을 컴파일하지 못한 블록 시작 문장(정의되지 않은 호출, 인자 수 불일치)은 블록을 열지 않으므로
+ * 그때까지 정의된 하위 루틴의 인자 수와 선언된 배열을 따라가며 같은 판단을 한다.
+ * @return 메모리 부족이면 false.
+ */
+static bool mark_sub_bodies(const Program* prog, int nslots, bool* sub_body) {
+    int32_t* argc = malloc(((size_t)nslots + 1) * sizeof(int32_t));
+    uint8_t* arr = calloc((size_t)nslots + 1, 1);
+    if (!argc || !arr) {
+        free(argc);
+        free(arr);
+        return false;
+    }
+    for (int x = 0; x <= nslots; ++x) argc[x] = -1;
+
+    size_t depth = 0;   // 최상위 블록 깊이 (본문 밖)
+    size_t nest = 0;    // 본문 안 블록 깊이
+    bool in_sub = false;
+    for (size_t i = 0; i < prog->count; ++i) {
+        const Stmt* s = &prog->stmts[i];
+        StmtKind kind = s->kind;
+        if (!in_sub && kind == STMT_SUB && depth == 0 && !arr[s->subStmt.slot]) {
+            bool params_ok = true;
+            for (int k = 0; k < s->subStmt.nparams; ++k) params_ok = params_ok && !arr[s->subStmt.params[k]];
+            if (params_ok) {
+                in_sub = true;
+                nest = 0;
+                argc[s->subStmt.slot] = s->subStmt.nparams;
+            }
+        }
+        if (!in_sub && kind == STMT_ARRAY && argc[s->arrayStmt.slot] < 0 &&
+            scalar_ok(&s->arrayStmt.length_expr, argc, arr)) {
+            arr[s->arrayStmt.slot] = 1;
+        }
+        sub_body[i] = in_sub;
+        bool opens = (kind == STMT_WHILE || kind == STMT_IF || kind == STMT_REPEAT) &&
+                     scalar_ok(&s->condStmt.expr, argc, arr);
+        if (in_sub) {
+            if (opens) nest++;
+            else if (kind == STMT_END && nest == 0) in_sub = false;
+            else if (kind == STMT_END) nest--;
+        } else {
+            if (opens) depth++;
+            else if (kind == STMT_END && depth > 0) depth--;
+        }
+    }
+    free(argc);
+    free(arr);
+    return true;
+}
+
+static bool expr_has_call(const Expr* e) {
+    for (int i = 0; i < e->count; ++i) {
+        if (e->items[i].kind == EXPR_ITEM_CALL) return true;
+    }
+    return false;
+}
+
+static bool expr_has_array(const Opt* o, const Expr* e) {
+    for (int i = 0; i < e->count; ++i) {
+        const ExprItem* it = &e->items[i];
+        if ((it->kind == EXPR_ITEM_VAR && o->array_name[it->as.slot]) ||
+            (it->kind == EXPR_ITEM_CALL && o->array_name[it->as.call.slot])) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 배열을 다루는 문장인지 (분석 장벽)
+ */
+static bool touches_array(const Opt* o, const Stmt* s) {
+    switch (s->kind) {
+        case STMT_ARRAY:
+            return true;
+        case STMT_VAR:
+            return s->varStmt.indexed || o->array_name[s->varStmt.slot] ||
+                   (s->varStmt.has_value && expr_has_array(o, &s->varStmt.value_expr));
+        case STMT_PRINT:
+            return expr_has_array(o, &s->printStmt.expr);
+        case STMT_WHILE: case STMT_IF: case STMT_REPEAT:
+            return expr_has_array(o, &s->condStmt.expr);
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 정방향 분석. 문장별로 식이 실패할 수 있는지를 fallible[]에 기록
+ */
+static bool forward_pass(Opt* o, Program* prog, const bool* sub_body, bool* fallible) {
+    for (size_t i = 0; i < prog->count; ++i) {
+        Stmt* s = &prog->stmts[i];
+        Val res;
+        fallible[i] = false;
+        if (sub_body[i]) continue;
+
+        if (touches_array(o, s)) {
+            // 식은 그대로 두고, 바뀔 수 있는 변수는 알 수 없는 값으로 (블록 시작이면 아래처럼 region을 엶)
+            fallible[i] = true;
+            int32_t x = s->kind == STMT_ARRAY ? s->arrayStmt.slot : s->kind == STMT_VAR ? s->varStmt.slot : -1;
+            if (x >= 0) {
+                o->slots[x].ver++;
+                o->slots[x].known = false;
+                if (o->slots[x].def != DEF_YES) o->slots[x].def = DEF_MAYBE;
+            }
+            if (s->kind == STMT_WHILE) o->epoch++;
+            if (s->kind == STMT_WHILE || s->kind == STMT_IF || s->kind == STMT_REPEAT) {
+                if (!push_region(o)) return false;
+                o->epoch++;
+            }
+        } else if (s->kind == STMT_PRINT) {
+            if (!simplify_expr(o, &s->printStmt.expr, &res)) return false;
+            fallible[i] = res.may_fail;
+        } else if (s->kind == STMT_VAR && s->varStmt.has_value) {
+            Expr* e = &s->varStmt.value_expr;
+            if (!simplify_expr(o, e, &res)) return false;
+            fallible[i] = res.may_fail;
+
+            SlotState* x = &o->slots[s->varStmt.slot];
+            x->ver++;
+            if (res.is_const) {
+                x->known = true;
+                x->known_epoch = o->epoch;
+                x->value = res.value;
+                set_defined(o, s->varStmt.slot);
+            } else {
+                x->known = false;
+                if (!res.may_fail) set_defined(o, s->varStmt.slot);
+                else if (x->def != DEF_YES) x->def = DEF_MAYBE;
+            }
+
+            // 실패할 수 없는 연산식이면 이후 문장에서 재사용 가능
+            // (VAR C = C - 1처럼 자기 자신을 읽는 식은 저장 뒤 값이 달라지므로 제외)
+            if (!res.may_fail && !res.is_const && e->count > 1 && !expr_reads(e, s->varStmt.slot)) {
+                if (!avail_add(o, e->items, e->count, res.hash, s->varStmt.slot)) return false;
+            }
+        } else if (s->kind == STMT_VAR) {
+            fallible[i] = true; // 초기값 없는 VAR는 실행 시 진단
+        } else if (s->kind == STMT_WHILE) {
+            // 조건은 매 반복 다시 계산되므로 본문의 저장을 모르는 새 기본 블록에서 단순화
+            o->epoch++;
+            if (!simplify_expr(o, &s->condStmt.expr, &res) || !push_region(o)) return false;
+            o->epoch++;
+        } else if (s->kind == STMT_IF || s->kind == STMT_REPEAT) {
+            if (!simplify_expr(o, &s->condStmt.expr, &res) || !push_region(o)) return false;
+            o->epoch++;
+        } else if (s->kind == STMT_ELSE) {
+            pop_region(o);
+            if (!push_region(o)) return false;
+            o->epoch++;
+        } else if (s->kind == STMT_END) {
+            pop_region(o);
+            o->epoch++;
+        }
+    }
+    return true;
+}
+
+
+//========================================
+// Backward Pass (죽은 저장 제거)
+//========================================
+
+// 생존 정보: dead[x] == epoch이면 x는 죽어 있음. epoch을 올리면 모든 변수가 살아난다 (제어 문장).
+typedef struct {
+    uint32_t* dead;
+    uint32_t epoch;
+} Live;
+
+static void mark_live(Live* lv, const Expr* e) {
+    for (int i = 0; i < e->count; ++i) {
+        if (e->items[i].kind == EXPR_ITEM_VAR) lv->dead[e->items[i].as.slot] = 0;
+    }
+}
+
+static void backward_pass(Opt* o, Program* prog, const bool* sub_body, const bool* fallible, Live* lv) {
+    for (size_t k = prog->count; k-- > 0;) {
+        Stmt* s = &prog->stmts[k];
+        if (sub_body[k]) continue;
+        const Expr* e = s->kind == STMT_PRINT ? &s->printStmt.expr :
+                        s->kind == STMT_VAR && s->varStmt.has_value ? &s->varStmt.value_expr :
+                        s->kind == STMT_WHILE || s->kind == STMT_IF || s->kind == STMT_REPEAT ? &s->condStmt.expr : NULL;
+        if (e && expr_has_call(e)) lv->epoch++;    // 하위 루틴이 어떤 전역이든 읽을 수 있음
+        if (touches_array(o, s)) {
+            lv->epoch++;    // 장벽: 앞의 저장은 모두 살려 둠
+            continue;
+        }
+        if (s->kind == STMT_PRINT) {
+            mark_live(lv, &s->printStmt.expr);
+        } else if (s->kind == STMT_VAR && s->varStmt.has_value) {
+            int32_t x = s->varStmt.slot;
+            if (lv->dead[x] == lv->epoch && !fallible[k]) {
+                s->kind = STMT_NONE;
+                o->stats->dead_stores++;
+                continue;
+            }
+            // 실패할 수 있는 저장은 이전 값이 남을 수 있으므로 x를 죽이지 않는다
+            if (!fallible[k]) lv->dead[x] = lv->epoch;
+            mark_live(lv, &s->varStmt.value_expr);
+        } else if (s->kind != STMT_VAR && s->kind != STMT_NONE && s->kind != STMT_PRINT_STR) {
+            lv->epoch++;    // 블록 경계: 반복/분기를 따라 어디서든 읽힐 수 있음
+        }
+    }
+}
+
+/**
+ * @brief 제거된(STMT_NONE) 문장을 목록에서 빼서 압축하고, 소스 순서대로 제거 내역을 기록
+ */
+static void compact(Opt* o, Program* prog) {
+    size_t n = 0;
+    for (size_t i = 0; i < prog->count; ++i) {
+        const Stmt* s = &prog->stmts[i];
+        if (s->kind != STMT_NONE) {
+            prog->stmts[n++] = *s;
+        } else if (o->report) {
+            fprintf(o->report, "%s:%" PRId64 ":%" PRId64 ": note: removed dead store to '%s'\n",
+                    o->filename ? o->filename : "<stdin>", s->line, s->col, st_name(o->st, s->varStmt.slot));
+        }
+    }
+    prog->count = n;
+}
+
+
+//========================================
+// Entry Point
+//========================================
+
+bool opt_program(Program* prog, const SymTab* st, const char* filename, FILE* report, bool live_out,
+                 OptStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    Opt o;
+    memset(&o, 0, sizeof(o));
+    o.st = st;
+    o.filename = filename;
+    o.report = report;
+    o.stats = stats;
+    o.nslots = st->count;
+    o.array_name = calloc((size_t)o.nslots + 1, sizeof(bool));
+    if (o.array_name) {
+        for (size_t i = 0; i < prog->count; ++i) {
+            if (prog->stmts[i].kind == STMT_ARRAY) o.array_name[prog->stmts[i].arrayStmt.slot] = true;
+        }
+    }
+
+    bool ok = false;
+    o.slots = calloc((size_t)o.nslots + 1, sizeof(SlotState));
+    bool* fallible = malloc((prog->count + 1) * sizeof(bool));
+    bool* sub_body = malloc((prog->count + 1) * sizeof(bool));
+    o.regions = calloc(1, sizeof(uint32_t));
+    o.regions_cap = 1;
+    // 처음에는 모두 죽어 있음 (live_out이면 모두 살아 있음)
+    Live lv = { .dead = malloc(((size_t)o.nslots + 1) * sizeof(uint32_t)), .epoch = 1 };
+    if (lv.dead) {
+        for (int x = 0; x <= o.nslots; ++x) lv.dead[x] = live_out ? 0 : lv.epoch;
+    }
+
+    if (o.array_name && o.slots && fallible && sub_body && mark_sub_bodies(prog, o.nslots, sub_body) && o.regions && lv.dead && forward_pass(&o, prog, sub_body, fallible)) {
+        backward_pass(&o, prog, sub_body, fallible, &lv);
+        compact(&o, prog);
+        ok = true;
+    }
+
+    free(o.array_name);
+    free(o.slots);
+    free(fallible);
+    free(sub_body);
+    free(o.regions);
+    free(lv.dead);
+    free(o.vals);
+    free(o.avail);
+    free(o.buckets);
+    free(o.items);
+    free(o.deps);
+    return ok;
+}
+
+void opt_print_stats(const OptStats* stats, FILE* out) {
+    fprintf(out, "optimizer: folded %d constant operation%s, propagated %d constant%s, "
+                 "reused %d common subexpression%s, removed %d dead store%s\n",
+            stats->folded, stats->folded == 1 ? "" : "s",
+            stats->propagated, stats->propagated == 1 ? "" : "s",
+            stats->cse, stats->cse == 1 ? "" : "s",
+            stats->dead_stores, stats->dead_stores == 1 ? "" : "s");
+}
@@ -0,0 +1,188 @@
+//========================================
+// System Includes
+//========================================
+#include "output.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#define write _write
+#define isatty _isatty
+#endif
+
+// 00..99 두 자리씩 변환하기 위한 표
+static const char DIGIT_PAIRS[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+void out_init(Output* out, int fd, OutFlush policy) {
+    if (policy == OUT_FLUSH_AUTO) policy = isatty(fd) ? OUT_FLUSH_LINE : OUT_FLUSH_FULL;
+    out->fd = fd;
+    out->sink = NULL;
+    out->sink_user = NULL;
+    out->policy = policy;
+    out->len = 0;
+    out->failed = false;
+    out->buf = malloc(OUT_BUFFER_SIZE);
+    out->cap = out->buf ? OUT_BUFFER_SIZE : 0;
+}
+
+void out_init_sink(Output* out, OutSinkFn sink, void* user, OutFlush policy) {
+    out_init(out, -1, policy == OUT_FLUSH_AUTO ? OUT_FLUSH_FULL : policy);
+    out->sink = sink;
+    out->sink_user = user;
+}
+
+void out_free(Output* out) {
+    out_flush(out);
+    free(out->buf);
+    out->buf = NULL;
+    out->cap = 0;
+}
+
+/**
+ * @brief n바이트를 모두 write() (부분 쓰기/EINTR 재시도), 싱크가 있으면 한 번에 넘김
+ */
+static bool write_all(Output* out, const char* s, size_t n) {
+    if (out->sink) {
+        if (n > 0 && !out->failed && !out->sink(out->sink_user, s, n)) out->failed = true;
+        return !out->failed;
+    }
+    while (n > 0 && !out->failed) {
+        long w = (long)write(out->fd, s, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            out->failed = true;
+            break;
+        }
+        s += w;
+        n -= (size_t)w;
+    }
+    return !out->failed;
+}
+
+bool out_flush(Output* out) {
+    if (out->len == 0) return !out->failed;
+    bool ok = write_all(out, out->buf, out->len);
+    out->len = 0;
+    return ok;
+}
+
+/**
+ * @brief n바이트를 더 담을 수 있게 버퍼 확보
+ * EXPLICIT 정책은 버퍼를 늘리고, 그 외(또는 확장 실패)는 먼저 비운다.
+ * @return 버퍼에 담을 수 있으면 true, 버퍼보다 커서 바로 써야 하면 false.
+ */
+static bool out_reserve(Output* out, size_t n) {
+    if (out->len + n <= out->cap) return true;
+    if (out->policy == OUT_FLUSH_EXPLICIT) {
+        size_t cap = out->cap ? out->cap : OUT_BUFFER_SIZE;
+        while (cap < out->len + n) cap *= 2;
+        char* grown = realloc(out->buf, cap);
+        if (grown) {
+            out->buf = grown;
+            out->cap = cap;
+            return true;
+        }
+    }
+    out_flush(out);
+    return n <= out->cap;
+}
+
+void out_write(Output* out, const char* s, size_t n) {
+    if (!out_reserve(out, n)) { write_all(out, s, n); return; }
+    memcpy(out->buf + out->len, s, n);
+    out->len += n;
+}
+
+/**
+ * @brief 줄 하나를 끝낸 뒤 LINE 정책이면 즉시 내보냄
+ */
+static void out_end_line(Output* out) {
+    if (out->len < out->cap) out->buf[out->len++] = '\n';
+    else out_write(out, "\n", 1);
+    if (out->policy == OUT_FLUSH_LINE) out_flush(out);
+}
+
+void out_line(Output* out, const char* s, size_t n) {
+    out_write(out, s, n);
+    out_end_line(out);
+}
+
+size_t out_format_i32(char* dst, int32_t v) {
+    // 부호는 비트 연산으로 분리하여 INT32_MIN도 오버플로 없이 처리
+    uint32_t neg = (uint32_t)v >> 31;
+    uint32_t u = ((uint32_t)v ^ (0u - neg)) + neg;
+    char tmp[OUT_INT_MAX_LEN];
+    char* p = tmp + sizeof(tmp);
+
+    while (u >= 100) {
+        uint32_t r = (u % 100) * 2;
+        u /= 100;
+        *--p = DIGIT_PAIRS[r + 1];
+        *--p = DIGIT_PAIRS[r];
+    }
+    if (u >= 10) {
+        *--p = DIGIT_PAIRS[u * 2 + 1];
+        *--p = DIGIT_PAIRS[u * 2];
+    } else {
+        *--p = (char)('0' + u);
+    }
+    *--p = '-';
+    p += 1 - neg;   // 음수일 때만 '-'를 포함
+
+    size_t n = (size_t)(tmp + sizeof(tmp) - p);
+    memcpy(dst, p, n);
+    return n;
+}
+
+void out_int_line(Output* out, int32_t v) {
+    if (out->len + OUT_INT_MAX_LEN + 1 > out->cap && !out_reserve(out, OUT_INT_MAX_LEN + 1)) {
+        char tmp[OUT_INT_MAX_LEN + 1];
+        size_t n = out_format_i32(tmp, v);
+        tmp[n++] = '\n';
+        write_all(out, tmp, n);
+        return;
+    }
+    out->len += out_format_i32(out->buf + out->len, v);
+    out_end_line(out);
+}
+
+void out_ints_line(Output* out, const int32_t* v, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (out->len + OUT_INT_MAX_LEN + 1 > out->cap && !out_reserve(out, OUT_INT_MAX_LEN + 1)) {
+            char tmp[OUT_INT_MAX_LEN + 1];
+            size_t len = 0;
+            if (i) tmp[len++] = ' ';
+            len += out_format_i32(tmp + len, v[i]);
+            write_all(out, tmp, len);
+            continue;
+        }
+        if (i) out->buf[out->len++] = ' ';
+        out->len += out_format_i32(out->buf + out->len, v[i]);
+    }
+    out_end_line(out);
+}
+
+bool out_parse_policy(const char* name, OutFlush* policy) {
+    static const struct { const char* name; OutFlush policy; } NAMES[] = {
+        { "auto", OUT_FLUSH_AUTO }, { "full", OUT_FLUSH_FULL },
+        { "line", OUT_FLUSH_LINE }, { "explicit", OUT_FLUSH_EXPLICIT },
+    };
+    for (size_t i = 0; i < sizeof(NAMES) / sizeof(NAMES[0]); ++i) {
+        if (strcmp(name, NAMES[i].name) == 0) { *policy = NAMES[i].policy; return true; }
+    }
+    return false;
+}
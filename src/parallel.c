@@ -0,0 +1,242 @@
+//========================================
+// System Includes
+//========================================
+#include "parallel.h"
+#include "parser.h"
+#include "diag.h"
+#include "profile.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+//========================================
+// Chunk (워커 하나가 맡는 소스 구간과 그 결과)
+//========================================
+typedef struct {
+    const char* filename;
+    const char* data;
+    size_t size;
+    int64_t line, col;      // data[0]을 읽기 직전의 위치
+    bool worker;            // 별도 스레드에서 실행되는지 (프로파일 집계 분리용)
+
+    Program prog;           // 청크의 문장 (슬롯은 st 기준 지역 번호)
+    SymTab st;
+    DiagBuffer diags;
+    bool ok;                // false: 메모리 부족
+    bool fatal;             // 치명적 구문 오류로 파싱이 중단됨
+#ifdef DAHDIT_PROFILE
+    bool profile;
+    Profile prof;
+#endif
+} ParChunk;
+
+int par_default_threads(void) {
+#ifndef _WIN32
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief pos 이후 첫 줄 시작부터 스캔하여 문자열/주석 밖의 ';' 바로 뒤 위치를 찾음
+ * 문자열 리터럴과 주석은 줄을 넘지 않으므로 줄 시작에서는 렉서 상태가 항상 비어 있고,
+ * 파서의 모든 문장은 TK_SEMI에서 끝나므로 그 직후는 순차 파싱에서도 문장 시작이다.
+ * @return 분할 위치, 찾지 못하면 size.
+ */
+static size_t find_split(const char* src, size_t size, size_t pos) {
+    const char* nl = memchr(src + pos, '\n', size - pos);
+    if (!nl) return size;
+
+    size_t i = (size_t)(nl - src) + 1;
+    bool in_string = false;
+    while (i < size) {
+        char c = src[i++];
+        if (in_string) {
+            if (c == '"' || c == '\n') in_string = false;
+        } else if (c == '"') {
+            in_string = true;
+        } else if (c == '#') {
+            const char* end = memchr(src + i, '\n', size - i);
+            if (!end) return size;
+            i = (size_t)(end - src) + 1;
+        } else if (c == ';') {
+            return i;
+        }
+    }
+    return size;
+}
+
+/**
+ * @brief 청크 하나를 렉싱·파싱 (진단은 청크 버퍼에 모음)
+ */
+static void parse_chunk(ParChunk* c) {
+    DiagBuffer* prev = diag_capture(&c->diags);
+#ifdef DAHDIT_PROFILE
+    if (c->worker && c->profile) prof_start();
+#endif
+
+    Lexer lx;
+    lx_open_slice(&lx, c->filename, c->data, c->size, c->line, c->col);
+    st_init(&c->st);
+    prog_init(&c->prog);
+    Parser ps; ps_init(&ps, &lx, &c->st, &c->prog.arena);
+    c->ok = prog_parse(&c->prog, &ps);
+    c->fatal = ps.cur.kind != TK_EOF;
+    PROF_MEMORY(c->size, ps_memory(&ps) + c->prog.cap * sizeof(Stmt), st_memory(&c->st));
+    ps_free(&ps);
+    lx_close(&lx);
+
+    diag_capture(prev);
+#ifdef DAHDIT_PROFILE
+    if (c->worker && c->profile) c->prof = g_profile;
+#endif
+}
+
+#ifndef _WIN32
+static void* chunk_thread(void* arg) {
+    parse_chunk(arg);
+    return NULL;
+}
+#endif
+
+//========================================
+// Merge (소스 순서대로 병합)
+//========================================
+static void remap_expr(Expr* e, const int32_t* map) {
+    for (int i = 0; i < e->count; ++i) {
+        if (e->items[i].kind == EXPR_ITEM_VAR) e->items[i].as.slot = map[e->items[i].as.slot];
+        else if (e->items[i].kind == EXPR_ITEM_CALL) e->items[i].as.call.slot = map[e->items[i].as.call.slot];
+    }
+}
+
+/**
+ * @brief 청크 지역 슬롯을 전역 심볼 테이블 슬롯으로 바꿈
+ */
+static void remap_stmts(Program* prog, const int32_t* map) {
+    for (size_t i = 0; i < prog->count; ++i) {
+        Stmt* s = &prog->stmts[i];
+        if (s->kind == STMT_PRINT) {
+            remap_expr(&s->printStmt.expr, map);
+        } else if (s->kind == STMT_VAR) {
+            s->varStmt.slot = map[s->varStmt.slot];
+            if (s->varStmt.has_value) remap_expr(&s->varStmt.value_expr, map);
+            if (s->varStmt.indexed) remap_expr(&s->varStmt.index_expr, map);
+        } else if (s->kind == STMT_WHILE || s->kind == STMT_IF || s->kind == STMT_REPEAT) {
+            remap_expr(&s->condStmt.expr, map);
+        } else if (s->kind == STMT_SUB) {
+            s->subStmt.slot = map[s->subStmt.slot];
+            for (int k = 0; k < s->subStmt.nparams; ++k) s->subStmt.params[k] = map[s->subStmt.params[k]];
+        } else if (s->kind == STMT_RETURN && s->returnStmt.has_value) {
+            remap_expr(&s->returnStmt.expr, map);
+        } else if (s->kind == STMT_ARRAY) {
+            s->arrayStmt.slot = map[s->arrayStmt.slot];
+            remap_expr(&s->arrayStmt.length_expr, map);
+        }
+    }
+}
+
+/**
+ * @brief 청크 결과를 prog/st에 합침
+ * 지역 슬롯은 처음 등장한 순서대로 번호가 매겨져 있으므로, 청크 순서대로 등록하면
+ * 전역 슬롯 번호도 순차 파싱과 같아진다.
+ */
+static bool merge_chunk(Program* prog, SymTab* st, ParChunk* c) {
+    int32_t* map = malloc((size_t)(c->st.count ? c->st.count : 1) * sizeof(int32_t));
+    if (!map) return false;
+    for (int slot = 0; slot < c->st.count; ++slot) {
+        const char* name = st_name(&c->st, slot);
+        map[slot] = st_intern(st, name, strlen(name));
+        if (map[slot] < 0) { free(map); return false; }
+    }
+    remap_stmts(&c->prog, map);
+    free(map);
+    return prog_take(prog, &c->prog);
+}
+
+bool par_parse(Program* prog, const Lexer* lx, SymTab* st, int threads) {
+    const char* src = lx->buf;
+    size_t size = lx->size;
+    if (size == 0) return true;
+
+    size_t max_chunks = size / PAR_MIN_CHUNK;
+    int n = threads;
+    if ((size_t)n > max_chunks) n = (int)max_chunks;
+    if (n < 1) n = 1;
+
+    ParChunk* chunks = calloc((size_t)n, sizeof(ParChunk));
+    if (!chunks) return false;
+
+    // 분할 위치 결정 및 각 청크의 시작 줄/열 계산
+    int count = 0;
+    size_t start = 0, line_start = 0;
+    int64_t line = 1;
+    for (int k = 0; k < n && (k == 0 || start < size); ++k) {
+        size_t end = size;
+        if (k + 1 < n) {
+            size_t target = size / (size_t)n * (size_t)(k + 1);
+            end = find_split(src, size, target > start ? target : start);
+        }
+
+        ParChunk* c = &chunks[count++];
+        c->filename = lx->filename;
+        c->data = src + start;
+        c->size = end - start;
+        c->line = line;
+        c->col = (int64_t)(start - line_start) + 1;
+#ifdef DAHDIT_PROFILE
+        c->profile = g_profile.enabled;
+#endif
+        for (const char* p = src + start; (p = memchr(p, '\n', (size_t)(src + end - p))) != NULL; ++p) {
+            line++;
+            line_start = (size_t)(p - src) + 1;
+        }
+        start = end;
+    }
+
+    // 청크별 렉싱/파싱 (첫 청크는 현재 스레드에서)
+#ifndef _WIN32
+    pthread_t* tids = calloc((size_t)count, sizeof(pthread_t));
+    bool* started = calloc((size_t)count, sizeof(bool));
+    for (int i = 1; i < count && tids && started; ++i) {
+        chunks[i].worker = true;
+        started[i] = pthread_create(&tids[i], NULL, chunk_thread, &chunks[i]) == 0;
+        if (!started[i]) chunks[i].worker = false;
+    }
+#endif
+    parse_chunk(&chunks[0]);
+#ifndef _WIN32
+    for (int i = 1; i < count; ++i) {
+        if (tids && started && started[i]) pthread_join(tids[i], NULL);
+        else parse_chunk(&chunks[i]);
+    }
+    free(tids);
+    free(started);
+#else
+    for (int i = 1; i < count; ++i) parse_chunk(&chunks[i]);
+#endif
+
+    // 소스 순서대로 진단 출력 및 병합. 치명적 오류(또는 메모리 부족, 오류 수 제한) 이후 청크는 버림
+    bool ok = true, stopped = false;
+    for (int i = 0; i < count; ++i) {
+        ParChunk* c = &chunks[i];
+        if (!stopped && c->diags.len) diag_forward(&c->diags, 0, c->diags.len);
+        diag_flush(&c->diags, NULL);
+        if (!stopped) {
+#ifdef DAHDIT_PROFILE
+            if (c->worker && c->profile) prof_merge(&c->prof);
+#endif
+            if (!c->ok || !merge_chunk(prog, st, c)) { ok = false; stopped = true; }
+            if (c->fatal || diag_stopped()) stopped = true;
+        }
+        prog_free(&c->prog);
+        st_free(&c->st);
+    }
+    free(chunks);
+    return ok;
+}
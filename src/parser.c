@@ -2,7 +2,9 @@
 // System Includes
 //========================================
 #include "parser.h"
+#include "arena.h"
 #include "diag.h"
+#include "profile.h"
 #include <string.h>
 #include <ctype.h>
 #include <stdlib.h>
@@ -12,22 +14,126 @@
 //========================================
 
 /**
- * @brief 현재 토큰을 한 칸 앞으로 이동
+ * @brief 현재 토큰을 한 칸 앞으로 이동 (렉서 또는 미리 토큰화된 스트림에서)
  */
-static void advance(Parser* ps) { ps->cur = lx_next(ps->lx); }
+static void advance(Parser* ps) {
+    if (ps->ts) {
+        const TokenStream* ts = ps->ts;
+        size_t i = ps->ti;
+        ps->cur.kind = ts->kinds[i];
+        ps->cur.ch = ts->chs[i];
+        ps->cur.len = ts->lens[i];
+        ps->cur.off = ts->offs[i];
+        ps->line = ts->lines[i];
+        ps->col = ts->cols[i];
+        if (i + 1 < ts->count) ps->ti = i + 1; // 마지막 TK_EOF에 머무름
+        return;
+    }
+    if (ps->feed.next) {
+        ps->cur = ps->feed.next(ps->feed.ctx, &ps->line, &ps->col);
+        PROF_COUNT(tokens, 1);
+        return;
+    }
+    PROF_ENTER(PROF_LEX);
+    ps->cur = lx_next(ps->lx);
+    PROF_LEAVE();
+    PROF_COUNT(tokens, 1);
+    ps->line = ps->lx->tok_line;
+    ps->col = ps->lx->tok_col;
+}
+
+/**
+ * @brief 현재 토큰 스팬의 원문 포인터
+ */
+static const char* cur_text(const Parser* ps) {
+    if (ps->ts) return ps->ts->src ? ps->ts->src + ps->cur.off : "";
+    if (ps->feed.next) return ps->feed.src && *ps->feed.src ? *ps->feed.src + ps->cur.off : "";
+    return lx_token_text(ps->lx, &ps->cur);
+}
+
+//========================================
+// PRINT 문자열 작업 버퍼 (길이 제한 없음)
+//========================================
+static void text_reset(Parser* ps) { ps->text_len = 0; }
+
+static bool text_reserve(Parser* ps, size_t extra) {
+    if (ps->text_len + extra <= ps->text_cap) return true;
+    size_t cap = ps->text_cap ? ps->text_cap : 128;
+    while (cap < ps->text_len + extra) cap *= 2;
+    char* grown = realloc(ps->text, cap);
+    if (!grown) return false;
+    ps->text = grown; ps->text_cap = cap;
+    return true;
+}
+
+static void text_putc(Parser* ps, char c) {
+    if (text_reserve(ps, 1)) ps->text[ps->text_len++] = c;
+}
+
+static void text_puts(Parser* ps, const char* str, size_t n) {
+    if (n && text_reserve(ps, n)) { memcpy(ps->text + ps->text_len, str, n); ps->text_len += n; }
+}
+
+/**
+ * @brief 완성된 PRINT 문자열을 arena로 복사 (null-terminated)
+ * @return 복사본, 메모리 부족 시 진단 후 NULL.
+ */
+static const char* text_commit(Parser* ps) {
+    char* text = arena_alloc(ps->arena, ps->text_len + 1);
+    if (!text) {
+        diag_error(DIAG_NOMEM, ps->filename, ps->line, ps->col, "out of memory");
+        return NULL;
+    }
+    if (ps->text_len) memcpy(text, ps->text, ps->text_len);
+    text[ps->text_len] = '\0';
+    return text;
+}
+
+static char text_last(const Parser* ps) {
+    return ps->text_len ? ps->text[ps->text_len - 1] : '\0';
+}
+
+/**
+ * @brief 현재 토큰이 문자 c인지 (괄호, 쉼표 등 모스 부호 구두점)
+ */
+static bool at_char(const Parser* ps, char c) {
+    return ps->cur.kind == TK_LETTER && ps->cur.ch == c;
+}
+
+/**
+ * @brief 현재 토큰이 단어를 이루는 문자인지
+ * ',' ')'는 목록 안에서만 단어를 끊는다 (목록 밖에서는 PRINT HELLO, WORLD ; 처럼 단어의 일부로 남음).
+ * '('는 이름 바로 뒤에서만 단어를 끊으므로 (parse_word), 단어 첫 글자로는 그대로 쓰인다.
+ */
+static bool at_word(const Parser* ps) {
+    if (ps->cur.kind != TK_LETTER) return false;
+    return ps->arg_depth == 0 || (ps->cur.ch != ',' && ps->cur.ch != ')');
+}
 
 /**
  * @brief 모스 부호 디코딩으로 얻은 연속된 문자를 하나의 단어(식별자/숫자열)로 만듬
+ * 결과는 ps->word (null-terminated, 길이 제한 없음)에 저장된다.
+ * 이름 바로 뒤의 '('에서 멈추어 호출/첨자/매개변수 목록을 남긴다 (PRINT ( 1 ) ; 의 '('는 단어).
  * @return 단어가 하나라도 있으면 true, 아니면 false.
  */
-static bool parse_word(Parser* ps, char* out, int outsz) {
-    int n = 0;
-    while (ps->cur.kind == TK_LETTER) {
-        if (n < outsz-1) out[n++] = ps->cur.ch;
+static bool parse_word(Parser* ps) {
+    size_t n = 0;
+    while (at_word(ps) && !(n > 0 && ps->cur.ch == '(')) {
+        if (n + 1 >= ps->word_cap) {
+            size_t cap = ps->word_cap ? ps->word_cap * 2 : 64;
+            char* grown = realloc(ps->word, cap);
+            if (!grown) {
+                diag_error(DIAG_NOMEM, ps->filename, ps->line, ps->col, "out of memory");
+                return false;
+            }
+            ps->word = grown; ps->word_cap = cap;
+        }
+        ps->word[n++] = ps->cur.ch;
         advance(ps);
         // LETTER 다음이 공백/NEWLINE은 lexer가 먹음, 여기선 LETTER 아니면 word 종료
     }
-    out[n] = '\0';
+    if (ps->word) ps->word[n] = '\0';
+    ps->word_len = n;
     return n > 0;
 }
 
@@ -45,6 +151,16 @@ static bool is_kw(const char* w, const char* kw) {
     return strcmp(w, kw) == 0;
 }
 
+/**
+ * @brief 현재 단어가 숫자로만 이루어졌는지 (숫자 리터럴)
+ */
+static bool word_is_number(const Parser* ps) {
+    for (size_t i = 0; i < ps->word_len; ++i) {
+        if (!isdigit((unsigned char)ps->word[i])) return false;
+    }
+    return true;
+}
+
 
 //========================================
 // Initialization
@@ -53,78 +169,192 @@ static bool is_kw(const char* w, const char* kw) {
 /**
  * @brief Parser를 초기화 및 첫 번째 토큰을 읽어옴
  */
-void ps_init(Parser* ps, Lexer* lx) {
+void ps_init(Parser* ps, Lexer* lx, SymTab* st, Arena* arena) {
+    memset(ps, 0, sizeof(*ps));
     ps->lx = lx;
-    ps->cur = lx_next(lx);
+    ps->st = st;
+    ps->arena = arena;
+    ps->filename = lx->filename;
+    advance(ps);
+}
+
+/**
+ * @brief lx_tokenize()로 미리 만든 토큰 스트림을 입력으로 Parser 초기화
+ */
+void ps_init_stream(Parser* ps, const TokenStream* ts, SymTab* st, Arena* arena) {
+    memset(ps, 0, sizeof(*ps));
+    ps->ts = ts;
+    ps->st = st;
+    ps->arena = arena;
+    ps->filename = ts->filename;
+    advance(ps);
+}
+
+/**
+ * @brief 외부 공급원(TokenFeed)에서 토큰을 받아 파싱하도록 Parser 초기화
+ */
+void ps_init_feed(Parser* ps, TokenFeed feed, const char* filename, SymTab* st, Arena* arena) {
+    memset(ps, 0, sizeof(*ps));
+    ps->feed = feed;
+    ps->st = st;
+    ps->arena = arena;
+    ps->filename = filename;
+    advance(ps);
+}
+
+/**
+ * @brief Parser가 소유한 작업 버퍼 해제
+ */
+void ps_free(Parser* ps) {
+    free(ps->text);
+    free(ps->word);
+    free(ps->items);
+    ps->text = ps->word = NULL;
+    ps->items = NULL;
+    ps->items_cap = 0;
+    ps->text_len = ps->text_cap = 0;
+    ps->word_len = ps->word_cap = 0;
+}
+
+size_t ps_memory(const Parser* ps) {
+    return ps->text_cap + ps->word_cap + ps->items_cap * sizeof(ExprItem)
+         + (ps->arena ? ps->arena->reserved : 0);
 }
 
 
 //========================================
 // Expression Building Helpers
+// 식은 파싱하는 동안 Parser의 작업 배열(ps->items)에 쌓고, 끝나면 arena로 복사한다.
 //========================================
-static bool expr_push_number(Parser* ps, Expr* expr, int32_t value) {
-    if (expr->count >= MAX_EXPR_ITEMS) {
-        diag_error(ps->lx->filename, ps->cur.line, ps->cur.col, "expression too long");
-        return false;
+
+/**
+ * @brief 작업 배열에 항목 하나를 넣을 공간 확보 (expr->items는 작업 배열을 가리킴)
+ */
+static ExprItem* expr_push(Parser* ps, Expr* expr) {
+    if ((size_t)expr->count == ps->items_cap) {
+        size_t cap = ps->items_cap ? ps->items_cap * 2 : 64;
+        ExprItem* grown = realloc(ps->items, cap * sizeof(ExprItem));
+        if (!grown) {
+            diag_error(DIAG_NOMEM, ps->filename, ps->line, ps->col, "out of memory");
+            return NULL;
+        }
+        ps->items = grown;
+        ps->items_cap = cap;
     }
-    expr->items[expr->count].kind = EXPR_ITEM_NUMBER;
-    expr->items[expr->count].as.number = value;
-    expr->count++;
+    expr->items = ps->items;
+    return &ps->items[expr->count++];
+}
+
+static bool expr_push_number(Parser* ps, Expr* expr, int32_t value) {
+    ExprItem* item = expr_push(ps, expr);
+    if (!item) return false;
+    item->kind = EXPR_ITEM_NUMBER;
+    item->as.number = value;
     return true;
 }
 
-static bool expr_push_var(Parser* ps, Expr* expr, const char* name) {
-    if (expr->count >= MAX_EXPR_ITEMS) {
-        diag_error(ps->lx->filename, ps->cur.line, ps->cur.col, "expression too long");
-        return false;
-    }
-    expr->items[expr->count].kind = EXPR_ITEM_VAR;
-    strncpy(expr->items[expr->count].as.var, name, sizeof(expr->items[expr->count].as.var));
-    expr->items[expr->count].as.var[sizeof(expr->items[expr->count].as.var)-1] = '\0';
-    expr->count++;
+static bool expr_push_var(Parser* ps, Expr* expr, int32_t slot) {
+    ExprItem* item = expr_push(ps, expr);
+    if (!item) return false;
+    item->kind = EXPR_ITEM_VAR;
+    item->as.slot = slot;
     return true;
 }
 
 static bool expr_push_op(Parser* ps, Expr* expr, ExprOp op) {
-    if (expr->count >= MAX_EXPR_ITEMS) {
-        diag_error(ps->lx->filename, ps->cur.line, ps->cur.col, "expression too long");
+    ExprItem* item = expr_push(ps, expr);
+    if (!item) return false;
+    item->kind = EXPR_ITEM_OP;
+    item->as.op = op;
+    return true;
+}
+
+static bool expr_push_call(Parser* ps, Expr* expr, int32_t slot, int32_t argc) {
+    ExprItem* item = expr_push(ps, expr);
+    if (!item) return false;
+    item->kind = EXPR_ITEM_CALL;
+    item->as.call.slot = slot;
+    item->as.call.argc = argc;
+    return true;
+}
+
+/**
+ * @brief 완성된 식을 작업 배열에서 arena로 옮김 (식 길이만큼만 사용)
+ */
+static bool expr_commit(Parser* ps, Expr* expr) {
+    ExprItem* items = arena_copy(ps->arena, expr->items, (size_t)expr->count * sizeof(ExprItem));
+    if (!items) {
+        diag_error(DIAG_NOMEM, ps->filename, ps->line, ps->col, "out of memory");
         return false;
     }
-    expr->items[expr->count].kind = EXPR_ITEM_OP;
-    expr->items[expr->count].as.op = op;
-    expr->count++;
+    expr->items = items;
     return true;
 }
 
+/**
+ * @brief 방금 읽은 단어(ps->word)를 심볼 테이블 슬롯으로 해석 (파싱 시점 슬롯 결정)
+ * @return 슬롯 번호, 메모리 부족 시 진단 후 -1.
+ */
+static int32_t intern_word(Parser* ps) {
+    int slot = st_intern(ps->st, ps->word, ps->word_len);
+    if (slot < 0) diag_error(DIAG_NOMEM, ps->filename, ps->line, ps->col, "out of memory");
+    return slot;
+}
 
 //========================================
 // Expression Parsing Levels
 //========================================
 
+static bool parse_sum(Parser* ps, Expr* expr);
+
 /**
- * @brief 가장 낮은 우선순위: 숫자 리터럴 또는 변수(식별자)를 파싱
+ * @brief 호출 인자 목록 ( <expr>, ... ) 을 파싱. 인자를 차례로 식에 넣은 뒤 호출 항목을 붙임
+ */
+static bool parse_call(Parser* ps, Expr* expr, int32_t slot) {
+    advance(ps);    // '('
+    ps->arg_depth++;
+    int32_t argc = 0;
+    skip_separators(ps);
+    if (!at_char(ps, ')')) {
+        for (;;) {
+            if (!parse_sum(ps, expr)) return false;
+            argc++;
+            skip_separators(ps);
+            if (at_char(ps, ')')) break;
+            if (!at_char(ps, ',')) {
+                diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "expected ',' or ')' after argument");
+                return false;
+            }
+            advance(ps);
+        }
+    }
+    advance(ps);    // ')'
+    ps->arg_depth--;
+    return expr_push_call(ps, expr, slot, argc);
+}
+
+/**
+ * @brief 가장 낮은 우선순위: 숫자 리터럴, 변수(식별자) 또는 호출 NAME(...)을 파싱
+ * 호출의 '('는 이름 바로 뒤에 붙어 있어야 한다 (사이에 '/'나 줄바꿈이 있으면 호출이 아님).
  * @return 성공 시 true, 실패 시 false.
  */
 static bool parse_factor(Parser* ps, Expr* expr) {
     skip_separators(ps);
-    if (ps->cur.kind != TK_LETTER) {
-        diag_error(ps->lx->filename, ps->cur.line, ps->cur.col, "expected number or identifier in expression");
+    if (!at_word(ps)) {
+        diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "expected number or identifier in expression");
         return false;
     }
-    char word[64] = {0};
-    if (!parse_word(ps, word, sizeof(word))) return false;
-
-    bool all_digits = true;
-    for (int i = 0; word[i]; ++i) {
-        if (!isdigit((unsigned char)word[i])) { all_digits = false; break; }
-    }
+    if (!parse_word(ps)) return false;
 
-    if (all_digits && word[0] != '\0') {
-        int32_t value = (int32_t)strtol(word, NULL, 10);
+    if (word_is_number(ps)) {
+        int32_t value = (int32_t)strtol(ps->word, NULL, 10);
         return expr_push_number(ps, expr, value);
     }
 
-    return expr_push_var(ps, expr, word);
+    int32_t slot = intern_word(ps);
+    if (slot < 0) return false;
+    if (at_char(ps, '(')) return parse_call(ps, expr, slot);
+    return expr_push_var(ps, expr, slot);
 }
 
 /**
@@ -161,10 +391,9 @@ static bool parse_term(Parser* ps, Expr* expr) {
 
 /**
  * @brief 가장 낮은 우선순위: 덧셈('+'), 뺄셈('-') 연산을 처리(Expression)
- * Term을 기반으로 연산을 수행
+ * Term을 기반으로 연산을 수행하며, 결과를 식 뒤에 덧붙인다 (호출 인자도 같은 식에 쌓임)
  */
-static bool parse_expr(Parser* ps, Expr* expr) {
-    expr->count = 0;
+static bool parse_sum(Parser* ps, Expr* expr) {
     if (!parse_term(ps, expr)) return false;
 
     for (;;) {
@@ -182,6 +411,15 @@ static bool parse_expr(Parser* ps, Expr* expr) {
     return true;
 }
 
+/**
+ * @brief 식 하나를 파싱하여 arena로 옮김
+ */
+static bool parse_expr(Parser* ps, Expr* expr) {
+    expr->items = NULL;
+    expr->count = 0;
+    return parse_sum(ps, expr) && expr_commit(ps, expr);
+}
+
 
 //========================================
 // Statement Parsers
@@ -191,109 +429,103 @@ static bool parse_expr(Parser* ps, Expr* expr) {
  * @brief PRINT <expr | string> ; 문장을 파싱
  */
 static bool parse_print(Parser* ps, Stmt* out) {
-    out->line = ps->cur.line; out->col = ps->cur.col;
+    out->line = ps->line; out->col = ps->col;
     skip_separators(ps);
 
-    // 문자열 출력 (STMT_PRINT_STR - TK_STRING 토큰 사용)
+    // 문자열 출력 (STMT_PRINT_STR - TK_STRING 토큰 스팬을 그대로 사용)
     if (ps->cur.kind == TK_STRING) {
         out->kind = STMT_PRINT_STR;
-        strncpy(out->printStrStmt.text, ps->cur.text, sizeof(out->printStrStmt.text));
-        out->printStrStmt.text[sizeof(out->printStrStmt.text)-1] = '\0';
+        text_reset(ps);
+        text_puts(ps, cur_text(ps), ps->cur.len);
+        out->printStrStmt.text = text_commit(ps);
+        out->printStrStmt.len = ps->text_len;
+        if (!out->printStrStmt.text) return false;
         advance(ps);
     }
 
     else {
         out->kind = STMT_PRINT;
-        if (!parse_expr(ps, &out->printStmt.expr)) return false;
+        out->printStmt.expr.items = NULL;
+        out->printStmt.expr.count = 0;
+
+        // 식을 시작할 수 없는 토큰(연산자 등)으로 시작하면 식 없이 바로 문자열로 모은다
+        bool text_only = !at_word(ps) && ps->cur.kind != TK_SEMI && ps->cur.kind != TK_EOF;
+        if (!text_only && !parse_expr(ps, &out->printStmt.expr)) return false;
 
         skip_separators(ps);
 
         // PRINT 뒤에 여러 단어(예: HELLO WORLD)나 연산자가 이어지는 경우 문자열로 간주.
         // 기존 표현식 파서는 미지원 토큰에서 멈추므로, 세미콜론을 발견할 때까지 문자열을 수집한다.
         if (ps->cur.kind != TK_SEMI) {
-
-            char buffer[sizeof(out->printStrStmt.text)] = {0};
+            text_reset(ps);
 
             // 1) 이미 파싱된 표현식 토큰을 문자열로 복원(RPN이지만 문자열에서는 토큰 순서를 보존)
-            size_t len = 0;
-            for (int i = 0; i < out->printStmt.expr.count && len < sizeof(buffer) - 1; ++i) {
-                if (len > 0 && len + 1 < sizeof(buffer)) buffer[len++] = ' ';
-
-                ExprItem item = out->printStmt.expr.items[i];
-                if (item.kind == EXPR_ITEM_NUMBER) {
-                    len += (size_t)snprintf(buffer + len, sizeof(buffer) - len, "%d", item.as.number);
-                } else if (item.kind == EXPR_ITEM_VAR) {
-                    strncpy(buffer + len, item.as.var, sizeof(buffer) - len - 1);
-                    len = strlen(buffer);
-                } else if (item.kind == EXPR_ITEM_OP) {
-                    char op = (item.as.op == EXPR_OP_ADD) ? '+' :
-                              (item.as.op == EXPR_OP_SUB) ? '-' :
-                              (item.as.op == EXPR_OP_MUL) ? '*' :
-                              (item.as.op == EXPR_OP_DIV) ? '/' : '%';
-                    buffer[len++] = op;
-                    buffer[len] = '\0';
+            for (int i = 0; i < out->printStmt.expr.count; ++i) {
+                if (ps->text_len > 0) text_putc(ps, ' ');
+
+                const ExprItem* item = &out->printStmt.expr.items[i];
+                if (item->kind == EXPR_ITEM_NUMBER) {
+                    char num[16];
+                    int n = snprintf(num, sizeof(num), "%d", item->as.number);
+                    text_puts(ps, num, (size_t)n);
+                } else if (item->kind == EXPR_ITEM_VAR || item->kind == EXPR_ITEM_CALL) {
+                    const char* name = st_name(ps->st, item->kind == EXPR_ITEM_VAR ? item->as.slot : item->as.call.slot);
+                    text_puts(ps, name, strlen(name));
+                } else if (item->kind == EXPR_ITEM_OP) {
+                    char op = (item->as.op == EXPR_OP_ADD) ? '+' :
+                              (item->as.op == EXPR_OP_SUB) ? '-' :
+                              (item->as.op == EXPR_OP_MUL) ? '*' :
+                              (item->as.op == EXPR_OP_DIV) ? '/' : '%';
+                    text_putc(ps, op);
                 }
             }
 
             // 2) 남은 토큰을 세미콜론 전까지 이어 붙이며 공백을 삽입
-            bool pending_space = buffer[0] != '\0';
+            bool pending_space = ps->text_len > 0;
             while (ps->cur.kind != TK_SEMI && ps->cur.kind != TK_EOF) {
-                len = strlen(buffer);
-
                 // 공백 삽입이 필요한 상황이면 추가
-                if (pending_space && len > 0 && buffer[len - 1] != ' ') {
-                    if (len + 1 < sizeof(buffer)) {
-                        buffer[len] = ' ';
-                        buffer[len + 1] = '\0';
-                        len++;
-                    }
+                if (pending_space && ps->text_len > 0 && text_last(ps) != ' ') {
+                    text_putc(ps, ' ');
                     pending_space = false;
                 }
 
                 if (ps->cur.kind == TK_LETTER) {
-                    if (len + 1 < sizeof(buffer)) {
-                        buffer[len] = ps->cur.ch;
-                        buffer[len + 1] = '\0';
-                    }
+                    text_putc(ps, ps->cur.ch);
                 } else if (ps->cur.kind == TK_PLUS || ps->cur.kind == TK_MINUS ||
                            ps->cur.kind == TK_STAR || ps->cur.kind == TK_PERCENT || ps->cur.kind == TK_DIV ||
                            ps->cur.kind == TK_EQ) {
                     // 연산자는 앞에 공백을 보장하고, 다음 토큰 앞에도 공백을 기대
-                    if (len > 0 && buffer[len - 1] != ' ' && len + 1 < sizeof(buffer)) {
-                        buffer[len++] = ' ';
-                    }
-                    if (len + 1 < sizeof(buffer)) {
-                        char op = (ps->cur.kind == TK_PLUS) ? '+' :
-                                  (ps->cur.kind == TK_MINUS) ? '-' :
-                                  (ps->cur.kind == TK_STAR) ? '*' :
-                                  (ps->cur.kind == TK_DIV) ? '/' :
-                                  (ps->cur.kind == TK_PERCENT) ? '%' : '=';
-                        buffer[len] = op;
-                        buffer[len + 1] = '\0';
-                    }
+                    if (ps->text_len > 0 && text_last(ps) != ' ') text_putc(ps, ' ');
+                    char op = (ps->cur.kind == TK_PLUS) ? '+' :
+                              (ps->cur.kind == TK_MINUS) ? '-' :
+                              (ps->cur.kind == TK_STAR) ? '*' :
+                              (ps->cur.kind == TK_DIV) ? '/' :
+                              (ps->cur.kind == TK_PERCENT) ? '%' : '=';
+                    text_putc(ps, op);
                     pending_space = true;
                 } else if (ps->cur.kind == TK_SLASH || ps->cur.kind == TK_NEWLINE) {
-                    pending_space = buffer[0] != '\0';
+                    pending_space = ps->text_len > 0;
                 }
 
                 advance(ps);
             }
 
             if (ps->cur.kind != TK_SEMI) {
-                diag_error(ps->lx->filename, ps->cur.line, ps->cur.col, "missing ';' after PRINT");
+                diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "missing ';' after PRINT");
                 return false;
             }
 
             // 문자열 출력으로 전환
             out->kind = STMT_PRINT_STR;
-            strncpy(out->printStrStmt.text, buffer, sizeof(out->printStrStmt.text));
-            out->printStrStmt.text[sizeof(out->printStrStmt.text) - 1] = '\0';
+            out->printStrStmt.text = text_commit(ps);
+            out->printStrStmt.len = ps->text_len;
+            if (!out->printStrStmt.text) return false;
         }
     }
 
     skip_separators(ps);
     if (ps->cur.kind != TK_SEMI) {
-        diag_error(ps->lx->filename, ps->cur.line, ps->cur.col, "missing ';' after PRINT");
+        diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "missing ';' after PRINT");
         return false;
     }
 
@@ -302,22 +534,51 @@ static bool parse_print(Parser* ps, Stmt* out) {
 }
 
 /**
- * @brief VAR name (= expr)? ; 문장을 파싱
+ * @brief ( <expr> ) 를 파싱하여 arena로 옮김 (배열 첨자와 길이, 현재 토큰이 '(')
+ * @param what 닫는 괄호가 없을 때 진단에 쓸 이름
+ */
+static bool parse_paren_expr(Parser* ps, Expr* expr, const char* what) {
+    advance(ps);    // '('
+    ps->arg_depth++;
+    expr->items = NULL;
+    expr->count = 0;
+    if (!parse_sum(ps, expr)) return false;
+    skip_separators(ps);
+    if (!at_char(ps, ')')) {
+        char msg[48];
+        snprintf(msg, sizeof(msg), "expected ')' after %s", what);
+        diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, msg);
+        return false;
+    }
+    advance(ps);
+    ps->arg_depth--;
+    return expr_commit(ps, expr);
+}
+
+/**
+ * @brief VAR name [(index)] (= expr)? ; 문장을 파싱
  */
 static bool parse_var(Parser* ps, Stmt* out) {
     out->kind = STMT_VAR;
-    out->varStmt.name[0] = '\0';
+    out->varStmt.slot = -1;
     out->varStmt.has_value = false;
-    out->line = ps->cur.line; out->col = ps->cur.col;
+    out->varStmt.indexed = false;
+    out->line = ps->line; out->col = ps->col;
 
     skip_separators(ps);
-    if (ps->cur.kind != TK_LETTER) {
-        diag_error(ps->lx->filename, ps->cur.line, ps->cur.col, "expected identifier after VAR");
+    if (!at_word(ps)) {
+        diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "expected identifier after VAR");
         return false;
     }
 
     // 변수 이름 파싱
-    if (!parse_word(ps, out->varStmt.name, sizeof(out->varStmt.name))) return false;
+    if (!parse_word(ps)) return false;
+    out->varStmt.slot = intern_word(ps);
+    if (out->varStmt.slot < 0) return false;
+
+    // 배열 원소 첨자 (호출처럼 '('가 이름 바로 뒤에 붙음)
+    out->varStmt.indexed = at_char(ps, '(');
+    if (out->varStmt.indexed && !parse_paren_expr(ps, &out->varStmt.index_expr, "index")) return false;
 
     skip_separators(ps);
 
@@ -332,13 +593,150 @@ static bool parse_var(Parser* ps, Stmt* out) {
 
     // 구문 종결자 ';' 파싱
     if (ps->cur.kind != TK_SEMI) {
-        diag_error(ps->lx->filename, ps->cur.line, ps->cur.col, "missing ';' after VAR statement");
+        diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "missing ';' after VAR statement");
         return false;
     }
     advance(ps);
     return true;
 }
 
+/**
+ * @brief 블록 문장 끝의 ';'를 소비 (없으면 진단 후 false)
+ */
+static bool expect_block_semi(Parser* ps, const char* kw) {
+    skip_separators(ps);
+    if (ps->cur.kind != TK_SEMI) {
+        char msg[48];
+        snprintf(msg, sizeof(msg), "missing ';' after %s", kw);
+        diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, msg);
+        return false;
+    }
+    advance(ps);
+    return true;
+}
+
+/**
+ * @brief WHILE/IF/REPEAT <expr> ; 블록 시작 문장을 파싱
+ */
+static bool parse_cond(Parser* ps, Stmt* out, StmtKind kind, const char* kw) {
+    out->kind = kind;
+    out->line = ps->line; out->col = ps->col;
+    return parse_expr(ps, &out->condStmt.expr) && expect_block_semi(ps, kw);
+}
+
+/**
+ * @brief ELSE ; / END ; 블록 구분 문장을 파싱
+ */
+static bool parse_block_mark(Parser* ps, Stmt* out, StmtKind kind, const char* kw) {
+    out->kind = kind;
+    out->line = ps->line; out->col = ps->col;
+    return expect_block_semi(ps, kw);
+}
+
+/**
+ * @brief SUB name [(param, ...)] ; 하위 루틴 시작 문장을 파싱 (본문은 END까지 이어지는 문장들)
+ */
+static bool parse_sub(Parser* ps, Stmt* out) {
+    out->kind = STMT_SUB;
+    out->line = ps->line; out->col = ps->col;
+    out->subStmt.params = NULL;
+    out->subStmt.nparams = 0;
+
+    skip_separators(ps);
+    if (!at_word(ps)) {
+        diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "expected subroutine name after SUB");
+        return false;
+    }
+    if (!parse_word(ps)) return false;
+    if (word_is_number(ps)) {
+        diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "expected subroutine name after SUB");
+        return false;
+    }
+    out->subStmt.slot = intern_word(ps);
+    if (out->subStmt.slot < 0) return false;
+
+    // 매개변수 슬롯은 식 작업 배열에 모은 뒤 arena로 옮김
+    Expr params = { NULL, 0 };
+    skip_separators(ps);
+    if (at_char(ps, '(')) {
+        advance(ps);
+        ps->arg_depth++;
+        skip_separators(ps);
+        while (!at_char(ps, ')')) {
+            if (params.count > 0) {
+                if (!at_char(ps, ',')) {
+                    diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "expected ',' or ')' after parameter");
+                    return false;
+                }
+                advance(ps);
+                skip_separators(ps);
+            }
+            if (!at_word(ps) || !parse_word(ps) || word_is_number(ps)) {
+                diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "expected parameter name");
+                return false;
+            }
+            int32_t slot = intern_word(ps);
+            if (slot < 0) return false;
+            for (int i = 0; i < params.count; ++i) {
+                if (params.items[i].as.slot == slot) {
+                    char msg[96];
+                    snprintf(msg, sizeof(msg), "duplicate parameter '%s'", ps->word);
+                    diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, msg);
+                    return false;
+                }
+            }
+            if (!expr_push_var(ps, &params, slot)) return false;
+            skip_separators(ps);
+        }
+        advance(ps);    // ')'
+        ps->arg_depth--;
+    }
+
+    if (params.count > 0) {
+        int32_t* slots = arena_alloc(ps->arena, (size_t)params.count * sizeof(int32_t));
+        if (!slots) {
+            diag_error(DIAG_NOMEM, ps->filename, ps->line, ps->col, "out of memory");
+            return false;
+        }
+        for (int i = 0; i < params.count; ++i) slots[i] = params.items[i].as.slot;
+        out->subStmt.params = slots;
+        out->subStmt.nparams = params.count;
+    }
+    return expect_block_semi(ps, "SUB");
+}
+
+/**
+ * @brief RETURN [<expr>] ; 문장을 파싱
+ */
+static bool parse_return(Parser* ps, Stmt* out) {
+    out->kind = STMT_RETURN;
+    out->line = ps->line; out->col = ps->col;
+    skip_separators(ps);
+    out->returnStmt.has_value = ps->cur.kind != TK_SEMI;
+    if (out->returnStmt.has_value && !parse_expr(ps, &out->returnStmt.expr)) return false;
+    return expect_block_semi(ps, "RETURN");
+}
+
+/**
+ * @brief ARRAY name(length) ; 배열 선언 문장을 파싱
+ */
+static bool parse_array(Parser* ps, Stmt* out) {
+    out->kind = STMT_ARRAY;
+    out->line = ps->line; out->col = ps->col;
+    skip_separators(ps);
+    if (!at_word(ps) || !parse_word(ps) || word_is_number(ps)) {
+        diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "expected array name after ARRAY");
+        return false;
+    }
+    out->arrayStmt.slot = intern_word(ps);
+    if (out->arrayStmt.slot < 0) return false;
+    skip_separators(ps);
+    if (!at_char(ps, '(')) {
+        diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "expected '(' after array name");
+        return false;
+    }
+    return parse_paren_expr(ps, &out->arrayStmt.length_expr, "array length") && expect_block_semi(ps, "ARRAY");
+}
 
 //========================================
 // Main Parsing Loop
@@ -346,33 +744,53 @@ static bool parse_var(Parser* ps, Stmt* out) {
 
 /**
  * @brief 다음 문장을 파싱하고 해당 Stmt 구조체 삽입
+ * 구문 오류를 건너뛰고 복구한 경우 out->kind는 STMT_NONE (실행할 내용 없음).
  * @return EOF가 아니면 true, 파일 끝이면 false.
  */
 bool ps_next_stmt(Parser* ps, Stmt* out) {
     skip_separators(ps);
     if (ps->cur.kind == TK_EOF) return false;
+    ps->arg_depth = 0;  // 앞 문장이 목록 중간에서 오류로 끝났을 수 있음
 
     // 첫 단어(키워드) 읽기
-    if (ps->cur.kind != TK_LETTER) {
-        diag_error(ps->lx->filename, ps->cur.line, ps->cur.col, "expected statement");
+    if (!at_word(ps)) {
+        diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col, "expected statement");
         // 에러 동기화: 세미콜론까지 스킵
         while (ps->cur.kind != TK_SEMI && ps->cur.kind != TK_EOF) advance(ps);
         if (ps->cur.kind == TK_SEMI) advance(ps);
+        out->kind = STMT_NONE;
         return true; // 계속 진행
     }
 
-    char kw[16] = {0};
-    if (!parse_word(ps, kw, sizeof(kw))) return false;
+    if (!parse_word(ps)) return false;
 
-    if (is_kw(kw, "PRINT")) {
+    if (is_kw(ps->word, "PRINT")) {
         return parse_print(ps, out);
-    } else if (is_kw(kw, "VAR")) {
+    } else if (is_kw(ps->word, "VAR")) {
         return parse_var(ps, out);
+    } else if (is_kw(ps->word, "WHILE")) {
+        return parse_cond(ps, out, STMT_WHILE, "WHILE");
+    } else if (is_kw(ps->word, "IF")) {
+        return parse_cond(ps, out, STMT_IF, "IF");
+    } else if (is_kw(ps->word, "REPEAT")) {
+        return parse_cond(ps, out, STMT_REPEAT, "REPEAT");
+    } else if (is_kw(ps->word, "ELSE")) {
+        return parse_block_mark(ps, out, STMT_ELSE, "ELSE");
+    } else if (is_kw(ps->word, "END")) {
+        return parse_block_mark(ps, out, STMT_END, "END");
+    } else if (is_kw(ps->word, "SUB")) {
+        return parse_sub(ps, out);
+    } else if (is_kw(ps->word, "RETURN")) {
+        return parse_return(ps, out);
+    } else if (is_kw(ps->word, "ARRAY")) {
+        return parse_array(ps, out);
     } else {
-        diag_error(ps->lx->filename, ps->cur.line, ps->cur.col, "unknown statement (expected PRINT or VAR)");
+        diag_error(DIAG_SYNTAX, ps->filename, ps->line, ps->col,
+                   "unknown statement (expected PRINT, VAR, WHILE, IF, REPEAT, ELSE, END, SUB, RETURN or ARRAY)");
         // 세미콜론까지 스킵
         while (ps->cur.kind != TK_SEMI && ps->cur.kind != TK_EOF) advance(ps);
         if (ps->cur.kind == TK_SEMI) advance(ps);
+        out->kind = STMT_NONE;
         return true;
     }
 }
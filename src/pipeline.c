@@ -0,0 +1,451 @@
+//========================================
+// System Includes
+//========================================
+#include "pipeline.h"
+#include "parser.h"
+#include "arena.h"
+#include "ring.h"
+#include "diag.h"
+#include "profile.h"
+#include "stream.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+
+//========================================
+// Batches (단계 사이에 주고받는 단위)
+//========================================
+typedef struct {
+    size_t count;
+    Token toks[PIPE_TOKEN_BATCH];
+    int64_t lines[PIPE_TOKEN_BATCH];
+    int64_t cols[PIPE_TOKEN_BATCH];
+    size_t diag_end[PIPE_TOKEN_BATCH];  // 토큰 i를 만들기까지 발생한 렉서 진단의 끝 (diags 기준)
+    DiagBuffer diags;
+    char* text;                         // 문자열 토큰의 내용 (토큰 오프셋은 이 버퍼 기준)
+    size_t text_len, text_cap;
+    bool boundary;                      // 입력 묶음의 문장 경계에서 끝난 배치 (렉서가 다음 입력을 기다릴 수 있음)
+} TokenBatch;
+
+typedef struct {
+    size_t count;
+    Stmt stmts[PIPE_STMT_BATCH];
+    size_t diag_end[PIPE_STMT_BATCH];   // 문장 i를 파싱하기까지 발생한 진단의 끝
+    DiagBuffer diags;
+    Arena arena;                        // 문장의 식/문자열
+    int slots;                          // 이 배치까지 파서가 등록한 심볼 수
+    const char** names;                 // 이 배치에서 새로 등록된 이름들 (arena)
+    int new_names;
+    bool last;                          // EOF 또는 치명적 구문 오류로 끝난 마지막 배치
+} StmtBatch;
+
+//========================================
+// Pipeline State
+//========================================
+typedef struct {
+    const char* name;                   // 진단에 표시할 이름
+    SourceStream ss;                    // 렉서 스레드 전용: 입력을 문장 묶음 단위로 읽음
+    bool nomem;                         // 렉서 스레드의 메모리 부족
+    Ring tokens, token_free;            // 렉서 → 파서, 파서 → 렉서 (빈 배치 반환)
+    Ring stmts, stmt_free;              // 파서 → 실행기, 실행기 → 파서
+    TokenBatch* token_pool;
+    StmtBatch* stmt_pool;
+    atomic_bool stop;                   // 어느 단계든 더 진행할 수 없으면 설정
+
+    // 파서 스레드 전용
+    SymTab pst;                         // 이름 → 슬롯 (실행기의 SymTab과 같은 순서로 등록)
+    TokenBatch* cur;
+    const char* text;                   // cur의 문자열 내용 (TokenFeed.src가 가리킴)
+    size_t cur_i;
+    bool boundary;                      // 방금 돌려준 토큰이 boundary 배치의 마지막
+    bool eof;
+    bool parser_ok;
+
+#ifdef DAHDIT_PROFILE
+    bool profile;
+    Profile lexer_prof, parser_prof;
+#endif
+} Pipeline;
+
+/**
+ * @brief 링이 비었거나 가득 찼을 때 잠깐 돌다가 CPU를 양보
+ */
+static void backoff(unsigned* spins) {
+    if (++*spins > 64) sched_yield();
+}
+
+static void* pop_wait(Pipeline* pl, Ring* r) {
+    unsigned spins = 0;
+    void* item;
+    while (!(item = ring_pop(r))) {
+        // stop 이전에 넣은 항목이 보이도록 한 번 더 확인
+        if (atomic_load_explicit(&pl->stop, memory_order_acquire)) return ring_pop(r);
+        backoff(&spins);
+    }
+    return item;
+}
+
+static bool push_wait(Pipeline* pl, Ring* r, void* item) {
+    unsigned spins = 0;
+    while (!ring_push(r, item)) {
+        if (atomic_load_explicit(&pl->stop, memory_order_acquire)) return false;
+        backoff(&spins);
+    }
+    return true;
+}
+
+//========================================
+// Stage 1: Lexer Thread
+//========================================
+
+/**
+ * @brief 문자열 토큰의 내용을 배치에 복사하고 오프셋을 배치 기준으로 바꿈
+ * 입력 버퍼는 다음 문장 묶음을 읽을 때 버려지므로, 파서가 읽을 스팬은 배치가 갖고 있어야 한다.
+ */
+static bool keep_text(TokenBatch* b, Token* tok, const char* src) {
+    if (tok->len == 0) { tok->off = 0; return true; }
+    if (b->text_len + tok->len > b->text_cap) {
+        size_t cap = b->text_cap ? b->text_cap : 256;
+        while (cap < b->text_len + tok->len) cap *= 2;
+        char* grown = realloc(b->text, cap);
+        if (!grown) return false;
+        b->text = grown; b->text_cap = cap;
+    }
+    memcpy(b->text + b->text_len, src + tok->off, tok->len);
+    tok->off = b->text_len;
+    b->text_len += tok->len;
+    return true;
+}
+
+static void put_token(TokenBatch* b, Token tok, int64_t line, int64_t col) {
+    size_t i = b->count++;
+    b->toks[i] = tok;
+    b->lines[i] = line;
+    b->cols[i] = col;
+    b->diag_end[i] = b->diags.len;
+}
+
+/**
+ * @brief 입력을 SourceStream으로 읽어 가며 문장 묶음마다 렉싱 (각 묶음은 앞 묶음의 위치를 이어받는 슬라이스)
+ * ';'로 끝난 묶음 뒤에는 구분자(TK_NEWLINE)를 하나 넣고 배치를 바로 넘긴다. 파서는 ';' 다음 토큰을
+ * 기다리지 않고 그 문장까지 실행기로 넘길 수 있어, 다음 입력을 기다리는 동안에도 앞 문장이 실행된다.
+ */
+static void* lexer_thread(void* arg) {
+    Pipeline* pl = arg;
+#ifdef DAHDIT_PROFILE
+    if (pl->profile) prof_start();
+#endif
+    Lexer lx;
+    bool open = false, eof = false, boundary = false;
+    int64_t line = 1, col = 1;          // 다음 묶음이 시작하는 위치
+    int64_t eof_line = 1, eof_col = 1;  // 마지막 묶음 끝의 EOF 위치
+    while (!eof) {
+        TokenBatch* b = pop_wait(pl, &pl->token_free);
+        if (!b) break;
+        b->count = 0;
+        b->text_len = 0;
+        b->boundary = false;
+        diag_truncate(&b->diags, 0);
+        diag_capture(&b->diags);
+
+        PROF_ENTER(PROF_LEX);
+        while (b->count < PIPE_TOKEN_BATCH && !eof) {
+            if (!open) {
+                const char* data;
+                size_t size;
+                // 파싱이 끝났으면 더 읽지 않음
+                if (atomic_load_explicit(&pl->stop, memory_order_acquire) || !ss_next(&pl->ss, &data, &size)) {
+                    put_token(b, (Token){ .kind = TK_EOF }, eof_line, eof_col);
+                    eof = true;
+                    break;
+                }
+                lx_open_slice(&lx, pl->name, data, size, line, col);
+                boundary = size > 0 && data[size - 1] == ';';   // 입력 끝의 미완결 묶음이 아니면 문장 경계
+                open = true;
+            }
+            Token tok = lx_next(&lx);
+            if (tok.kind == TK_EOF) {
+                line = lx.line; col = lx.col;
+                eof_line = lx.tok_line; eof_col = lx.tok_col;
+                lx_close(&lx);
+                open = false;
+                if (!boundary) continue;
+                put_token(b, (Token){ .kind = TK_NEWLINE }, eof_line, eof_col);
+                b->boundary = true;
+                break;
+            }
+            if (tok.kind == TK_STRING && !keep_text(b, &tok, lx.buf)) {
+                pl->nomem = true;
+                tok = (Token){ .kind = TK_EOF };
+            }
+            put_token(b, tok, lx.tok_line, lx.tok_col);
+            eof = tok.kind == TK_EOF;
+        }
+        PROF_LEAVE();
+
+        diag_capture(NULL);
+        if (!push_wait(pl, &pl->tokens, b)) break;
+    }
+    if (open) lx_close(&lx);
+#ifdef DAHDIT_PROFILE
+    if (pl->profile) pl->lexer_prof = g_profile;
+#endif
+    return NULL;
+}
+
+//========================================
+// Stage 2: Parser Thread
+//========================================
+
+/**
+ * @brief 파서의 토큰 공급원: 렉서 배치에서 하나씩 꺼내고, 토큰에 붙은 렉서 진단을 전달
+ * 진단은 파서가 해당 토큰을 읽는 시점에 나가므로 순차 실행과 순서가 같다.
+ */
+static Token feed_next(void* ctx, int64_t* line, int64_t* col) {
+    Pipeline* pl = ctx;
+    Token eof = { .kind = TK_EOF };
+
+    if (pl->cur && pl->cur_i == pl->cur->count) {
+        if (!pl->eof) push_wait(pl, &pl->token_free, pl->cur);
+        pl->cur = NULL;
+    }
+    if (!pl->cur) {
+        if (pl->eof || !(pl->cur = pop_wait(pl, &pl->tokens))) return eof;
+        pl->cur_i = 0;
+        pl->text = pl->cur->text;
+    }
+
+    TokenBatch* b = pl->cur;
+    size_t i = pl->cur_i++;
+    size_t begin = i ? b->diag_end[i - 1] : 0;
+    if (b->diag_end[i] > begin) diag_forward(&b->diags, begin, b->diag_end[i]);
+    if (b->toks[i].kind == TK_EOF) {
+        pl->eof = true;
+        pl->cur_i = b->count;   // 이후에는 계속 EOF
+    }
+    pl->boundary = b->boundary && pl->cur_i == b->count;
+    *line = b->lines[i];
+    *col = b->cols[i];
+    return b->toks[i];
+}
+
+/**
+ * @brief 빈 문장 배치를 받아 파서의 진단/할당 대상으로 지정
+ */
+static StmtBatch* begin_batch(Pipeline* pl, Parser* ps) {
+    StmtBatch* sb = pop_wait(pl, &pl->stmt_free);
+    if (!sb) return NULL;
+    sb->count = 0;
+    diag_truncate(&sb->diags, 0);
+    sb->last = false;
+    sb->names = NULL;
+    sb->new_names = 0;
+    arena_reset(&sb->arena);
+    diag_capture(&sb->diags);
+    if (ps) ps->arena = &sb->arena;
+    return sb;
+}
+
+/**
+ * @brief 이번 배치에서 새로 등록된 이름을 배치에 기록하고 실행기로 넘김
+ */
+static bool finish_batch(Pipeline* pl, StmtBatch* sb, int* slots) {
+    int added = pl->pst.count - *slots;
+    if (added > 0) {
+        sb->names = arena_alloc(&sb->arena, (size_t)added * sizeof(const char*));
+        if (!sb->names) return false;
+        for (int k = 0; k < added; ++k) {
+            const char* name = st_name(&pl->pst, *slots + k);
+            sb->names[k] = arena_copy(&sb->arena, name, strlen(name) + 1);
+            if (!sb->names[k]) return false;
+        }
+        sb->new_names = added;
+    }
+    *slots = pl->pst.count;
+    sb->slots = *slots;
+    diag_capture(NULL);
+    return push_wait(pl, &pl->stmts, sb);
+}
+
+static void* parser_thread(void* arg) {
+    Pipeline* pl = arg;
+#ifdef DAHDIT_PROFILE
+    if (pl->profile) prof_start();
+#endif
+    int slots = pl->pst.count;
+    Parser ps;
+    StmtBatch* sb = begin_batch(pl, NULL);
+    if (sb) {
+        TokenFeed feed = { .next = feed_next, .ctx = pl, .src = &pl->text };
+        ps_init_feed(&ps, feed, pl->name, &pl->pst, &sb->arena);
+
+        for (;;) {
+            Stmt s;
+            PROF_ENTER(PROF_PARSE);
+            bool more = ps_next_stmt(&ps, &s);
+            PROF_LEAVE();
+            if (!more || diag_stopped()) {
+                sb->last = true;
+                if (!finish_batch(pl, sb, &slots)) pl->parser_ok = false;
+                break;
+            }
+            PROF_COUNT(stmts, s.kind != STMT_NONE);
+            sb->stmts[sb->count] = s;
+            sb->diag_end[sb->count++] = sb->diags.len;
+            // 배치가 찼거나, 렉서가 다음 입력을 기다릴 수 있는 문장 경계면 바로 넘김
+            if (sb->count == PIPE_STMT_BATCH || pl->boundary) {
+                pl->boundary = false;
+                if (!finish_batch(pl, sb, &slots)) { pl->parser_ok = false; break; }
+                if (!(sb = begin_batch(pl, &ps))) break;
+            }
+        }
+        ps_free(&ps);
+    }
+    diag_capture(NULL);
+
+    // 파싱이 끝났으면 (치명적 오류 포함) 렉서를 더 기다리게 하지 않음
+    atomic_store_explicit(&pl->stop, true, memory_order_release);
+#ifdef DAHDIT_PROFILE
+    if (pl->profile) pl->parser_prof = g_profile;
+#endif
+    return NULL;
+}
+
+//========================================
+// Stage 3: Executor (호출 스레드)
+//========================================
+
+/**
+ * @brief 배치의 진단 텍스트 [begin, end)를 이 스레드의 진단 대상(기본 stderr)으로 출력
+ */
+static void emit_diags(const StmtBatch* sb, size_t begin, size_t end) {
+    if (end > begin) diag_forward(&sb->diags, begin, end);
+}
+
+/**
+ * @brief 문장 배치를 하나씩 받아 순서대로 컴파일·실행 (블록은 END까지 모은 뒤 실행, 배치를 넘어갈 수 있음)
+ * @return 메모리 부족이면 false.
+ */
+static bool execute(Pipeline* pl, SymTab* st, Chunk* ch, VM* vm) {
+    for (;;) {
+        StmtBatch* sb = ring_pop(&pl->stmts);
+        if (!sb) {
+            // 다음 입력을 기다리기 전에 지금까지의 출력을 내보냄
+            if (vm->out->policy != OUT_FLUSH_EXPLICIT) out_flush(vm->out);
+            sb = pop_wait(pl, &pl->stmts);
+        }
+        if (!sb) return pl->parser_ok;     // 파서가 배치를 넘기지 못하고 끝남
+
+        // 파서가 등록한 순서대로 같은 슬롯 번호를 확보
+        for (int k = 0; k < sb->new_names; ++k) {
+            if (st_intern(st, sb->names[k], strlen(sb->names[k])) < 0) return false;
+        }
+
+        size_t begin = 0;
+        for (size_t i = 0; i < sb->count; ++i) {
+            emit_diags(sb, begin, sb->diag_end[i]);
+            begin = sb->diag_end[i];
+            if (diag_stopped()) break;
+
+            PROF_ENTER(PROF_COMPILE);
+            if (!bc_in_block(ch)) bc_reset_stmts(ch);
+            bool run = bc_compile_stmt(ch, &sb->stmts[i], st, pl->name) && !bc_in_block(ch);
+            bool ok = !run || bc_finish(ch);
+            PROF_LEAVE();
+            if (!ok) return false;
+            if (!run) continue;
+
+            PROF_ENTER(PROF_EXEC);
+            ok = vm_run(vm, ch);
+            PROF_LEAVE();
+            if (!ok) return false;
+            if (diag_stopped()) break;
+        }
+
+        // 오류 수 제한에 도달하면 나머지 배치는 버림 (파서/렉서 스레드는 pipe_run이 멈춤)
+        if (diag_stopped()) {
+            push_wait(pl, &pl->stmt_free, sb);
+            return true;
+        }
+        bool last = sb->last;
+        if (last) {
+            emit_diags(sb, begin, sb->diags.len);
+            bc_end_blocks(ch, pl->name);
+        }
+        push_wait(pl, &pl->stmt_free, sb);
+        if (last) return pl->parser_ok;
+    }
+}
+
+bool pipe_run(const char* name, int fd, SymTab* st, Chunk* ch, VM* vm, bool* read_failed) {
+    Pipeline* pl = calloc(1, sizeof(Pipeline));
+    if (!pl) return false;
+    pl->name = name;
+    ss_init(&pl->ss, fd);
+    pl->parser_ok = true;
+    atomic_init(&pl->stop, false);
+    st_init(&pl->pst);
+    // 실행기에 이미 있는 변수(불러온 상태 등)는 같은 슬롯 번호를 쓰도록 먼저 등록
+    for (int i = 0; i < st->count; ++i) {
+        const char* name = st_name(st, i);
+        if (st_intern(&pl->pst, name, strlen(name)) < 0) {
+            st_free(&pl->pst);
+            free(pl);
+            return false;
+        }
+    }
+#ifdef DAHDIT_PROFILE
+    pl->profile = g_profile.enabled;
+#endif
+
+    bool ok = ring_init(&pl->tokens, PIPE_BATCHES) && ring_init(&pl->token_free, PIPE_BATCHES)
+           && ring_init(&pl->stmts, PIPE_BATCHES) && ring_init(&pl->stmt_free, PIPE_BATCHES);
+    pl->token_pool = calloc(PIPE_BATCHES, sizeof(TokenBatch));
+    pl->stmt_pool = calloc(PIPE_BATCHES, sizeof(StmtBatch));
+    ok = ok && pl->token_pool && pl->stmt_pool;
+    for (int i = 0; ok && i < PIPE_BATCHES; ++i) {
+        arena_init(&pl->stmt_pool[i].arena, 16 * 1024);
+        ring_push(&pl->token_free, &pl->token_pool[i]);
+        ring_push(&pl->stmt_free, &pl->stmt_pool[i]);
+    }
+
+    pthread_t lexer, parser;
+    bool lexer_started = ok && pthread_create(&lexer, NULL, lexer_thread, pl) == 0;
+    bool parser_started = lexer_started && pthread_create(&parser, NULL, parser_thread, pl) == 0;
+    ok = parser_started && execute(pl, st, ch, vm);
+
+    // 실행기가 먼저 멈춘 경우에도 두 스레드가 대기에서 빠져나오도록 함
+    atomic_store_explicit(&pl->stop, true, memory_order_release);
+    if (parser_started) pthread_join(parser, NULL);
+    if (lexer_started) pthread_join(lexer, NULL);
+#ifdef DAHDIT_PROFILE
+    if (pl->profile && lexer_started) prof_merge(&pl->lexer_prof);
+    if (pl->profile && parser_started) prof_merge(&pl->parser_prof);
+#endif
+
+    *read_failed = pl->ss.failed;
+    if (pl->ss.nomem || pl->nomem) ok = false;
+
+    for (int i = 0; pl->token_pool && i < PIPE_BATCHES; ++i) {
+        diag_flush(&pl->token_pool[i].diags, NULL);
+        free(pl->token_pool[i].text);
+    }
+    for (int i = 0; pl->stmt_pool && i < PIPE_BATCHES; ++i) {
+        diag_flush(&pl->stmt_pool[i].diags, NULL);
+        arena_free(&pl->stmt_pool[i].arena);
+    }
+    free(pl->token_pool);
+    free(pl->stmt_pool);
+    ring_free(&pl->tokens); ring_free(&pl->token_free);
+    ring_free(&pl->stmts); ring_free(&pl->stmt_free);
+    st_free(&pl->pst);
+    ss_free(&pl->ss);
+    free(pl);
+    return ok;
+}
+
+#endif
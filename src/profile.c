@@ -0,0 +1,115 @@
+//========================================
+// System Includes
+//========================================
+#include "profile.h"
+
+#ifdef DAHDIT_PROFILE
+#include <string.h>
+
+#ifndef _WIN32
+#include <time.h>
+#else
+#include <windows.h>
+#endif
+
+_Thread_local Profile g_profile;
+
+static const char* PHASE_NAMES[PROF_PHASE_COUNT] = { "lex", "parse", "optimize", "compile", "exec" };
+
+static double now_sec(void) {
+#ifndef _WIN32
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#else
+    LARGE_INTEGER freq, t;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart / (double)freq.QuadPart;
+#endif
+}
+
+void prof_start(void) {
+    memset(&g_profile, 0, sizeof(g_profile));
+    g_profile.enabled = true;
+    g_profile.start = g_profile.mark = now_sec();
+}
+
+/**
+ * @brief 지난 mark 이후 시간을 현재 진행 중인 단계에 배분
+ */
+static double charge(void) {
+    double now = now_sec();
+    if (g_profile.depth > 0) {
+        g_profile.phase_sec[g_profile.stack[g_profile.depth - 1]] += now - g_profile.mark;
+    }
+    g_profile.mark = now;
+    return now;
+}
+
+void prof_enter(ProfPhase phase) {
+    charge();
+    g_profile.phase_calls[phase]++;
+    if (g_profile.depth < PROF_MAX_DEPTH) g_profile.stack[g_profile.depth] = phase;
+    g_profile.depth++;
+}
+
+void prof_leave(void) {
+    charge();
+    if (g_profile.depth > 0) g_profile.depth--;
+}
+
+void prof_merge(const Profile* worker) {
+    g_profile.tokens += worker->tokens;
+    g_profile.stmts += worker->stmts;
+    g_profile.diagnostics += worker->diagnostics;
+    g_profile.lookups += worker->lookups;
+    g_profile.probes += worker->probes;
+    PROF_MAX(max_probe, worker->max_probe);
+    // 워커들은 동시에 살아 있으므로 최대 사용량은 합으로 근사
+    g_profile.peak_lexer += worker->peak_lexer;
+    g_profile.peak_parser += worker->peak_parser;
+    g_profile.peak_symtab += worker->peak_symtab;
+}
+
+void prof_memory(size_t lexer, size_t parser, size_t symtab) {
+    PROF_MAX(peak_lexer, lexer);
+    PROF_MAX(peak_parser, parser);
+    PROF_MAX(peak_symtab, symtab);
+}
+
+/**
+ * @brief 단계별 시간(자기 시간), 카운터, 최대 메모리 사용량 요약 출력
+ */
+void prof_report(FILE* fp) {
+    double total = now_sec() - g_profile.start;
+    double phases = 0;
+
+    fprintf(fp, "== profile ==\n");
+    fprintf(fp, "%-10s %12s %12s %7s\n", "phase", "calls", "time ms", "%");
+    for (int p = 0; p < PROF_PHASE_COUNT; ++p) {
+        double sec = g_profile.phase_sec[p];
+        phases += sec;
+        fprintf(fp, "%-10s %12llu %12.3f %6.1f%%\n", PHASE_NAMES[p],
+                (unsigned long long)g_profile.phase_calls[p], sec * 1e3, total > 0 ? sec / total * 100 : 0);
+    }
+    double other = total > phases ? total - phases : 0;
+    fprintf(fp, "%-10s %12s %12.3f %6.1f%%\n", "other", "", other * 1e3, total > 0 ? other / total * 100 : 0);
+    fprintf(fp, "%-10s %12s %12.3f\n", "total", "", total * 1e3);
+
+    fprintf(fp, "\n%-18s %12llu\n", "tokens", (unsigned long long)g_profile.tokens);
+    fprintf(fp, "%-18s %12llu\n", "statements", (unsigned long long)g_profile.stmts);
+    fprintf(fp, "%-18s %12llu", "symbol lookups", (unsigned long long)g_profile.lookups);
+    if (g_profile.lookups) {
+        fprintf(fp, "  (avg probe %.2f, max %llu)", (double)g_profile.probes / (double)g_profile.lookups,
+                (unsigned long long)g_profile.max_probe);
+    }
+    fprintf(fp, "\n%-18s %12llu\n", "diagnostics", (unsigned long long)g_profile.diagnostics);
+
+    fprintf(fp, "\npeak memory\n");
+    fprintf(fp, "%-18s %12.1f KiB\n", "lexer", (double)g_profile.peak_lexer / 1024.0);
+    fprintf(fp, "%-18s %12.1f KiB\n", "parser", (double)g_profile.peak_parser / 1024.0);
+    fprintf(fp, "%-18s %12.1f KiB\n", "symbol table", (double)g_profile.peak_symtab / 1024.0);
+}
+
+#endif
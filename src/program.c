@@ -0,0 +1,70 @@
+//========================================
+// System Includes
+//========================================
+#include "program.h"
+#include "diag.h"
+#include "profile.h"
+#include <stdlib.h>
+#include <string.h>
+
+void prog_init(Program* prog) {
+    prog->stmts = NULL;
+    prog->count = prog->cap = 0;
+    arena_init(&prog->arena, 0);
+}
+
+void prog_free(Program* prog) {
+    free(prog->stmts);
+    arena_free(&prog->arena);
+    prog_init(prog);
+}
+
+/**
+ * @brief 문장 하나를 목록 끝에 추가 (식/문자열은 이미 arena에 있음)
+ */
+static bool prog_push(Program* prog, const Stmt* s) {
+    if (prog->count == prog->cap) {
+        size_t cap = prog->cap ? prog->cap * 2 : 64;
+        Stmt* grown = realloc(prog->stmts, cap * sizeof(Stmt));
+        if (!grown) return false;
+        prog->stmts = grown;
+        prog->cap = cap;
+    }
+    prog->stmts[prog->count++] = *s;
+    return true;
+}
+
+bool prog_take(Program* dst, Program* src) {
+    if (dst->count + src->count > dst->cap) {
+        size_t cap = dst->cap ? dst->cap : 64;
+        while (cap < dst->count + src->count) cap *= 2;
+        Stmt* grown = realloc(dst->stmts, cap * sizeof(Stmt));
+        if (!grown) return false;
+        dst->stmts = grown;
+        dst->cap = cap;
+    }
+    if (src->count) memcpy(dst->stmts + dst->count, src->stmts, src->count * sizeof(Stmt));
+    dst->count += src->count;
+    arena_absorb(&dst->arena, &src->arena);
+    free(src->stmts);
+    src->stmts = NULL;
+    src->count = src->cap = 0;
+    return true;
+}
+
+bool prog_parse(Program* prog, Parser* ps) {
+    Stmt s;
+    for (;;) {
+        PROF_ENTER(PROF_PARSE);
+        bool more = ps_next_stmt(ps, &s);
+        PROF_LEAVE();
+        if (!more || diag_stopped()) break;
+        if (s.kind == STMT_NONE) continue;
+        PROF_COUNT(stmts, 1);
+        if (!prog_push(prog, &s)) {
+            diag_error(DIAG_NOMEM, ps->filename, s.line, s.col, "out of memory");
+            return false;
+        }
+    }
+    return true;
+}
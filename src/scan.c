@@ -0,0 +1,141 @@
+//========================================
+// System Includes
+//========================================
+#include "scan.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+//========================================
+// Scalar (모든 플랫폼)
+//========================================
+static size_t scalar_morse_run(const char* p, const char* end, size_t max, unsigned* dashes) {
+    size_t n = 0;
+    unsigned mask = 0;
+    while (p + n < end && n < max && (p[n] == '.' || p[n] == '-')) {
+        mask |= (unsigned)(p[n] == '-') << n;
+        n++;
+    }
+    *dashes = mask;
+    return n;
+}
+
+static const char* scalar_find_eol(const char* p, const char* end) {
+    const char* q = memchr(p, '\n', (size_t)(end - p));
+    return q ? q : end;
+}
+
+static const char* scalar_find_quote_or_eol(const char* p, const char* end) {
+    while (p < end && *p != '"' && *p != '\n') p++;
+    return p;
+}
+
+static const ScanOps SCALAR_OPS = {
+    "scalar", scalar_morse_run, scalar_find_eol, scalar_find_quote_or_eol,
+};
+
+#ifdef SCAN_X86
+//========================================
+// SSE2 (x86-64 기본)
+// 16바이트를 한 번에 비교하고 movemask로 얻은 비트마스크에서 첫 불일치/일치 위치를 찾는다.
+//========================================
+__attribute__((target("sse2")))
+static size_t sse2_morse_run(const char* p, const char* end, size_t max, unsigned* dashes) {
+    if (end - p < 16 || max > 16) return scalar_morse_run(p, end, max, dashes);
+    __m128i v = _mm_loadu_si128((const __m128i*)p);
+    unsigned dash = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('-')));
+    unsigned dot = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('.')));
+    unsigned other = ~(dash | dot) | (1u << max);   // max 위치에서 강제로 끊음
+    size_t n = (size_t)__builtin_ctz(other);
+    *dashes = dash & ((1u << n) - 1);
+    return n;
+}
+
+__attribute__((target("sse2")))
+static const char* sse2_find_eol(const char* p, const char* end) {
+    const __m128i nl = _mm_set1_epi8('\n');
+    for (; end - p >= 16; p += 16) {
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), nl));
+        if (m) return p + __builtin_ctz(m);
+    }
+    return scalar_find_eol(p, end);
+}
+
+__attribute__((target("sse2")))
+static const char* sse2_find_quote_or_eol(const char* p, const char* end) {
+    const __m128i nl = _mm_set1_epi8('\n');
+    const __m128i quote = _mm_set1_epi8('"');
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, nl), _mm_cmpeq_epi8(v, quote)));
+        if (m) return p + __builtin_ctz(m);
+    }
+    return scalar_find_quote_or_eol(p, end);
+}
+
+static const ScanOps SSE2_OPS = {
+    "sse2", sse2_morse_run, sse2_find_eol, sse2_find_quote_or_eol,
+};
+
+//========================================
+// AVX2
+// 모스 부호 한 덩어리는 최대 16자라 SSE2로 충분하므로, 긴 주석/문자열 스캔만 32바이트씩 처리한다.
+//========================================
+__attribute__((target("avx2")))
+static const char* avx2_find_eol(const char* p, const char* end) {
+    const __m256i nl = _mm256_set1_epi8('\n');
+    for (; end - p >= 32; p += 32) {
+        unsigned m = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)p), nl));
+        if (m) return p + __builtin_ctz(m);
+    }
+    return sse2_find_eol(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* avx2_find_quote_or_eol(const char* p, const char* end) {
+    const __m256i nl = _mm256_set1_epi8('\n');
+    const __m256i quote = _mm256_set1_epi8('"');
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        unsigned m = (unsigned)_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, nl), _mm256_cmpeq_epi8(v, quote)));
+        if (m) return p + __builtin_ctz(m);
+    }
+    return sse2_find_quote_or_eol(p, end);
+}
+
+static const ScanOps AVX2_OPS = {
+    "avx2", sse2_morse_run, avx2_find_eol, avx2_find_quote_or_eol,
+};
+#endif
+
+//========================================
+// Runtime Selection
+//========================================
+static const ScanOps* select_ops(void) {
+    const char* force = getenv("DAHDIT_SIMD");
+    if (force && strcmp(force, "scalar") == 0) return &SCALAR_OPS;
+#ifdef SCAN_X86
+    __builtin_cpu_init();
+    if ((!force || strcmp(force, "sse2") != 0) && __builtin_cpu_supports("avx2")) return &AVX2_OPS;
+    if (__builtin_cpu_supports("sse2")) return &SSE2_OPS;
+#endif
+    return &SCALAR_OPS;
+}
+
+const ScanOps* scan_ops(void) {
+    // 여러 스레드가 동시에 처음 호출해도 같은 값을 고르므로 원자적 저장만 보장하면 된다
+    static _Atomic(const ScanOps*) ops;
+    const ScanOps* cur = atomic_load_explicit(&ops, memory_order_acquire);
+    if (!cur) {
+        cur = select_ops();
+        atomic_store_explicit(&ops, cur, memory_order_release);
+    }
+    return cur;
+}
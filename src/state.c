@@ -0,0 +1,259 @@
+//========================================
+// System Includes
+//========================================
+#include "state.h"
+#include "cache.h"
+#include "version.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <process.h>
+#define getpid _getpid
+#endif
+
+static size_t align8(size_t n) { return (n + 7) & ~(size_t)7; }
+
+static inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+/**
+ * @brief 헤더(checksum 필드 제외)와 내용을 합친 체크섬 (.ditc와 같은 방식)
+ */
+static uint64_t image_checksum(const DitsHeader* h, const char* payload, size_t len) {
+    DitsHeader copy = *h;
+    copy.checksum = 0;
+    return rotl64(cache_hash((const char*)&copy, sizeof(copy)), 17) ^ cache_hash(payload, len);
+}
+
+//========================================
+// 구간 배치 (저장과 불러오기가 같은 계산을 공유)
+//========================================
+typedef struct {
+    size_t values, defined, name_off, hashes, index, names, end;
+} Sections;
+
+static Sections layout(size_t nsyms, size_t index_cap, size_t names_len) {
+    Sections s;
+    size_t off = sizeof(DitsHeader);
+    s.values = off;   off += align8(nsyms * sizeof(int32_t));
+    s.defined = off;  off += align8(nsyms * sizeof(uint8_t));
+    s.name_off = off; off += align8(nsyms * sizeof(uint32_t));
+    s.hashes = off;   off += align8(nsyms * sizeof(uint32_t));
+    s.index = off;    off += align8(index_cap * sizeof(int32_t));
+    s.names = off;    off += names_len;
+    s.end = off;
+    return s;
+}
+
+//========================================
+// Load
+//========================================
+
+/**
+ * @brief 체크섬이 맞더라도 SymTab이 가정하는 불변식을 지키는지 확인 (범위 밖을 읽지 않도록)
+ * 이름은 null-terminated, 이름 오프셋은 풀 안, 인덱스 항목은 0..nsyms이고 빈 칸이 있어 탐색이 끝난다.
+ */
+static bool verify(const char* base, const DitsHeader* h, const Sections* s) {
+    if (h->nsyms == 0) return true;
+    const char* names = base + s->names;
+    if (h->names_len == 0 || names[h->names_len - 1] != '\0') return false;
+
+    const uint32_t* name_off = (const uint32_t*)(base + s->name_off);
+    for (uint64_t i = 0; i < h->nsyms; ++i) {
+        if (name_off[i] >= h->names_len) return false;
+    }
+    const int32_t* index = (const int32_t*)(base + s->index);
+    uint64_t used = 0;
+    for (uint64_t i = 0; i < h->index_cap; ++i) {
+        if (index[i] < 0 || (uint64_t)index[i] > h->nsyms) return false;
+        used += index[i] != 0;
+    }
+    return used == h->nsyms;
+}
+
+/**
+ * @brief 파일 전체를 쓰기 가능한 사본으로 매핑 (mmap이 없으면 읽어서 힙에)
+ * 빈 파일은 map을 NULL로 두고 성공한다 (헤더보다 짧은 파일도 매핑하여 magic을 비교할 수 있게 함).
+ */
+static bool map_file(const char* path, void** map, size_t* size) {
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode)) {
+        close(fd);
+        return false;
+    }
+    *size = (size_t)sb.st_size;
+    if (*size == 0) {
+        close(fd);
+        *map = NULL;
+        return true;
+    }
+    *map = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    return *map != MAP_FAILED;
+#else
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;
+    long len = fseek(fp, 0, SEEK_END) == 0 ? ftell(fp) : -1;
+    *map = NULL;
+    *size = len > 0 ? (size_t)len : 0;
+    bool ok = len >= 0;
+    if (ok && *size > 0) {
+        *map = malloc(*size);
+        ok = *map && fseek(fp, 0, SEEK_SET) == 0 && fread(*map, 1, *size, fp) == *size;
+        if (!ok) { free(*map); *map = NULL; }
+    }
+    fclose(fp);
+    return ok;
+#endif
+}
+
+static void unmap_file(void* map, size_t size) {
+#ifndef _WIN32
+    if (map) munmap(map, size);
+#else
+    (void)size;
+    free(map);
+#endif
+}
+
+/**
+ * @brief 상태 이미지를 검증한 뒤 st가 매핑의 배열을 직접 가리키게 함
+ *
+ * 헤더의 형식/버전이 다르면 STATE_STALE, 크기·체크섬·구조가 맞지 않으면 STATE_CORRUPT로
+ * 거부하며, 그 경우 st는 건드리지 않는다. 헤더보다 짧아도 있는 만큼의 magic이 맞으면
+ * 잘린 이미지로 보고 STATE_CORRUPT이다.
+ */
+StateStatus state_load(StateImage* img, const char* path, SymTab* st) {
+    memset(img, 0, sizeof(*img));
+    void* map;
+    size_t size;
+    if (!map_file(path, &map, &size)) return STATE_CANNOT_OPEN;
+
+    const DitsHeader* h = map;
+    StateStatus status = STATE_OK;
+    char version[sizeof(h->version)] = {0};
+    strncpy(version, DAHDIT_VERSION, sizeof(version) - 1);
+    if (!map || memcmp(h->magic, DITS_MAGIC, size < 4 ? size : 4) != 0) {
+        status = STATE_NOT_IMAGE;
+    } else if (size < sizeof(DitsHeader)) {
+        status = STATE_CORRUPT;
+    } else if (h->format != DITS_FORMAT || memcmp(h->version, version, sizeof(version)) != 0) {
+        status = STATE_STALE;
+    } else if (h->nsyms > size || h->names_len > size || h->index_cap > size ||
+               h->nsyms > INT32_MAX || (h->index_cap & (h->index_cap - 1)) != 0 ||
+               (h->nsyms > 0 && h->index_cap < 2 * h->nsyms)) {
+        status = STATE_CORRUPT;
+    }
+
+    Sections s = {0};
+    if (status == STATE_OK) {
+        s = layout((size_t)h->nsyms, (size_t)h->index_cap, (size_t)h->names_len);
+        const char* payload = (const char*)map + sizeof(DitsHeader);
+        if (s.end != size || image_checksum(h, payload, size - sizeof(DitsHeader)) != h->checksum ||
+            !verify(map, h, &s)) {
+            status = STATE_CORRUPT;
+        }
+    }
+    if (status != STATE_OK) {
+        unmap_file(map, size);
+        return status;
+    }
+
+    if (h->nsyms > 0) {
+        char* base = map;
+        st_free(st);
+        st->values = (int32_t*)(base + s.values);
+        st->defined = (uint8_t*)(base + s.defined);
+        st->name_off = (uint32_t*)(base + s.name_off);
+        st->hashes = (uint32_t*)(base + s.hashes);
+        st->count = st->cap = (int)h->nsyms;
+        st->names = base + s.names;
+        st->names_len = st->names_cap = (size_t)h->names_len;
+        st->index = (int32_t*)(base + s.index);
+        st->index_cap = (uint32_t)h->index_cap;
+        st->borrowed = true;
+    }
+    img->map = map;
+    img->size = size;
+    return STATE_OK;
+}
+
+void state_close(StateImage* img) {
+    if (img->map) unmap_file(img->map, img->size);
+    memset(img, 0, sizeof(*img));
+}
+
+const char* state_error(StateStatus status) {
+    switch (status) {
+        case STATE_OK: return "ok";
+        case STATE_CANNOT_OPEN: return "cannot open";
+        case STATE_NOT_IMAGE: return "not a dahdit state image";
+        case STATE_STALE: return "image was written by a different dahdit version";
+        case STATE_CORRUPT: return "image is corrupt (checksum or layout mismatch)";
+        case STATE_NOMEM: return "out of memory";
+    }
+    return "unknown error";
+}
+
+//========================================
+// Save (임시 파일에 쓴 뒤 rename)
+//========================================
+
+bool state_save(const char* path, const SymTab* st) {
+    DitsHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, DITS_MAGIC, 4);
+    h.format = DITS_FORMAT;
+    strncpy(h.version, DAHDIT_VERSION, sizeof(h.version) - 1);
+    size_t n = (size_t)st->count;
+    if (n > 0) {
+        h.nsyms = n;
+        h.names_len = st->names_len;
+        h.index_cap = st->index_cap;
+    }
+
+    // 헤더와 내용을 한 버퍼에 배치하고, 패딩은 0으로 채워 같은 상태면 같은 파일이 되게 함
+    Sections s = layout(n, (size_t)h.index_cap, (size_t)h.names_len);
+    char* base = calloc(s.end, 1);
+    if (!base) return false;
+    char* payload = base + sizeof(DitsHeader);
+    size_t payload_len = s.end - sizeof(DitsHeader);
+    if (n > 0) {
+        memcpy(base + s.values, st->values, n * sizeof(int32_t));
+        memcpy(base + s.defined, st->defined, n * sizeof(uint8_t));
+        memcpy(base + s.name_off, st->name_off, n * sizeof(uint32_t));
+        memcpy(base + s.hashes, st->hashes, n * sizeof(uint32_t));
+        memcpy(base + s.index, st->index, (size_t)h.index_cap * sizeof(int32_t));
+        memcpy(base + s.names, st->names, (size_t)h.names_len);
+    }
+    h.checksum = image_checksum(&h, payload, payload_len);
+    memcpy(base, &h, sizeof(h));
+
+    size_t plen = strlen(path);
+    char* tmp = malloc(plen + 48);
+    FILE* fp = NULL;
+    if (tmp) {
+        static atomic_uint seq;
+        snprintf(tmp, plen + 48, "%s.%ld.%u.tmp", path, (long)getpid(), atomic_fetch_add(&seq, 1));
+        fp = fopen(tmp, "wb");
+    }
+    if (!fp) { free(tmp); free(base); return false; }
+
+    bool ok = fwrite(base, 1, s.end, fp) == s.end;
+    if (fclose(fp) != 0) ok = false;
+    if (ok) ok = rename(tmp, path) == 0;
+    if (!ok) remove(tmp);
+    free(tmp);
+    free(base);
+    return ok;
+}
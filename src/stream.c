@@ -0,0 +1,104 @@
+//========================================
+// System Includes
+//========================================
+#include "stream.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <io.h>
+#define read _read
+#endif
+
+void ss_init(SourceStream* ss, int fd) {
+    memset(ss, 0, sizeof(*ss));
+    ss->fd = fd;
+}
+
+void ss_free(SourceStream* ss) {
+    free(ss->buf);
+    memset(ss, 0, sizeof(*ss));
+}
+
+/**
+ * @brief scanned 이후를 검사하여 마지막 문장 경계(문자열/주석 밖의 ';' 직후)를 찾음
+ * 문자열 리터럴과 주석은 줄바꿈에서 끝나므로 렉서와 같은 규칙으로 상태만 이어서 추적한다.
+ * @return 경계 위치, 없으면 0.
+ */
+static size_t scan_boundary(SourceStream* ss) {
+    const char* buf = ss->buf;
+    size_t i = ss->scanned, split = 0;
+    bool in_string = ss->in_string, in_comment = ss->in_comment;
+    while (i < ss->len) {
+        if (in_comment) {
+            const char* nl = memchr(buf + i, '\n', ss->len - i);
+            if (!nl) { i = ss->len; break; }
+            i = (size_t)(nl - buf) + 1;
+            in_comment = false;
+            continue;
+        }
+        char c = buf[i++];
+        if (in_string) {
+            if (c == '"' || c == '\n') in_string = false;
+        } else if (c == '"') {
+            in_string = true;
+        } else if (c == '#') {
+            in_comment = true;
+        } else if (c == ';') {
+            split = i;
+        }
+    }
+    ss->scanned = i;
+    ss->in_string = in_string;
+    ss->in_comment = in_comment;
+    return split;
+}
+
+/**
+ * @brief 입력을 한 번 read() (도착한 만큼만 받고 바로 돌아옴)
+ */
+static void fill(SourceStream* ss) {
+    if (ss->cap - ss->len < SS_READ_SIZE) {
+        size_t cap = ss->cap ? ss->cap : SS_READ_SIZE;
+        while (cap - ss->len < SS_READ_SIZE) cap *= 2;
+        char* grown = realloc(ss->buf, cap);
+        if (!grown) { ss->nomem = ss->eof = true; return; }
+        ss->buf = grown; ss->cap = cap;
+    }
+    for (;;) {
+        long n = (long)read(ss->fd, ss->buf + ss->len, SS_READ_SIZE);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) ss->failed = true;
+        if (n <= 0) ss->eof = true;
+        else ss->len += (size_t)n;
+        return;
+    }
+}
+
+/**
+ * @brief 다음 완결된 문장 묶음을 돌려줌 (직전에 돌려준 부분은 버퍼에서 제거)
+ */
+bool ss_next(SourceStream* ss, const char** data, size_t* size) {
+    if (ss->taken) {
+        memmove(ss->buf, ss->buf + ss->taken, ss->len - ss->taken);
+        ss->len -= ss->taken;
+        ss->scanned -= ss->taken;
+        ss->taken = 0;
+    }
+
+    for (;;) {
+        size_t split = scan_boundary(ss);
+        if (split == 0 && ss->eof) split = ss->len;
+        if (split > 0) {
+            *data = ss->buf;
+            *size = split;
+            ss->taken = split;
+            return true;
+        }
+        if (ss->eof) return false;
+        fill(ss);
+    }
+}
@@ -2,6 +2,8 @@
 // System Includes
 //========================================
 #include "symtab.h"
+#include "profile.h"
+#include <stdlib.h>
 #include <string.h>
 
 
@@ -9,32 +11,199 @@ void st_init(SymTab* st) {
     memset(st, 0, sizeof(*st));
 }
 
-bool st_set(SymTab* st, const char* name, int32_t value) {
-    // update if exists
-    for (int i = 0; i < MAX_SYMS; ++i) {
-        if (st->syms[i].used && strcmp(st->syms[i].name, name) == 0) {
-            st->syms[i].value = value; return true;
-        }
+void st_free(SymTab* st) {
+    if (st->borrowed) { st_init(st); return; }
+    free(st->values);
+    free(st->defined);
+    free(st->name_off);
+    free(st->hashes);
+    free(st->names);
+    free(st->index);
+    st_init(st);
+}
+
+/**
+ * @brief 모든 이름과 값을 지우되 확보한 배열은 그대로 둠 (컨텍스트를 여러 번 실행할 때)
+ */
+void st_clear(SymTab* st) {
+    st->count = 0;
+    st->names_len = 0;
+    st->generation++;
+    if (st->index) memset(st->index, 0, st->index_cap * sizeof(*st->index));
+}
+
+/**
+ * @brief 이름 해시 (FNV-1a 32-bit)
+ */
+static uint32_t hash_name(const char* name, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= (unsigned char)name[i];
+        h *= 16777619u;
     }
-    // insert new
-    for (int i = 0; i < MAX_SYMS; ++i) {
-        if (!st->syms[i].used) {
-            strncpy(st->syms[i].name, name, MAX_NAME-1);
-            st->syms[i].name[MAX_NAME-1] = '\0';
-            st->syms[i].value = value;
-            st->syms[i].used = true;
-            return true;
-        }
+    return h;
+}
+
+/**
+ * @brief 빌린 배열(상태 이미지)을 힙으로 복사하여 늘리거나 해제할 수 있게 함
+ * 값을 바꾸는 것은 매핑이 copy-on-write이므로 복사 없이 가능하고, 새 이름을 등록할 때만 필요하다.
+ */
+static void* dup_array(const void* src, size_t size) {
+    void* p = malloc(size ? size : 1);
+    if (p && size) memcpy(p, src, size);
+    return p;
+}
+
+static bool own_arrays(SymTab* st) {
+    size_t cap = (size_t)st->cap;
+    int32_t* values = dup_array(st->values, cap * sizeof(*values));
+    uint8_t* defined = dup_array(st->defined, cap * sizeof(*defined));
+    uint32_t* name_off = dup_array(st->name_off, cap * sizeof(*name_off));
+    uint32_t* hashes = dup_array(st->hashes, cap * sizeof(*hashes));
+    char* names = dup_array(st->names, st->names_cap);
+    int32_t* index = dup_array(st->index, st->index_cap * sizeof(*index));
+    if (!values || !defined || !name_off || !hashes || !names || !index) {
+        free(values); free(defined); free(name_off); free(hashes); free(names); free(index);
+        return false;
     }
-    return false;
+    st->values = values;
+    st->defined = defined;
+    st->name_off = name_off;
+    st->hashes = hashes;
+    st->names = names;
+    st->index = index;
+    st->borrowed = false;
+    return true;
 }
 
-bool st_get(SymTab* st, const char* name, int32_t* out) {
-    for (int i = 0; i < MAX_SYMS; ++i) {
-        if (st->syms[i].used && strcmp(st->syms[i].name, name) == 0) {
-            if (out) *out = st->syms[i].value;
-            return true;
+/**
+ * @brief 해시 인덱스를 새 크기로 다시 구성
+ */
+static bool rehash(SymTab* st, uint32_t new_cap) {
+    int32_t* index = calloc(new_cap, sizeof(int32_t));
+    if (!index) return false;
+    uint32_t mask = new_cap - 1;
+    for (int slot = 0; slot < st->count; ++slot) {
+        uint32_t i = st->hashes[slot] & mask;
+        while (index[i] != 0) i = (i + 1) & mask;
+        index[i] = slot + 1;
+    }
+    free(st->index);
+    st->index = index;
+    st->index_cap = new_cap;
+    return true;
+}
+
+/**
+ * @brief 슬롯별 배열 용량 확보
+ */
+static bool grow_slots(SymTab* st) {
+    int cap = st->cap ? st->cap * 2 : 64;
+    int32_t* values = realloc(st->values, (size_t)cap * sizeof(*values));
+    if (values) st->values = values;
+    uint8_t* defined = realloc(st->defined, (size_t)cap * sizeof(*defined));
+    if (defined) st->defined = defined;
+    uint32_t* name_off = realloc(st->name_off, (size_t)cap * sizeof(*name_off));
+    if (name_off) st->name_off = name_off;
+    uint32_t* hashes = realloc(st->hashes, (size_t)cap * sizeof(*hashes));
+    if (hashes) st->hashes = hashes;
+    if (!values || !defined || !name_off || !hashes) return false;
+    st->cap = cap;
+    return true;
+}
+
+/**
+ * @brief 해시 인덱스에서 이름을 찾음
+ * @return 슬롯 번호, 없으면 -1. *pos에는 찾은 칸(또는 삽입할 빈 칸) 위치.
+ */
+static int find(const SymTab* st, const char* name, size_t len, uint32_t h, uint32_t* pos) {
+    uint32_t mask = st->index_cap - 1;
+    uint32_t i = h & mask;
+    uint32_t probes = 1;
+    int slot = -1;
+    for (;; ++probes) {
+        int32_t e = st->index[i];
+        if (e == 0) break;
+        if (st->hashes[e - 1] == h) {
+            const char* cand = st->names + st->name_off[e - 1];
+            if (strncmp(cand, name, len) == 0 && cand[len] == '\0') { slot = e - 1; break; }
         }
+        i = (i + 1) & mask;
+    }
+    PROF_COUNT(lookups, 1);
+    PROF_COUNT(probes, probes);
+    PROF_MAX(max_probe, probes);
+    (void)probes;
+    *pos = i;
+    return slot;
+}
+
+int st_lookup(const SymTab* st, const char* name, size_t len) {
+    if (st->count == 0) return -1;
+    uint32_t pos;
+    return find(st, name, len, hash_name(name, len), &pos);
+}
+
+/**
+ * @brief 이름에 해당하는 슬롯을 찾고, 없으면 미정의 상태로 새로 등록
+ * @return 슬롯 번호, 메모리를 확보하지 못하면 -1.
+ */
+int st_intern(SymTab* st, const char* name, size_t len) {
+    uint32_t h = hash_name(name, len);
+    uint32_t pos;
+
+    if (st->index_cap == 0 && !rehash(st, 128)) return -1;
+    int slot = find(st, name, len, h, &pos);
+    if (slot >= 0) return slot;
+
+    // 새 슬롯 등록 (적재율 1/2 유지)
+    if (st->borrowed && !own_arrays(st)) return -1;
+    if ((uint32_t)(st->count + 1) * 2 > st->index_cap) {
+        if (!rehash(st, st->index_cap * 2)) return -1;
+        find(st, name, len, h, &pos);
+    }
+    if (st->count == st->cap && !grow_slots(st)) return -1;
+    if (st->names_len + len + 1 > st->names_cap) {
+        size_t cap = st->names_cap ? st->names_cap : 1024;
+        while (cap < st->names_len + len + 1) cap *= 2;
+        char* names = realloc(st->names, cap);
+        if (!names) return -1;
+        st->names = names;
+        st->names_cap = cap;
     }
-    return false;
+
+    slot = st->count++;
+    memcpy(st->names + st->names_len, name, len);
+    st->names[st->names_len + len] = '\0';
+    st->name_off[slot] = (uint32_t)st->names_len;
+    st->names_len += len + 1;
+    st->hashes[slot] = h;
+    st->values[slot] = 0;
+    st->defined[slot] = 0;
+    st->index[pos] = slot + 1;
+    return slot;
+}
+
+size_t st_memory(const SymTab* st) {
+    size_t per_slot = sizeof(*st->values) + sizeof(*st->defined) + sizeof(*st->name_off) + sizeof(*st->hashes);
+    return (size_t)st->cap * per_slot + (size_t)st->index_cap * sizeof(*st->index) + st->names_cap;
+}
+
+const char* st_name(const SymTab* st, int slot) {
+    return st->names + st->name_off[slot];
+}
+
+bool st_set(SymTab* st, const char* name, int32_t value) {
+    int slot = st_intern(st, name, strlen(name));
+    if (slot < 0) return false;
+    st->values[slot] = value;
+    st->defined[slot] = 1;
+    return true;
+}
+
+bool st_get(SymTab* st, const char* name, int32_t* out) {
+    int slot = st_lookup(st, name, strlen(name));
+    if (slot < 0 || !st->defined[slot]) return false;
+    if (out) *out = st->values[slot];
+    return true;
 }
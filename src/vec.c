@@ -0,0 +1,221 @@
+//========================================
+// System Includes
+//========================================
+#include "vec.h"
+#include "arith.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define VEC_X86 1
+#include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+//========================================
+// Aligned Storage
+//========================================
+int32_t* vec_alloc(size_t n) {
+    if (n > (SIZE_MAX - VEC_ALIGN) / sizeof(int32_t)) return NULL;
+    // aligned_alloc은 크기가 정렬 단위의 배수여야 한다 (길이 0도 버퍼 하나를 가짐)
+    size_t size = (n * sizeof(int32_t) + VEC_ALIGN - 1) / VEC_ALIGN * VEC_ALIGN;
+    if (size == 0) size = VEC_ALIGN;
+#ifdef _WIN32
+    return _aligned_malloc(size, VEC_ALIGN);
+#else
+    return aligned_alloc(VEC_ALIGN, size);
+#endif
+}
+
+void vec_free(int32_t* p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+//========================================
+// Kernel Generator
+// 연산 하나(STEP: 레지스터 하나의 W개 원소, ONE: 원소 하나)로 세 가지 모양의 커널을 만든다.
+// W개가 안 되는 끝부분은 ONE으로 처리한다. 저장소는 정렬되어 있지만 loadu/storeu로 접근해도
+// 정렬된 주소에서는 비용이 같으므로, 커널은 정렬을 가정하지 않는다.
+//========================================
+#define DEFINE_KERNELS(ATTR, isa, op, W, V, LOAD, STORE, SET1, STEP, ONE)                        \
+    ATTR static void isa##_##op##_both(int32_t* dst, const int32_t* a, const int32_t* b, size_t n) { \
+        size_t i = 0;                                                                          \
+        for (; i + (W) <= n; i += (W)) STORE(dst + i, STEP(LOAD(a + i), LOAD(b + i)));         \
+        for (; i < n; ++i) dst[i] = ONE(a[i], b[i]);                                           \
+    }                                                                                          \
+    ATTR static void isa##_##op##_left(int32_t* dst, const int32_t* a, const int32_t* b, size_t n) { \
+        const int32_t s = b[0];                                                                \
+        const V vs = SET1(s);                                                                  \
+        size_t i = 0;                                                                          \
+        for (; i + (W) <= n; i += (W)) STORE(dst + i, STEP(LOAD(a + i), vs));                  \
+        for (; i < n; ++i) dst[i] = ONE(a[i], s);                                              \
+    }                                                                                          \
+    ATTR static void isa##_##op##_right(int32_t* dst, const int32_t* a, const int32_t* b, size_t n) { \
+        const int32_t s = a[0];                                                                \
+        const V vs = SET1(s);                                                                  \
+        size_t i = 0;                                                                          \
+        for (; i + (W) <= n; i += (W)) STORE(dst + i, STEP(vs, LOAD(b + i)));                  \
+        for (; i < n; ++i) dst[i] = ONE(s, b[i]);                                              \
+    }
+
+// EXPR_OP_* 순서의 커널 표 (VecOps.kernel)
+#define KERNEL_TABLE(isa)                                                                      \
+    {                                                                                          \
+        { NULL, NULL, NULL, NULL, NULL },                                                      \
+        { isa##_add_left, isa##_sub_left, isa##_mul_left, isa##_div_left, isa##_mod_left },    \
+        { isa##_add_right, isa##_sub_right, isa##_mul_right, isa##_div_right, isa##_mod_right }, \
+        { isa##_add_both, isa##_sub_both, isa##_mul_both, isa##_div_both, isa##_mod_both },    \
+    }
+
+#define DEFINE_ALL_KERNELS(ATTR, isa, W, V, LOAD, STORE, SET1)                                  \
+    DEFINE_KERNELS(ATTR, isa, add, W, V, LOAD, STORE, SET1, isa##_add_step, ar_add)            \
+    DEFINE_KERNELS(ATTR, isa, sub, W, V, LOAD, STORE, SET1, isa##_sub_step, ar_sub)            \
+    DEFINE_KERNELS(ATTR, isa, mul, W, V, LOAD, STORE, SET1, isa##_mul_step, ar_mul)            \
+    DEFINE_KERNELS(ATTR, isa, div, W, V, LOAD, STORE, SET1, isa##_div_step, ar_div)            \
+    DEFINE_KERNELS(ATTR, isa, mod, W, V, LOAD, STORE, SET1, isa##_mod_step, ar_mod)
+
+//========================================
+// Scalar (모든 플랫폼)
+// 레지스터 하나가 원소 하나인 경우로 같은 생성기를 쓴다.
+//========================================
+#define SCALAR_ATTR
+#define SCALAR_LOAD(p) (*(p))
+#define SCALAR_STORE(p, v) (*(p) = (v))
+#define SCALAR_SET1(s) (s)
+#define scalar_add_step ar_add
+#define scalar_sub_step ar_sub
+#define scalar_mul_step ar_mul
+#define scalar_div_step ar_div
+#define scalar_mod_step ar_mod
+
+DEFINE_ALL_KERNELS(SCALAR_ATTR, scalar, 1, int32_t, SCALAR_LOAD, SCALAR_STORE, SCALAR_SET1)
+
+static bool scalar_has_zero(const int32_t* p, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (p[i] == 0) return true;
+    }
+    return false;
+}
+
+static const VecOps SCALAR_OPS = { "scalar", KERNEL_TABLE(scalar), scalar_has_zero };
+
+#ifdef VEC_X86
+//========================================
+// SSE2 (x86-64 기본, 4개씩)
+// SSE2에는 32비트 곱셈(pmulld)이 없으므로 짝/홀 원소를 64비트 곱(pmuludq)으로 나눠 곱하고 아래 32비트를 모은다.
+// 정수 나눗셈 명령이 없으므로 double로 나눈 뒤 버림한다: int32 두 값의 몫은 double로 정확히 반올림되지 않아도
+// 정수 경계를 넘지 않으므로 C의 버림 규칙과 같고, INT32_MIN / -1은 변환 범위를 넘어 INT32_MIN이 된다 (ar_div와 같음).
+// 나머지는 a - (a / b) * b (wrap-around)로 구하며 b == -1이면 0이 된다.
+//========================================
+#define SSE2_ATTR __attribute__((target("sse2")))
+#define SSE2_LOAD(p) _mm_loadu_si128((const __m128i*)(p))
+#define SSE2_STORE(p, v) _mm_storeu_si128((__m128i*)(p), (v))
+#define SSE2_SET1(s) _mm_set1_epi32(s)
+
+SSE2_ATTR static inline __m128i sse2_add_step(__m128i a, __m128i b) { return _mm_add_epi32(a, b); }
+SSE2_ATTR static inline __m128i sse2_sub_step(__m128i a, __m128i b) { return _mm_sub_epi32(a, b); }
+
+SSE2_ATTR static inline __m128i sse2_mul_step(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);                                         // 원소 0, 2
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));  // 원소 1, 3
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+SSE2_ATTR static inline __m128i sse2_div_step(__m128i a, __m128i b) {
+    __m128i lo = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(a), _mm_cvtepi32_pd(b)));
+    __m128i hi = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(a, _MM_SHUFFLE(3, 2, 3, 2))),
+                                             _mm_cvtepi32_pd(_mm_shuffle_epi32(b, _MM_SHUFFLE(3, 2, 3, 2)))));
+    return _mm_unpacklo_epi64(lo, hi);
+}
+
+SSE2_ATTR static inline __m128i sse2_mod_step(__m128i a, __m128i b) {
+    return _mm_sub_epi32(a, sse2_mul_step(sse2_div_step(a, b), b));
+}
+
+DEFINE_ALL_KERNELS(SSE2_ATTR, sse2, 4, __m128i, SSE2_LOAD, SSE2_STORE, SSE2_SET1)
+
+SSE2_ATTR static bool sse2_has_zero(const int32_t* p, size_t n) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(SSE2_LOAD(p + i), zero))) return true;
+    }
+    return scalar_has_zero(p + i, n - i);
+}
+
+static const VecOps SSE2_OPS = { "sse2", KERNEL_TABLE(sse2), sse2_has_zero };
+
+//========================================
+// AVX2 (8개씩)
+// 나눗셈은 128비트 반쪽마다 double 4개로 나눈다 (SSE2와 같은 방법).
+//========================================
+#define AVX2_ATTR __attribute__((target("avx2")))
+#define AVX2_LOAD(p) _mm256_loadu_si256((const __m256i*)(p))
+#define AVX2_STORE(p, v) _mm256_storeu_si256((__m256i*)(p), (v))
+#define AVX2_SET1(s) _mm256_set1_epi32(s)
+
+AVX2_ATTR static inline __m256i avx2_add_step(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
+AVX2_ATTR static inline __m256i avx2_sub_step(__m256i a, __m256i b) { return _mm256_sub_epi32(a, b); }
+AVX2_ATTR static inline __m256i avx2_mul_step(__m256i a, __m256i b) { return _mm256_mullo_epi32(a, b); }
+
+AVX2_ATTR static inline __m128i avx2_div_half(__m128i a, __m128i b) {
+    return _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(a), _mm256_cvtepi32_pd(b)));
+}
+
+AVX2_ATTR static inline __m256i avx2_div_step(__m256i a, __m256i b) {
+    __m128i lo = avx2_div_half(_mm256_castsi256_si128(a), _mm256_castsi256_si128(b));
+    __m128i hi = avx2_div_half(_mm256_extracti128_si256(a, 1), _mm256_extracti128_si256(b, 1));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+AVX2_ATTR static inline __m256i avx2_mod_step(__m256i a, __m256i b) {
+    return _mm256_sub_epi32(a, _mm256_mullo_epi32(avx2_div_step(a, b), b));
+}
+
+DEFINE_ALL_KERNELS(AVX2_ATTR, avx2, 8, __m256i, AVX2_LOAD, AVX2_STORE, AVX2_SET1)
+
+AVX2_ATTR static bool avx2_has_zero(const int32_t* p, size_t n) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(AVX2_LOAD(p + i), zero))) return true;
+    }
+    return scalar_has_zero(p + i, n - i);
+}
+
+static const VecOps AVX2_OPS = { "avx2", KERNEL_TABLE(avx2), avx2_has_zero };
+#endif
+
+//========================================
+// Runtime Selection (scan.c와 같은 규칙)
+//========================================
+static const VecOps* select_ops(void) {
+    const char* force = getenv("DAHDIT_SIMD");
+    if (force && strcmp(force, "scalar") == 0) return &SCALAR_OPS;
+#ifdef VEC_X86
+    __builtin_cpu_init();
+    if ((!force || strcmp(force, "sse2") != 0) && __builtin_cpu_supports("avx2")) return &AVX2_OPS;
+    if (__builtin_cpu_supports("sse2")) return &SSE2_OPS;
+#endif
+    return &SCALAR_OPS;
+}
+
+const VecOps* vec_ops(void) {
+    static _Atomic(const VecOps*) ops;
+    const VecOps* cur = atomic_load_explicit(&ops, memory_order_acquire);
+    if (!cur) {
+        cur = select_ops();
+        atomic_store_explicit(&ops, cur, memory_order_release);
+    }
+    return cur;
+}
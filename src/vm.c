@@ -0,0 +1,495 @@
+//========================================
+// System Includes
+//========================================
+#include "vm.h"
+#include "arith.h"
+#include "diag.h"
+#include "vec.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void vm_init(VM* vm, SymTab* st, const char* filename, Output* out) {
+    vm->st = st;
+    vm->filename = filename;
+    vm->out = out;
+    vm->stack = NULL;
+    vm->stack_cap = 0;
+    vm->frames = NULL;
+    vm->frames_cap = 0;
+    vm->arrays = NULL;
+    vm->arrays_cap = 0;
+    vm->vecs = NULL;
+    vm->vecs_cap = 0;
+}
+
+void vm_free(VM* vm) {
+    for (size_t i = 0; i < vm->arrays_cap; ++i) vec_free(vm->arrays[i].data);
+    for (size_t i = 0; i < vm->vecs_cap; ++i) vec_free(vm->vecs[i].buf);
+    free(vm->stack);
+    free(vm->frames);
+    free(vm->arrays);
+    free(vm->vecs);
+    vm->stack = NULL;
+    vm->stack_cap = 0;
+    vm->frames = NULL;
+    vm->frames_cap = 0;
+    vm->arrays = NULL;
+    vm->arrays_cap = 0;
+    vm->vecs = NULL;
+    vm->vecs_cap = 0;
+}
+
+void vm_reset_arrays(VM* vm) {
+    for (size_t i = 0; i < vm->arrays_cap; ++i) vm->arrays[i].len = 0;
+}
+
+/**
+ * @brief 스택을 최소 depth 칸으로 늘림 (호출이 깊어질 때를 위해 두 배씩)
+ * @return 메모리 부족이거나 int 범위를 넘으면 false.
+ */
+bool vm_reserve(VM* vm, int64_t depth) {
+    if (depth <= vm->stack_cap) return true;
+    if (depth > INT_MAX) return false;
+    int64_t cap = (int64_t)vm->stack_cap * 2;
+    if (cap < depth) cap = depth;
+    if (cap > INT_MAX) cap = INT_MAX;
+    int32_t* grown = realloc(vm->stack, (size_t)cap * sizeof(int32_t));
+    if (!grown) return false;
+    vm->stack = grown;
+    vm->stack_cap = (int)cap;
+    return true;
+}
+
+/**
+ * @brief 프레임 기록 배열을 need 개 이상으로 늘림
+ */
+static bool reserve_frames(VM* vm, int need) {
+    if (need <= vm->frames_cap) return true;
+    int cap = vm->frames_cap ? vm->frames_cap * 2 : 64;
+    while (cap < need) cap *= 2;
+    VmFrame* grown = realloc(vm->frames, (size_t)cap * sizeof(VmFrame));
+    if (!grown) return false;
+    vm->frames = grown;
+    vm->frames_cap = cap;
+    return true;
+}
+
+/**
+ * @brief 표 *arr(원소 크기 elem)를 need 칸 이상으로 늘리고 새 칸은 0으로
+ */
+static bool grow_zeroed(void** arr, size_t* cap, size_t need, size_t elem) {
+    if (need <= *cap) return true;
+    size_t n = *cap ? *cap * 2 : 64;
+    while (n < need) n *= 2;
+    char* grown = realloc(*arr, n * elem);
+    if (!grown) return false;
+    memset(grown + *cap * elem, 0, (n - *cap) * elem);
+    *arr = grown;
+    *cap = n;
+    return true;
+}
+
+/**
+ * @brief 슬롯의 배열이 원소 n개를 담을 수 있게 함 (모자라면 새 버퍼로 바꾸고 내용은 버림)
+ * @return 배열, 메모리 부족이면 NULL.
+ */
+static VmArray* array_with_room(VM* vm, int32_t slot, size_t n) {
+    if (!grow_zeroed((void**)&vm->arrays, &vm->arrays_cap, (size_t)slot + 1, sizeof(VmArray))) return NULL;
+    VmArray* arr = &vm->arrays[slot];
+    if (arr->cap < n || !arr->data) {
+        int32_t* data = vec_alloc(n);
+        if (!data) return NULL;
+        vec_free(arr->data);
+        arr->data = data;
+        arr->cap = n;
+    }
+    return arr;
+}
+
+/**
+ * @brief 런타임 오류를 문장 위치로 진단 (인터프리터와 JIT 코드가 같은 메시지를 내도록 공유)
+ * @return 계속 실행하면 true, 오류 수 제한(--max-errors)에 도달했으면 false.
+ */
+bool vm_report(const VM* vm, const StmtInfo* at, VmError err, int32_t slot) {
+    switch (err) {
+        case VM_ERR_UNDEFINED: {
+            char msg[96];
+            snprintf(msg, sizeof(msg), "undefined variable '%s'", st_name(vm->st, slot));
+            diag_error(DIAG_UNDEFINED, vm->filename, at->line, at->col, msg);
+            break;
+        }
+        case VM_ERR_DIV_ZERO:
+            diag_error(DIAG_DIV_ZERO, vm->filename, at->line, at->col, "Division by zero");
+            break;
+        case VM_ERR_MOD_ZERO:
+            diag_error(DIAG_DIV_ZERO, vm->filename, at->line, at->col, "Modulo by zero");
+            break;
+        case VM_ERR_CALL_DEPTH: {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "call depth exceeds %d", VM_MAX_CALL_DEPTH);
+            diag_error(DIAG_CALL_DEPTH, vm->filename, at->line, at->col, msg);
+            break;
+        }
+        case VM_ERR_INDEX: {
+            char msg[96];
+            snprintf(msg, sizeof(msg), "index out of range for array '%s'", st_name(vm->st, slot));
+            diag_error(DIAG_INDEX, vm->filename, at->line, at->col, msg);
+            break;
+        }
+        case VM_ERR_ARRAY_LENGTH: {
+            char msg[96];
+            snprintf(msg, sizeof(msg), "negative length for array '%s'", st_name(vm->st, slot));
+            diag_error(DIAG_ARRAY_LENGTH, vm->filename, at->line, at->col, msg);
+            break;
+        }
+        case VM_ERR_LENGTH_MISMATCH:
+            diag_error(DIAG_ARRAY_LENGTH, vm->filename, at->line, at->col, "array lengths differ");
+            break;
+    }
+    return !diag_stopped();
+}
+
+//========================================
+// Dispatch (명령어 분기)
+// GCC/Clang에서는 computed goto로 각 명령어 끝에서 다음 핸들러로 바로 점프한다 (direct threading).
+// 분기 지점이 명령어마다 따로 생기므로 반복문 본문처럼 같은 순서가 되풀이될 때 분기 예측이 잘 맞는다.
+// 그 밖의 컴파일러나 DAHDIT_NO_COMPUTED_GOTO를 정의하면 같은 핸들러를 switch 루프로 실행한다.
+//========================================
+#if defined(__GNUC__) && !defined(DAHDIT_NO_COMPUTED_GOTO)
+#define VM_THREADED 1
+#pragma GCC diagnostic ignored "-Wpedantic"
+#define VM_DISPATCH() do { in = code[pc++]; goto *labels[in.op < OP_COUNT ? in.op : OP_COUNT]; } while (0)
+#define VM_OP(op) L_##op:
+#define VM_NEXT() VM_DISPATCH()
+#define VM_DEFAULT L_OP_COUNT:
+#else
+#define VM_THREADED 0
+#define VM_DISPATCH() do { in = code[pc++]; goto dispatch; } while (0)
+#define VM_OP(op) case op:
+#define VM_NEXT() break
+#define VM_DEFAULT default:
+#endif
+
+/**
+ * @brief chunk를 entry부터 OP_HALT까지 실행
+ *
+ * 스택 깊이는 컴파일 시 검증되었으므로 실행 중에는 오버플로 검사를 하지 않는다.
+ * 하위 루틴 호출은 인자가 놓인 자리에서 프레임을 열고 (fp: 지역 변수 시작, bp: 문장 base 기준),
+ * 그 프레임에 필요한 만큼만 스택을 늘린다. 돌아갈 위치는 vm->frames에 쌓는다.
+ * 배열 값은 스택 칸 번호로 vm->vecs에 두며, 원소별 연산은 왼쪽 피연산자 칸의 버퍼에 결과를 쓴다.
+ * 런타임 오류(미정의 변수, 0으로 나누기, 첨자 범위 등)는 현재 문장 위치로 진단하고,
+ * 해당 문장의 나머지를 건너뛴 뒤 다음 문장부터 이어서 실행한다 (오류 수 제한에 도달하면 그 자리에서 끝냄).
+ * 호출 깊이 초과만은 프레임을 모두 닫고 최상위에서 호출한 문장을 진단하고 건너뛴다.
+ * 블록 시작 문장의 조건/횟수에서 오류가 나면 블록 전체를 건너뛴다.
+ *
+ * @return 실행을 마쳤으면 true, 스택 메모리를 확보하지 못하면 false.
+ */
+bool vm_run(VM* vm, const Chunk* ch) {
+    if (!vm_reserve(vm, ch->max_stack)) return false;
+
+    int32_t* values = vm->st->values;
+    uint8_t* defined = vm->st->defined;
+    const Instr* code = ch->code;
+    int32_t* stack = vm->stack;
+    const StmtInfo* cur = NULL;
+    size_t pc = ch->entry;
+    int sp = 0, fp = 0, bp = 0, depth = 0;
+    Instr in;
+
+#if VM_THREADED
+    static void* const labels[OP_COUNT + 1] = {
+        [OP_STMT] = &&L_OP_STMT,
+        [OP_PUSH_CONST] = &&L_OP_PUSH_CONST,
+        [OP_LOAD_SLOT] = &&L_OP_LOAD_SLOT,
+        [OP_ADD] = &&L_OP_ADD,
+        [OP_SUB] = &&L_OP_SUB,
+        [OP_MUL] = &&L_OP_MUL,
+        [OP_DIV] = &&L_OP_DIV,
+        [OP_MOD] = &&L_OP_MOD,
+        [OP_PRINT_INT] = &&L_OP_PRINT_INT,
+        [OP_PRINT_STR] = &&L_OP_PRINT_STR,
+        [OP_STORE_SLOT] = &&L_OP_STORE_SLOT,
+        [OP_JUMP] = &&L_OP_JUMP,
+        [OP_JUMP_FALSE] = &&L_OP_JUMP_FALSE,
+        [OP_REPEAT] = &&L_OP_REPEAT,
+        [OP_LOOP] = &&L_OP_LOOP,
+        [OP_LOAD_LOCAL] = &&L_OP_LOAD_LOCAL,
+        [OP_STORE_LOCAL] = &&L_OP_STORE_LOCAL,
+        [OP_CALL] = &&L_OP_CALL,
+        [OP_TAIL_CALL] = &&L_OP_TAIL_CALL,
+        [OP_RETURN] = &&L_OP_RETURN,
+        [OP_ARRAY_NEW] = &&L_OP_ARRAY_NEW,
+        [OP_LOAD_ELEM] = &&L_OP_LOAD_ELEM,
+        [OP_STORE_ELEM] = &&L_OP_STORE_ELEM,
+        [OP_LOAD_ARRAY] = &&L_OP_LOAD_ARRAY,
+        [OP_VEC] = &&L_OP_VEC,
+        [OP_STORE_ARRAY] = &&L_OP_STORE_ARRAY,
+        [OP_FILL_ARRAY] = &&L_OP_FILL_ARRAY,
+        [OP_PRINT_ARRAY] = &&L_OP_PRINT_ARRAY,
+        [OP_HALT] = &&L_OP_HALT,
+        [OP_COUNT] = &&L_OP_COUNT,
+    };
+    VM_DISPATCH();
+#else
+    in = code[pc++];
+dispatch:
+    switch (in.op)
+#endif
+    {
+        VM_OP(OP_STMT)
+            cur = &ch->stmts[in.arg];
+            sp = bp + (int)cur->base;
+            VM_NEXT();
+
+        VM_OP(OP_PUSH_CONST)
+            stack[sp++] = in.arg;
+            VM_NEXT();
+
+        VM_OP(OP_LOAD_SLOT)
+            if (!defined[in.arg]) {
+                if (!vm_report(vm, cur, VM_ERR_UNDEFINED, in.arg)) return true;
+                pc = cur->end;
+                VM_NEXT();
+            }
+            stack[sp++] = values[in.arg];
+            VM_NEXT();
+
+        VM_OP(OP_ADD) sp--; stack[sp-1] = ar_add(stack[sp-1], stack[sp]); VM_NEXT();
+        VM_OP(OP_SUB) sp--; stack[sp-1] = ar_sub(stack[sp-1], stack[sp]); VM_NEXT();
+        VM_OP(OP_MUL) sp--; stack[sp-1] = ar_mul(stack[sp-1], stack[sp]); VM_NEXT();
+
+        VM_OP(OP_DIV)
+            sp--;
+            if (stack[sp] == 0) {
+                if (!vm_report(vm, cur, VM_ERR_DIV_ZERO, 0)) return true;
+                pc = cur->end;
+                VM_NEXT();
+            }
+            stack[sp-1] = ar_div(stack[sp-1], stack[sp]);
+            VM_NEXT();
+
+        VM_OP(OP_MOD)
+            sp--;
+            if (stack[sp] == 0) {
+                if (!vm_report(vm, cur, VM_ERR_MOD_ZERO, 0)) return true;
+                pc = cur->end;
+                VM_NEXT();
+            }
+            stack[sp-1] = ar_mod(stack[sp-1], stack[sp]);
+            VM_NEXT();
+
+        VM_OP(OP_PRINT_INT)
+            out_int_line(vm->out, stack[--sp]);
+            VM_NEXT();
+
+        VM_OP(OP_PRINT_STR) {
+            const StrRef* sr = &ch->strs[in.arg];
+            out_line(vm->out, ch->pool + sr->off, sr->len);
+            VM_NEXT();
+        }
+
+        VM_OP(OP_STORE_SLOT)
+            values[in.arg] = stack[--sp];
+            defined[in.arg] = 1;
+            VM_NEXT();
+
+        VM_OP(OP_JUMP)
+            pc = (size_t)in.arg;
+            VM_NEXT();
+
+        VM_OP(OP_JUMP_FALSE)
+            if (stack[--sp] == 0) pc = (size_t)in.arg;
+            VM_NEXT();
+
+        VM_OP(OP_REPEAT)
+            if (stack[sp-1] <= 0) {
+                sp--;
+                pc = (size_t)in.arg;
+            }
+            VM_NEXT();
+
+        VM_OP(OP_LOOP)
+            if (--stack[sp-1] > 0) pc = (size_t)in.arg;
+            else sp--;
+            VM_NEXT();
+
+        VM_OP(OP_LOAD_LOCAL)
+            stack[sp++] = stack[fp + in.arg];
+            VM_NEXT();
+
+        VM_OP(OP_STORE_LOCAL)
+            stack[fp + in.arg] = stack[--sp];
+            VM_NEXT();
+
+        VM_OP(OP_CALL) {
+            const Sub* sub = &ch->subs[in.arg];
+            if (depth == VM_MAX_CALL_DEPTH) {
+                // 호출 사슬을 모두 풀고 최상위에서 호출한 문장을 건너뜀
+                if (depth > 0) {
+                    const VmFrame* top = &vm->frames[0];
+                    cur = top->cur;
+                    fp = top->fp;
+                    bp = top->bp;
+                    depth = 0;
+                }
+                if (!vm_report(vm, cur, VM_ERR_CALL_DEPTH, 0)) return true;
+                pc = cur->end;
+                VM_NEXT();
+            }
+            int args = sp - (int)sub->nparams;
+            if (!vm_reserve(vm, (int64_t)args + sub->nlocals + sub->max_stack) || !reserve_frames(vm, depth + 1)) return false;
+            stack = vm->stack;
+            vm->frames[depth++] = (VmFrame){ pc, cur, fp, bp };
+            fp = args;
+            bp = fp + (int)sub->nlocals;
+            for (int i = sp; i < bp; ++i) stack[i] = 0;    // 매개변수가 아닌 지역 변수
+            pc = sub->entry;
+            VM_NEXT();
+        }
+
+        VM_OP(OP_TAIL_CALL) {
+            // 인자를 현재 프레임 자리로 옮기고 호출한 쪽 기록은 그대로 둠 (깊이가 늘지 않음)
+            const Sub* sub = &ch->subs[in.arg];
+            int n = (int)sub->nparams;
+            if (!vm_reserve(vm, (int64_t)fp + sub->nlocals + sub->max_stack)) return false;
+            stack = vm->stack;
+            memmove(&stack[fp], &stack[sp - n], (size_t)n * sizeof(int32_t));
+            bp = fp + (int)sub->nlocals;
+            for (int i = fp + n; i < bp; ++i) stack[i] = 0;
+            pc = sub->entry;
+            VM_NEXT();
+        }
+
+        VM_OP(OP_RETURN) {
+            const VmFrame* f = &vm->frames[--depth];
+            stack[fp] = stack[sp - 1];
+            sp = fp + 1;
+            pc = f->pc;
+            cur = f->cur;
+            fp = f->fp;
+            bp = f->bp;
+            VM_NEXT();
+        }
+
+        VM_OP(OP_ARRAY_NEW) {
+            int32_t n = stack[--sp];
+            if (n < 0) {
+                if (!vm_report(vm, cur, VM_ERR_ARRAY_LENGTH, in.arg)) return true;
+                pc = cur->end;
+                VM_NEXT();
+            }
+            VmArray* arr = array_with_room(vm, in.arg, (size_t)n);
+            if (!arr) return false;
+            memset(arr->data, 0, (size_t)n * sizeof(int32_t));
+            arr->len = (size_t)n;
+            VM_NEXT();
+        }
+
+        VM_OP(OP_LOAD_ELEM) {
+            // 음수 첨자는 부호 없는 값으로 보면 길이보다 크다
+            uint32_t i = (uint32_t)stack[sp - 1];
+            if ((size_t)in.arg >= vm->arrays_cap || i >= vm->arrays[in.arg].len) {
+                if (!vm_report(vm, cur, VM_ERR_INDEX, in.arg)) return true;
+                pc = cur->end;
+                VM_NEXT();
+            }
+            stack[sp - 1] = vm->arrays[in.arg].data[i];
+            VM_NEXT();
+        }
+
+        VM_OP(OP_STORE_ELEM) {
+            sp -= 2;
+            uint32_t i = (uint32_t)stack[sp];
+            if ((size_t)in.arg >= vm->arrays_cap || i >= vm->arrays[in.arg].len) {
+                if (!vm_report(vm, cur, VM_ERR_INDEX, in.arg)) return true;
+                pc = cur->end;
+                VM_NEXT();
+            }
+            vm->arrays[in.arg].data[i] = stack[sp + 1];
+            VM_NEXT();
+        }
+
+        VM_OP(OP_LOAD_ARRAY) {
+            if ((size_t)sp >= vm->vecs_cap &&
+                !grow_zeroed((void**)&vm->vecs, &vm->vecs_cap, (size_t)vm->stack_cap, sizeof(VmVec))) return false;
+            const VmArray* arr = (size_t)in.arg < vm->arrays_cap ? &vm->arrays[in.arg] : NULL;
+            vm->vecs[sp].data = arr ? arr->data : NULL;
+            vm->vecs[sp].len = arr ? arr->len : 0;
+            stack[sp++] = 0;
+            VM_NEXT();
+        }
+
+        VM_OP(OP_VEC) {
+            int op = in.arg >> 2, shape = in.arg & 3;
+            sp--;
+            VmVec* dst = &vm->vecs[sp - 1];
+            const VmVec* lhs = shape & VEC_LEFT ? dst : NULL;
+            const VmVec* rhs = shape & VEC_RIGHT ? &vm->vecs[sp] : NULL;
+            if (lhs && rhs && lhs->len != rhs->len) {
+                if (!vm_report(vm, cur, VM_ERR_LENGTH_MISMATCH, 0)) return true;
+                pc = cur->end;
+                VM_NEXT();
+            }
+            size_t n = lhs ? lhs->len : rhs->len;
+            const VecOps* vo = vec_ops();
+            if ((op == EXPR_OP_DIV || op == EXPR_OP_MOD) && (rhs ? vo->has_zero(rhs->data, n) : stack[sp] == 0)) {
+                if (!vm_report(vm, cur, op == EXPR_OP_DIV ? VM_ERR_DIV_ZERO : VM_ERR_MOD_ZERO, 0)) return true;
+                pc = cur->end;
+                VM_NEXT();
+            }
+            // 결과는 왼쪽 칸의 버퍼에 (피연산자가 그 버퍼여도 원소별로 읽은 뒤 씀)
+            int32_t* out = dst->buf;
+            if (dst->cap < n || !out) {
+                out = vec_alloc(n);
+                if (!out) return false;
+            }
+            vo->kernel[shape][op](out, lhs ? lhs->data : &stack[sp - 1], rhs ? rhs->data : &stack[sp], n);
+            if (out != dst->buf) {
+                vec_free(dst->buf);
+                dst->buf = out;
+                dst->cap = n;
+            }
+            dst->data = out;
+            dst->len = n;
+            VM_NEXT();
+        }
+
+        VM_OP(OP_STORE_ARRAY) {
+            const VmVec* v = &vm->vecs[--sp];
+            const VmArray* same = (size_t)in.arg < vm->arrays_cap ? &vm->arrays[in.arg] : NULL;
+            if (same && same->data == v->data) VM_NEXT();   // VAR A = A
+            VmArray* arr = array_with_room(vm, in.arg, v->len);
+            if (!arr) return false;
+            if (v->len) memcpy(arr->data, v->data, v->len * sizeof(int32_t));
+            arr->len = v->len;
+            VM_NEXT();
+        }
+
+        VM_OP(OP_FILL_ARRAY) {
+            int32_t value = stack[--sp];
+            if ((size_t)in.arg < vm->arrays_cap) {
+                VmArray* arr = &vm->arrays[in.arg];
+                for (size_t i = 0; i < arr->len; ++i) arr->data[i] = value;
+            }
+            VM_NEXT();
+        }
+
+        VM_OP(OP_PRINT_ARRAY) {
+            const VmVec* v = &vm->vecs[--sp];
+            out_ints_line(vm->out, v->data, v->len);
+            VM_NEXT();
+        }
+
+        VM_OP(OP_HALT)
+            return true;
+
+        VM_DEFAULT
+            diag_error(DIAG_INTERNAL, vm->filename, cur ? cur->line : 0, cur ? cur->col : 0, "Internal error: Unknown opcode");
+            return true;
+    }
+#if !VM_THREADED
+    VM_DISPATCH();
+#endif
+}
@@ -0,0 +1,364 @@
+//========================================
+// System Includes
+//========================================
+#include "watch.h"
+#include "arena.h"
+#include "bytecode.h"
+#include "cache.h"
+#include "diag.h"
+#include "lexer.h"
+#include "output.h"
+#include "parser.h"
+#include "symtab.h"
+#include "vm.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+#include <time.h>
+#else
+#include <windows.h>
+#endif
+
+//========================================
+// 문장 기록
+// 블록(WHILE/IF/REPEAT ... END)은 END까지 모아 한 번에 실행하므로 블록 전체가 기록 하나가 된다.
+//========================================
+typedef struct {
+    int32_t slot;           // 대입하는 슬롯
+    int32_t old_value;      // 대입 전 값 (되돌리기용)
+    uint8_t old_defined;
+} WatchUndo;
+
+typedef struct {
+    uint64_t off;           // 문장 구간 시작 (파서 lookahead 토큰의 소스 오프셋)
+    int64_t line, col;      // off의 문자를 읽기 직전 렉서 위치 (lx_open_slice에 그대로 넘겨 다시 시작)
+    uint64_t hash;          // [off, 다음 문장 off) 소스 바이트 해시
+    size_t out_end;         // 이 문장까지의 누적 출력 길이
+    size_t diag_end;        // 이 문장까지의 누적 진단 길이
+    size_t undo_end;        // 이 문장까지의 누적 되돌리기 항목 수 (문장 안의 VAR마다 하나)
+    size_t nsubs;           // 이 문장까지 정의된 하위 루틴 수 (chunk에 남겨 둔 본문)
+} WatchStmt;
+
+typedef struct {
+    const char* filename;
+    SymTab st;
+    Chunk ch;
+    VM vm;
+    Arena arena;
+    Output out;             // 실행 전체의 출력 (--flush=explicit처럼 모아 두기만 함)
+    DiagBuffer diags;       // 실행 전체의 진단
+    WatchStmt* stmts;
+    size_t count, cap;
+    WatchUndo* undo;
+    size_t nundo, undo_cap;
+    WatchStmt tail;         // 마지막 문장 뒤 위치 (EOF 또는 치명적 구문 오류, 항상 다시 파싱)
+} Watch;
+
+static bool discard(void* user, const char* data, size_t len) {
+    (void)user; (void)data; (void)len;
+    return true;
+}
+
+static double now_ms(void) {
+#ifndef _WIN32
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec * 1e-6;
+#else
+    LARGE_INTEGER freq, t;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart * 1e3 / (double)freq.QuadPart;
+#endif
+}
+
+static void sleep_ms(int ms) {
+#ifndef _WIN32
+    struct timespec ts = { ms / 1000, (long)(ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+#else
+    Sleep((DWORD)ms);
+#endif
+}
+
+/**
+ * @brief 파서 lookahead 토큰에서 렉서를 다시 시작할 위치
+ * 렉서는 문자를 읽은 뒤의 위치를 토큰 위치로 기록하므로 (tok_line/tok_col), 그 문자를 읽기 직전 위치로 되돌린다.
+ * 개행 토큰이면 직전 위치는 앞 줄의 끝이므로 그 줄의 시작을 찾아 열을 센다.
+ */
+static void resume_pos(const char* src, size_t size, uint64_t off, int64_t tok_line, int64_t tok_col,
+                       int64_t* line, int64_t* col) {
+    if (off >= size) { *line = tok_line; *col = tok_col; return; }
+    if (src[off] != '\n') { *line = tok_line; *col = tok_col - 1; return; }
+    uint64_t bol = off;
+    while (bol > 0 && src[bol - 1] != '\n') --bol;
+    *line = tok_line - 1;
+    *col = 1 + (int64_t)(off - bol);
+}
+
+static uint64_t span_hash(const char* src, uint64_t from, uint64_t to) {
+    return cache_hash(src + from, (size_t)(to - from));
+}
+
+//========================================
+// 변경 구간 찾기 / 되돌리기
+//========================================
+
+/**
+ * @brief 새 소스에서 처음으로 달라진 문장 번호 (모두 같으면 count: 꼬리만 다시 파싱, 0이면 처음부터)
+ *
+ * 문장의 구간은 다음 문장의 첫 토큰 직전까지이므로 그 토큰을 렉싱할 때 나온 진단(알 수 없는 부호 등)은
+ * 앞 문장의 기록에 들어 있다. 앞 문장에 진단이 있었다면 그것이 바뀐 토큰에서 나온 것일 수 있으므로
+ * 한 문장 앞에서부터 다시 실행한다.
+ */
+static size_t first_changed(const Watch* w, const char* src, size_t size) {
+    size_t k = 0;
+    for (; k < w->count; ++k) {
+        const WatchStmt* s = &w->stmts[k];
+        uint64_t end = k + 1 < w->count ? w->stmts[k + 1].off : w->tail.off;
+        if (end > size || span_hash(src, s->off, end) != s->hash) break;
+    }
+    if (k > 0) {
+        size_t prev_diag = k >= 2 ? w->stmts[k - 2].diag_end : 0;
+        if (w->stmts[k - 1].diag_end != prev_diag) --k;
+    }
+    return k;
+}
+
+/**
+ * @brief k번째 문장 이후의 대입을 거꾸로 되돌려 그 직전의 변수 상태와 출력/진단 길이로 복원
+ * 그 뒤에 정의된 하위 루틴도 지워 같은 이름의 이전 정의가 다시 보이게 한다.
+ * 뒤 문장에서 처음 등장한 이름은 미정의 슬롯으로 남지만 실행 결과에는 영향이 없다.
+ * 배열 원소는 되돌리지 않으므로 배열은 처음부터 다시 실행할 때(k == 0)만 비운다.
+ */
+static void rollback(Watch* w, size_t k) {
+    size_t keep = k > 0 ? w->stmts[k - 1].undo_end : 0;
+    for (size_t i = w->nundo; i > keep; --i) {
+        const WatchUndo* u = &w->undo[i - 1];
+        w->st.values[u->slot] = u->old_value;
+        w->st.defined[u->slot] = u->old_defined;
+    }
+    w->nundo = keep;
+    bc_drop_subs(&w->ch, k > 0 ? w->stmts[k - 1].nsubs : 0);
+    if (k == 0) {
+        bc_reset(&w->ch);
+        vm_reset_arrays(&w->vm);
+    }
+    w->out.len = k > 0 ? w->stmts[k - 1].out_end : 0;
+    diag_truncate(&w->diags, k > 0 ? w->stmts[k - 1].diag_end : 0);
+    w->count = k;
+}
+
+//========================================
+// 실행
+//========================================
+
+static bool push_stmt(Watch* w, const WatchStmt* s) {
+    if (w->count == w->cap) {
+        size_t cap = w->cap ? w->cap * 2 : 256;
+        WatchStmt* grown = realloc(w->stmts, cap * sizeof(WatchStmt));
+        if (!grown) return false;
+        w->stmts = grown;
+        w->cap = cap;
+    }
+    w->stmts[w->count++] = *s;
+    return true;
+}
+
+/**
+ * @brief 실행하기 전에 VAR가 대입할 슬롯의 현재 값을 기록
+ * 블록 안의 VAR는 블록을 실행하기 전에 모두 기록되므로 반복 대입해도 블록 이전 값이 남는다.
+ */
+static bool push_undo(Watch* w, int32_t slot) {
+    if (w->nundo == w->undo_cap) {
+        size_t cap = w->undo_cap ? w->undo_cap * 2 : 256;
+        WatchUndo* grown = realloc(w->undo, cap * sizeof(WatchUndo));
+        if (!grown) return false;
+        w->undo = grown;
+        w->undo_cap = cap;
+    }
+    w->undo[w->nundo++] = (WatchUndo){ slot, w->st.values[slot], w->st.defined[slot] };
+    return true;
+}
+
+/**
+ * @brief start 위치부터 소스 끝까지 한 문장씩 파싱 → 컴파일 → 실행하며 기록을 덧붙임
+ * 소스 끝까지 닫히지 않은 블록은 실행하지 않고, 그 시작 위치를 꼬리로 두어 다음에 다시 파싱한다.
+ * @return 메모리 부족이면 false.
+ */
+static bool run_from(Watch* w, const char* src, size_t size, const WatchStmt* start) {
+    Lexer lx;
+    const char* data = src ? src + start->off : NULL;   // 빈 파일은 버퍼가 없음
+    lx_open_slice(&lx, w->filename, data, size - (size_t)start->off, start->line, start->col);
+    Parser ps; ps_init(&ps, &lx, &w->st, &w->arena);
+    size_t first = w->count;
+    bool ok = true;
+    Stmt s;
+
+    WatchStmt rec = {0};
+
+    for (;;) {
+        if (!bc_in_block(&w->ch)) {
+            // 첫 문장의 구간은 시작 위치부터 (파일 맨 앞의 공백/주석도 해시에 포함)
+            rec = (WatchStmt){ .off = start->off + ps.cur.off };
+            resume_pos(src, size, rec.off, ps.line, ps.col, &rec.line, &rec.col);
+            if (w->count == first) rec = (WatchStmt){ .off = start->off, .line = start->line, .col = start->col };
+            bc_reset_stmts(&w->ch);
+        }
+        if (!ps_next_stmt(&ps, &s)) {
+            w->tail = rec;
+            w->nundo = w->count > 0 ? w->stmts[w->count - 1].undo_end : 0;  // 실행하지 않은 블록의 기록
+            bc_end_blocks(&w->ch, w->filename);
+            break;
+        }
+        if (s.kind == STMT_VAR && s.varStmt.slot >= 0 && !push_undo(w, s.varStmt.slot)) { ok = false; break; }
+
+        bool compiled = bc_compile_stmt(&w->ch, &s, &w->st, w->filename);
+        arena_reset(&w->arena);
+        if (bc_in_block(&w->ch)) continue;
+        if (compiled) ok = bc_finish(&w->ch) && vm_run(&w->vm, &w->ch);
+
+        rec.out_end = w->out.len;
+        rec.diag_end = w->diags.len;
+        rec.undo_end = w->nundo;
+        rec.nsubs = w->ch.nsubs;
+        if (!ok || w->out.failed || !push_stmt(w, &rec)) { ok = false; break; }
+    }
+
+    // 구간의 끝(다음 문장의 시작)은 다음 문장을 파싱해야 알 수 있으므로 마지막에 해시
+    for (size_t i = first; ok && i < w->count; ++i) {
+        uint64_t end = i + 1 < w->count ? w->stmts[i + 1].off : w->tail.off;
+        w->stmts[i].hash = span_hash(src, w->stmts[i].off, end);
+    }
+
+    ps_free(&ps);
+    lx_close(&lx);
+    return ok;
+}
+
+/**
+ * @brief 기록해 둔 출력과 진단을 문장 순서대로 내보냄 (문장마다 진단 → 출력)
+ */
+static void replay(const Watch* w) {
+    size_t out_at = 0, diag_at = 0;
+    for (size_t i = 0; i <= w->count; ++i) {
+        size_t out_end = i < w->count ? w->stmts[i].out_end : w->out.len;
+        size_t diag_end = i < w->count ? w->stmts[i].diag_end : w->diags.len;
+        if (diag_end > diag_at) {
+            fflush(stdout);
+            fwrite(w->diags.text + diag_at, 1, diag_end - diag_at, stderr);
+        }
+        fwrite(w->out.buf + out_at, 1, out_end - out_at, stdout);
+        out_at = out_end;
+        diag_at = diag_end;
+    }
+    fflush(stdout);
+}
+
+/**
+ * @brief 파일을 다시 읽어 처음으로 달라진 문장부터 실행하고 전체 결과를 출력
+ * @return 메모리 부족이면 false (파일을 열 수 없으면 이번 변경만 건너뜀).
+ */
+static bool cycle(Watch* w) {
+    double start = now_ms();
+    Lexer lx;
+    if (!lx_open(&lx, w->filename)) {
+        fprintf(stderr, "watch: Cannot open: %s\n", w->filename);
+        return true;
+    }
+
+    // 배열이 있으면 되돌릴 수 없으므로 처음부터
+    size_t k = w->ch.narrays ? 0 : first_changed(w, lx.buf, lx.size);
+    WatchStmt from = { .off = 0, .line = 1, .col = 1 };
+    if (k > 0) from = k < w->count ? w->stmts[k] : w->tail;
+    rollback(w, k);
+
+    DiagBuffer* prev = diag_capture(&w->diags);
+    bool ok = run_from(w, lx.buf, lx.size, &from);
+    diag_capture(prev);
+    lx_close(&lx);
+    if (!ok) return false;
+
+    replay(w);
+    fprintf(stderr, "watch: %s: %zu statements (%zu reused), ran from line %" PRId64 " in %.3f ms\n",
+            w->filename, w->count, k, from.line, now_ms() - start);
+    return true;
+}
+
+//========================================
+// 변경 감지
+//========================================
+typedef struct {
+    bool exists;
+    long long size, mtime_sec, mtime_nsec, ino;
+} FileStamp;
+
+static bool same_stamp(const FileStamp* a, const FileStamp* b) {
+    return a->exists == b->exists && a->size == b->size && a->mtime_sec == b->mtime_sec &&
+           a->mtime_nsec == b->mtime_nsec && a->ino == b->ino;
+}
+
+static FileStamp file_stamp(const char* path) {
+    FileStamp fs = {0};
+    struct stat sb;
+    if (stat(path, &sb) != 0) return fs;
+    fs.exists = true;
+    fs.size = (long long)sb.st_size;
+    fs.mtime_sec = (long long)sb.st_mtime;
+    fs.ino = (long long)sb.st_ino;
+#if !defined(_WIN32) && !defined(__APPLE__)
+    fs.mtime_nsec = (long long)sb.st_mtim.tv_nsec;
+#endif
+    return fs;
+}
+
+/**
+ * @brief 파일을 실행한 뒤 WATCH_POLL_MS마다 변경(크기, 수정 시각, inode)을 확인하여 증분 재실행
+ *
+ * 편집기가 새 파일로 바꿔치기하며 저장하는 동안 파일이 잠시 없을 수 있으므로,
+ * 사라진 동안은 기다렸다가 다시 나타나면 실행한다.
+ */
+bool watch_run(const char* filename) {
+    Watch w;
+    memset(&w, 0, sizeof(w));
+    w.filename = filename;
+
+    Lexer probe;
+    if (!lx_open(&probe, filename)) {
+        diag_message("Cannot open: %s\n", filename);
+        return false;
+    }
+    lx_close(&probe);
+
+    st_init(&w.st);
+    bc_init(&w.ch);
+    arena_init(&w.arena, 0);
+    out_init_sink(&w.out, discard, NULL, OUT_FLUSH_EXPLICIT);
+    vm_init(&w.vm, &w.st, filename, &w.out);
+
+    // 메모리가 부족할 때만 빠져나온다
+    FileStamp seen = {0};
+    for (;;) {
+        FileStamp now = file_stamp(filename);
+        if (now.exists && !same_stamp(&now, &seen)) {
+            seen = now;
+            if (!cycle(&w)) break;
+        }
+        sleep_ms(WATCH_POLL_MS);
+    }
+
+    diag_message("Out of memory\n");
+    vm_free(&w.vm);
+    out_free(&w.out);
+    arena_free(&w.arena);
+    bc_free(&w.ch);
+    st_free(&w.st);
+    diag_flush(&w.diags, NULL);
+    free(w.stmts);
+    free(w.undo);
+    return false;
+}
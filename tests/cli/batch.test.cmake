@@ -0,0 +1,88 @@
+# --jobs / --manifest: 여러 파일을 한 프로세스에서 실행해도 출력과 진단이 파일 순서대로 모이는지,
+# 그리고 표준 입력("-")은 목록 전체에서 한 번만 받는지 확인
+include(${CMAKE_CURRENT_LIST_DIR}/common.cmake)
+
+# tests/의 프로그램과 기대 출력을 그대로 사용 (진단이 있는 것도 섞음)
+set(programs hello_world operator subs sub_errors variable blocks arrays print_string)
+set(tests_dir ${DIR}/..)
+foreach (p ${programs})
+    file(COPY ${tests_dir}/${p}.dit DESTINATION ${WORK})
+endforeach()
+
+# files의 기대 출력/진단을 순서대로 이어 붙임
+function(expected_for)
+    set(o "")
+    set(e "")
+    foreach (p ${ARGN})
+        if (EXISTS ${tests_dir}/${p}.out)
+            file(READ ${tests_dir}/${p}.out text)
+            string(APPEND o "${text}")
+        endif()
+        if (EXISTS ${tests_dir}/${p}.err)
+            file(READ ${tests_dir}/${p}.err text)
+            string(APPEND e "${text}")
+        endif()
+    endforeach()
+    set(expected_out "${o}" PARENT_SCOPE)
+    set(expected_err "${e}" PARENT_SCOPE)
+endfunction()
+
+# 요약 줄을 떼어 내고 그 줄이 맞는지 확인한 뒤 진단만 남김
+function(split_summary summary_regex)
+    string(REGEX MATCH "batch: [^\n]*\n$" summary "${err}")
+    expect_match("batch summary" "${summary}" "${summary_regex}")
+    string(REGEX REPLACE "batch: [^\n]*\n$" "" err "${err}")
+    set(err "${err}" PARENT_SCOPE)
+endfunction()
+
+# 같은 목록을 두 번 (워커가 4개라 파일이 훔쳐 가며 실행되어도 출력은 순서대로)
+set(files)
+set(names)
+foreach (round 1 2)
+    foreach (p ${programs})
+        list(APPEND files ${p}.dit)
+        list(APPEND names ${p})
+    endforeach()
+endforeach()
+list(LENGTH files nfiles)
+dahdit(--no-cache --jobs=4 ${files})
+expect_rc("--jobs=4" TRUE)
+expected_for(${names})
+expect_equal("--jobs=4 stdout" "${out}" "${expected_out}")
+split_summary("^batch: ${nfiles} files \\(0 failed\\), 4 jobs, ")
+expect_equal("--jobs=4 diagnostics" "${err}" "${expected_err}")
+
+# manifest는 옵션 위치에 끼워 넣어지며 빈 줄과 '#' 줄은 무시
+file(WRITE ${WORK}/list.txt "# nightly\noperator.dit\n\nsub_errors.dit\n# blocks.dit\nsubs.dit\n")
+dahdit(--no-cache --jobs=2 hello_world.dit --manifest=list.txt variable.dit)
+expect_rc("--manifest" TRUE)
+expected_for(hello_world operator sub_errors subs variable)
+expect_equal("--manifest stdout" "${out}" "${expected_out}")
+split_summary("^batch: 5 files \\(0 failed\\), 2 jobs, ")
+expect_equal("--manifest diagnostics" "${err}" "${expected_err}")
+
+# 열 수 없는 파일은 그 자리에서 진단하고 나머지는 실행, 종료 코드는 실패
+dahdit(--no-cache --jobs=2 hello_world.dit missing.dit variable.dit)
+expect_rc("batch with a missing file" FALSE)
+expected_for(hello_world variable)
+expect_equal("missing file stdout" "${out}" "${expected_out}")
+split_summary("^batch: 3 files \\(1 failed\\), 2 jobs, ")
+expect_equal("missing file diagnostics" "${err}" "${expected_err}Cannot open: missing.dit\n")
+
+# 표준 입력은 목록 안에서 한 번은 받을 수 있음
+dahdit_stdin(${WORK}/subs.dit --no-cache --jobs=2 hello_world.dit -)
+expect_rc("batch with '-'" TRUE)
+expected_for(hello_world subs)
+expect_equal("batch with '-' stdout" "${out}" "${expected_out}")
+
+# 두 번이면 아무것도 실행하지 않고 거부 (명령줄과 manifest를 합쳐서 셈)
+dahdit_stdin(${WORK}/subs.dit --no-cache --jobs=2 - hello_world.dit -)
+expect_rc("'-' twice" FALSE)
+expect_equal("'-' twice stdout" "${out}" "")
+expect_equal("'-' twice diagnostics" "${err}" "'-' (standard input) can be given only once\n")
+
+file(WRITE ${WORK}/stdin.txt "-\n")
+dahdit_stdin(${WORK}/subs.dit --no-cache - --manifest=stdin.txt)
+expect_rc("'-' on the command line and in a manifest" FALSE)
+expect_equal("'-' in a manifest stdout" "${out}" "")
+expect_equal("'-' in a manifest diagnostics" "${err}" "'-' (standard input) can be given only once\n")
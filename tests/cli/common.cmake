@@ -0,0 +1,46 @@
+# tests/cli/*.test.cmake 공용 함수 (ctest에서 cmake -P로 호출)
+#   -DDAHDIT=<dahdit> -DDIR=<tests/cli> -DWORK=<작업 폴더>
+# 입력 파일은 작업 폴더에 복사해 상대 경로로 실행하므로 진단의 파일 이름이 고정된다.
+file(REMOVE_RECURSE ${WORK})
+file(MAKE_DIRECTORY ${WORK})
+
+# 작업 폴더에서 dahdit을 실행해 out/err/rc에 결과를 남김
+function(dahdit)
+    execute_process(COMMAND ${DAHDIT} ${ARGN}
+            WORKING_DIRECTORY ${WORK}
+            OUTPUT_VARIABLE out ERROR_VARIABLE err RESULT_VARIABLE rc)
+    set(out "${out}" PARENT_SCOPE)
+    set(err "${err}" PARENT_SCOPE)
+    set(rc "${rc}" PARENT_SCOPE)
+endfunction()
+
+# input 파일을 표준 입력으로 주고 실행
+function(dahdit_stdin input)
+    execute_process(COMMAND ${DAHDIT} ${ARGN}
+            WORKING_DIRECTORY ${WORK} INPUT_FILE ${input}
+            OUTPUT_VARIABLE out ERROR_VARIABLE err RESULT_VARIABLE rc)
+    set(out "${out}" PARENT_SCOPE)
+    set(err "${err}" PARENT_SCOPE)
+    set(rc "${rc}" PARENT_SCOPE)
+endfunction()
+
+function(expect_equal what actual expected)
+    if (NOT actual STREQUAL expected)
+        message(FATAL_ERROR "${what} differs\n--- expected\n${expected}\n--- actual\n${actual}")
+    endif()
+endfunction()
+
+function(expect_match what actual regex)
+    if (NOT actual MATCHES "${regex}")
+        message(FATAL_ERROR "${what} does not match '${regex}'\n--- actual\n${actual}")
+    endif()
+endfunction()
+
+# rc가 0(성공)인지 아닌지 확인
+function(expect_rc what ok)
+    if (ok AND NOT rc EQUAL 0)
+        message(FATAL_ERROR "${what}: expected success, got ${rc}\n${err}")
+    elseif (NOT ok AND rc EQUAL 0)
+        message(FATAL_ERROR "${what}: expected failure\n${out}${err}")
+    endif()
+endfunction()
@@ -0,0 +1,61 @@
+# --parallel: 청크가 여러 개 생기도록 큰 프로그램을 만들어, 뒤쪽 청크의 진단과 치명적 구문 오류까지
+# 순차 실행과 같은 출력을 내는지 확인 (청크당 최소 256 KiB, 4개 스레드)
+include(${CMAKE_CURRENT_LIST_DIR}/common.cmake)
+
+# 1행은 VAR N = 0 ; 이고, 블록 b(1..30)는 VAR N = N + 1 ; 1000줄과 끝 문장 한 줄 (끝 문장은 1 + b * 1001행)
+# 끝 문장은 보통 PRINT N ; 이고 일부 블록에서는 오류 문장으로 바뀐다.
+set(inc "...- .- .-. / -. / -...- / -. / .-.-. / .---- ;\n")
+string(REPEAT "${inc}" 1000 body)
+set(print_n ".--. .-. .. -. - / -. ;\n")
+set(print_missing ".--. .-. .. -. - / -- .. ... ... .. -. --. ;\n")    # PRINT MISSING ; (E401)
+set(unknown_stmt "..-. --- --- / .---- ;\n")                           # FOO 1 ; (복구되는 구문 오류)
+set(var_no_name "...- .- .-. / -...- / .---- ;\n")                     # VAR = 1 ; (치명적 구문 오류)
+
+set(src "...- .- .-. / -. / -...- / ----- ;\n")
+set(expected_out "")
+foreach (b RANGE 1 30)
+    if (b EQUAL 14 OR b EQUAL 27)
+        set(tail "${print_missing}")
+    elseif (b EQUAL 20)
+        set(tail "${unknown_stmt}")
+    elseif (b EQUAL 28)
+        set(tail "${var_no_name}")
+    else()
+        set(tail "${print_n}")
+        if (b LESS 28)
+            math(EXPR n "${b} * 1000")
+            string(APPEND expected_out "${n}\n")
+        endif()
+    endif()
+    string(APPEND src "${body}${tail}")
+endforeach()
+file(WRITE ${WORK}/big.dit "${src}")
+
+file(SIZE ${WORK}/big.dit size)
+if (size LESS 1048576)
+    message(FATAL_ERROR "big.dit is only ${size} bytes; --parallel=4 would not make four chunks")
+endif()
+
+# 구문 오류는 실행 전에 소스 순서대로, 실행 오류는 그 뒤에 나온다 (치명적 오류 뒤의 블록은 버림)
+set(expected_err
+"big.dit:20021:15: error: unknown statement (expected PRINT, VAR, WHILE, IF, REPEAT, ELSE, END, SUB, RETURN or ARRAY)
+big.dit:28029:16: error: expected identifier after VAR
+big.dit:14015:19: error: undefined variable 'MISSING'
+big.dit:27028:19: error: undefined variable 'MISSING'
+")
+
+dahdit(--no-cache --parallel=4 big.dit)
+expect_equal("--parallel stdout" "${out}" "${expected_out}")
+expect_equal("--parallel diagnostics" "${err}" "${expected_err}")
+
+# 순차 실행과 표준 출력이 같고, 진단은 순서만 다름
+set(parallel_out "${out}")
+dahdit(--no-cache big.dit)
+expect_equal("sequential stdout" "${out}" "${parallel_out}")
+expect_equal("sequential diagnostics"
+        "${err}"
+"big.dit:14015:19: error: undefined variable 'MISSING'
+big.dit:20021:15: error: unknown statement (expected PRINT, VAR, WHILE, IF, REPEAT, ELSE, END, SUB, RETURN or ARRAY)
+big.dit:27028:19: error: undefined variable 'MISSING'
+big.dit:28029:16: error: expected identifier after VAR
+")
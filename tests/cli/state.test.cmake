@@ -0,0 +1,50 @@
+# --save-state / --load-state: 왕복, 다시 저장, 그리고 잘못된 이미지 거부
+include(${CMAKE_CURRENT_LIST_DIR}/common.cmake)
+file(COPY ${DIR}/state_save.dit ${DIR}/state_use.dit ${DIR}/state_reload.dit DESTINATION ${WORK})
+
+dahdit(--save-state=vars.dits state_save.dit)
+expect_rc("--save-state" TRUE)
+expect_equal("--save-state stdout" "${out}" "")
+
+# 불러온 변수로 시작하고, 새 변수 D를 더해 다른 이미지로 저장
+dahdit(--load-state=vars.dits --save-state=more.dits state_use.dit)
+expect_rc("--load-state" TRUE)
+expect_equal("--load-state stdout" "${out}" "6\n42\n48\n")
+expect_equal("--load-state diagnostics" "${err}" "")
+
+dahdit(--load-state=more.dits state_reload.dit)
+expect_rc("--load-state of a re-saved image" TRUE)
+expect_equal("re-saved image stdout" "${out}" "48\n")
+
+# 같은 상태를 다시 저장하면 같은 파일
+dahdit(--save-state=again.dits state_save.dit)
+file(SHA256 ${WORK}/vars.dits first)
+file(SHA256 ${WORK}/again.dits second)
+expect_equal("image of the same state" "${second}" "${first}")
+
+# 거부되는 이미지는 프로그램을 실행하지 않고 실패
+function(expect_rejected image reason)
+    dahdit(--load-state=${image} state_use.dit)
+    expect_rc("--load-state=${image}" FALSE)
+    expect_equal("--load-state=${image} stdout" "${out}" "")
+    expect_equal("--load-state=${image} diagnostics" "${err}" "Cannot load state: ${image}: ${reason}\n")
+endfunction()
+
+file(WRITE ${WORK}/text.dits "PRINT A ;\n")
+expect_rejected(text.dits "not a dahdit state image")
+
+# magic 뒤의 형식 번호가 다름 (헤더 크기 이상)
+string(REPEAT "x" 60 filler)
+file(WRITE ${WORK}/stale.dits "DITS${filler}")
+expect_rejected(stale.dits "image was written by a different dahdit version")
+
+# 헤더 중간에서 잘림 (있는 만큼의 magic은 맞음)
+file(WRITE ${WORK}/short.dits "DITS\n")
+expect_rejected(short.dits "image is corrupt (checksum or layout mismatch)")
+file(WRITE ${WORK}/tiny.dits "DI")
+expect_rejected(tiny.dits "image is corrupt (checksum or layout mismatch)")
+
+# 뒤에 바이트가 붙어 크기가 구간 배치와 맞지 않음
+file(COPY ${WORK}/vars.dits DESTINATION ${WORK}/bad)
+file(APPEND ${WORK}/bad/vars.dits "x")
+expect_rejected(bad/vars.dits "image is corrupt (checksum or layout mismatch)")
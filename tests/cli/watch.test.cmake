@@ -0,0 +1,17 @@
+# --watch: 첫 실행, 그리고 파일을 한 번 바꾼 뒤 앞부분을 재사용한 증분 재실행
+include(${CMAKE_CURRENT_LIST_DIR}/common.cmake)
+file(COPY ${DIR}/watch.dit ${DIR}/watch_edit.dit DESTINATION ${WORK})
+
+# 감시는 끝나지 않으므로 편집 스크립트와 함께 띄우고 시간 제한으로 멈춤
+# (편집 스크립트의 표준 출력은 dahdit의 표준 입력으로 이어지지만 아무것도 쓰지 않음)
+execute_process(COMMAND ${CMAKE_COMMAND} -DWORK=${WORK} -P ${DIR}/watch_edit.cmake
+        COMMAND ${DAHDIT} --watch watch.dit
+        WORKING_DIRECTORY ${WORK} TIMEOUT 4
+        OUTPUT_VARIABLE out ERROR_VARIABLE err RESULT_VARIABLE rc)
+expect_match("--watch result" "${rc}" "timeout")
+
+# 두 번째 실행은 앞 두 문장의 출력(42)을 다시 내보내고, 둘째 문장이 끝난 곳(6번 줄)부터 실행
+expect_equal("--watch stdout" "${out}" "42\n1\n42\n7\n")
+set(ms "in [0-9.]+ ms\n")
+expect_match("--watch summaries" "${err}"
+        "^watch: watch.dit: 3 statements \\(0 reused\\), ran from line 1 ${ms}watch: watch.dit: 3 statements \\(2 reused\\), ran from line 6 ${ms}$")
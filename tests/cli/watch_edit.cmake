@@ -0,0 +1,5 @@
+# watch.test.cmake가 dahdit --watch와 함께 띄우는 편집기 흉내 (cmake -P)
+#   -DWORK=<작업 폴더>
+# 첫 실행이 끝날 때까지 기다린 뒤, 편집기처럼 새 파일을 쓰고 바꿔치기하여 한 번 저장한다.
+execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1)
+file(RENAME ${WORK}/watch_edit.dit ${WORK}/watch.dit)
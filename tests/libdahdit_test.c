@@ -0,0 +1,192 @@
+//========================================
+// libdahdit 공개 API 테스트 (ctest: libdahdit)
+// 변수 유지와 dahdit_reset, 컨텍스트마다 다른 진단 설정, 출력/진단 콜백을 확인한다.
+//========================================
+#include "dahdit.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//========================================
+// 모스 부호로 쓴 테스트 프로그램
+//========================================
+#define SET_A       "...- .- .-. / .- / -...- / -.... ;\n"                   // VAR A = 6 ;
+#define PRINT_A7    ".--. .-. .. -. - / .- / -.- / --... ;\n"                // PRINT A * 7 ;
+#define PRINT_X     ".--. .-. .. -. - / -..- ;\n"                            // PRINT X ;
+#define PRINT_Y     ".--. .-. .. -. - / -.-- ;\n"                            // PRINT Y ;
+#define PRINT_1     ".--. .-. .. -. - / .---- ;\n"                           // PRINT 1 ;
+
+//========================================
+// 콜백이 모으는 버퍼
+//========================================
+typedef struct {
+    char text[4096];
+    size_t len;
+    int calls;
+} Capture;
+
+typedef struct {
+    Capture out;
+    Capture diag;
+    bool fail_writes;   // 출력 콜백이 실패를 돌려주게 함
+} Sink;
+
+static void capture(Capture* c, const char* data, size_t len) {
+    if (c->len + len >= sizeof(c->text)) len = sizeof(c->text) - 1 - c->len;
+    memcpy(c->text + c->len, data, len);
+    c->len += len;
+    c->text[c->len] = '\0';
+    c->calls++;
+}
+
+static bool on_write(void* user, const char* data, size_t len) {
+    Sink* s = user;
+    if (s->fail_writes) return false;
+    capture(&s->out, data, len);
+    return true;
+}
+
+static void on_diag(void* user, const char* text, size_t len) {
+    capture(&((Sink*)user)->diag, text, len);
+}
+
+static void sink_clear(Sink* s) {
+    memset(&s->out, 0, sizeof(s->out));
+    memset(&s->diag, 0, sizeof(s->diag));
+}
+
+//========================================
+// 검사
+//========================================
+static int failures;
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+#define CHECK_TEXT(cap, expected) check_text(&(cap), (expected), #cap, __LINE__)
+
+static void check(bool ok, const char* what, int line) {
+    if (ok) return;
+    fprintf(stderr, "libdahdit_test.c:%d: check failed: %s\n", line, what);
+    failures++;
+}
+
+static void check_text(const Capture* c, const char* expected, const char* what, int line) {
+    if (strcmp(c->text, expected) == 0) return;
+    fprintf(stderr, "libdahdit_test.c:%d: %s differs\n--- expected\n%s--- actual\n%s", line, what, expected, c->text);
+    failures++;
+}
+
+static bool run(DahditContext* ctx, const char* src) {
+    return dahdit_run_buffer(ctx, "test.dit", src, strlen(src));
+}
+
+//========================================
+// Tests
+//========================================
+
+/**
+ * @brief 변수는 같은 컨텍스트의 실행 사이에 남고, dahdit_reset 뒤에는 정의되지 않은 상태
+ */
+static void test_variables_persist(void) {
+    Sink s = {0};
+    DahditConfig cfg = { .write = on_write, .diag = on_diag, .user = &s };
+    DahditContext* ctx = dahdit_create(&cfg);
+    CHECK(ctx != NULL);
+    if (!ctx) return;
+
+    CHECK(run(ctx, SET_A));
+    CHECK(run(ctx, PRINT_A7));
+    CHECK_TEXT(s.out, "42\n");
+    CHECK_TEXT(s.diag, "");
+
+    sink_clear(&s);
+    dahdit_reset(ctx);
+    CHECK(run(ctx, PRINT_A7));      // 진단은 실행 실패가 아님
+    CHECK_TEXT(s.out, "");
+    CHECK_TEXT(s.diag, "test.dit:1:19: error: undefined variable 'A'\n");
+
+    // reset 뒤에도 다시 정의하면 그대로 쓸 수 있음
+    sink_clear(&s);
+    CHECK(run(ctx, SET_A PRINT_A7));
+    CHECK_TEXT(s.out, "42\n");
+    dahdit_destroy(ctx);
+}
+
+/**
+ * @brief 진단 형식과 오류 수 제한은 컨텍스트마다 따로 (번갈아 실행해도 서로 섞이지 않음)
+ */
+static void test_per_context_diagnostics(void) {
+    Sink text_sink = {0}, json_sink = {0};
+    DahditConfig text_cfg = { .write = on_write, .diag = on_diag, .user = &text_sink };
+    DahditConfig json_cfg = { .write = on_write, .diag = on_diag, .user = &json_sink,
+                              .diag_json = true, .max_errors = 1 };
+    DahditContext* text_ctx = dahdit_create(&text_cfg);
+    DahditContext* json_ctx = dahdit_create(&json_cfg);
+    CHECK(text_ctx != NULL && json_ctx != NULL);
+    if (!text_ctx || !json_ctx) {
+        dahdit_destroy(text_ctx);
+        dahdit_destroy(json_ctx);
+        return;
+    }
+
+    const char* src = PRINT_X PRINT_Y PRINT_1;
+    for (int round = 0; round < 2; ++round) {
+        sink_clear(&text_sink);
+        sink_clear(&json_sink);
+
+        // 오류 수 제한이 없으므로 두 오류 뒤에도 끝까지 실행
+        CHECK(run(text_ctx, src));
+        CHECK_TEXT(text_sink.out, "1\n");
+        CHECK_TEXT(text_sink.diag,
+                   "test.dit:1:19: error: undefined variable 'X'\n"
+                   "test.dit:2:19: error: undefined variable 'Y'\n");
+
+        // 첫 오류에서 E903으로 멈추고 실행은 실패
+        CHECK(!run(json_ctx, src));
+        CHECK_TEXT(json_sink.out, "");
+        CHECK_TEXT(json_sink.diag,
+                   "{\"file\":\"test.dit\",\"line\":1,\"column\":19,\"severity\":\"error\",\"code\":\"E401\","
+                   "\"message\":\"undefined variable 'X'\",\"count\":1}\n"
+                   "{\"file\":\"test.dit\",\"line\":1,\"column\":19,\"severity\":\"fatal\",\"code\":\"E903\","
+                   "\"message\":\"too many errors (limit 1), stopping\",\"count\":1}\n");
+    }
+    dahdit_destroy(text_ctx);
+    dahdit_destroy(json_ctx);
+}
+
+/**
+ * @brief 출력은 write 콜백으로 (줄 단위 버퍼면 줄마다), 쓰기 실패는 실행 실패
+ */
+static void test_callbacks(void) {
+    Sink s = {0};
+    DahditConfig cfg = { .write = on_write, .diag = on_diag, .user = &s, .line_buffered = true };
+    DahditContext* ctx = dahdit_create(&cfg);
+    CHECK(ctx != NULL);
+    if (!ctx) return;
+
+    CHECK(run(ctx, SET_A PRINT_A7 PRINT_1));
+    CHECK_TEXT(s.out, "42\n1\n");
+    CHECK(s.out.calls == 2);
+    CHECK(s.diag.calls == 0);
+
+    sink_clear(&s);
+    s.fail_writes = true;
+    CHECK(!run(ctx, PRINT_1));
+
+    // 파일을 열 수 없으면 진단 콜백으로 알리고 실패
+    sink_clear(&s);
+    s.fail_writes = false;
+    CHECK(!dahdit_run_file(ctx, "no-such-file.dit"));
+    CHECK_TEXT(s.diag, "Cannot open: no-such-file.dit\n");
+    dahdit_destroy(ctx);
+}
+
+int main(void) {
+    test_variables_persist();
+    test_per_context_diagnostics();
+    test_callbacks();
+    if (failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
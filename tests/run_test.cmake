@@ -0,0 +1,111 @@
+# .dit 테스트 한 건을 한 실행 방식으로 돌려 기대 출력과 비교 (ctest에서 cmake -P로 호출)
+#   -DDAHDIT=<dahdit> -DCC=<C 컴파일러> -DSOURCE=<tests/x.dit> -DWORK=<작업 폴더> -DMODE=<방식>
+# MODE: default | stdin | optimize | parallel | pipeline | pipeline-stdin | simd-scalar | simd-sse2
+#       | cache | jit | emit-c | emit-c-optimize
+# 기대 출력은 tests/x.out(표준 출력)과 tests/x.err(진단, 없으면 비어 있어야 함).
+# tests/x.flags가 있으면 그 옵션(공백으로 구분)을 모든 방식의 dahdit 실행에 덧붙인다.
+# 진단에 찍히는 파일 이름이 같도록 소스를 작업 폴더에 복사해 상대 경로로 실행한다.
+get_filename_component(name ${SOURCE} NAME_WE)
+get_filename_component(dir ${SOURCE} DIRECTORY)
+file(REMOVE_RECURSE ${WORK})
+file(MAKE_DIRECTORY ${WORK})
+file(COPY ${SOURCE} DESTINATION ${WORK})
+
+set(expected_out "")
+set(expected_err "")
+if (EXISTS ${dir}/${name}.out)
+    file(READ ${dir}/${name}.out expected_out)
+endif()
+if (EXISTS ${dir}/${name}.err)
+    file(READ ${dir}/${name}.err expected_err)
+endif()
+set(test_flags)
+if (EXISTS ${dir}/${name}.flags)
+    file(READ ${dir}/${name}.flags test_flags)
+    separate_arguments(test_flags UNIX_COMMAND "${test_flags}")
+endif()
+
+function(run_dahdit)
+    execute_process(COMMAND ${DAHDIT} ${test_flags} ${ARGN} ${name}.dit
+            WORKING_DIRECTORY ${WORK}
+            OUTPUT_VARIABLE out ERROR_VARIABLE err)
+    set(out "${out}" PARENT_SCOPE)
+    set(err "${err}" PARENT_SCOPE)
+endfunction()
+
+if (MODE STREQUAL "default")
+    run_dahdit(--no-cache)
+elseif (MODE STREQUAL "optimize")
+    run_dahdit(--no-cache -O)
+elseif (MODE STREQUAL "parallel")
+    run_dahdit(--no-cache --parallel=4)
+elseif (MODE STREQUAL "pipeline")
+    run_dahdit(--no-cache --pipeline)
+elseif (MODE STREQUAL "stdin" OR MODE STREQUAL "pipeline-stdin")
+    # 표준 입력에서 읽어 가며 실행 (진단의 파일 이름은 <stdin>이므로 기대 진단도 바꿔 비교)
+    set(stdin_flags)
+    if (MODE STREQUAL "pipeline-stdin")
+        set(stdin_flags --pipeline)
+    endif()
+    execute_process(COMMAND ${DAHDIT} ${test_flags} ${stdin_flags} -
+            WORKING_DIRECTORY ${WORK} INPUT_FILE ${WORK}/${name}.dit
+            OUTPUT_VARIABLE out ERROR_VARIABLE err)
+    string(REPLACE "${name}.dit" "<stdin>" expected_err "${expected_err}")
+elseif (MODE MATCHES "^simd-")
+    # 스캔/배열 커널을 낮은 단계로 강제 (CPU가 지원하는 가장 높은 단계는 default에서 확인)
+    string(REPLACE "simd-" "" level ${MODE})
+    set(ENV{DAHDIT_SIMD} ${level})
+    run_dahdit(--no-cache)
+elseif (MODE STREQUAL "cache")
+    # 첫 실행이 .ditc를 쓰고, 두 번째 실행이 그것을 읽는다 (두 실행 모두 기대 출력과 비교)
+    run_dahdit()
+    if (NOT EXISTS ${WORK}/${name}.ditc)
+        message(FATAL_ERROR "${name}.ditc was not written")
+    endif()
+    if (NOT out STREQUAL expected_out OR NOT err STREQUAL expected_err)
+        message(FATAL_ERROR "first run (writing the cache) differs\n--- stdout\n${out}--- diagnostics\n${err}")
+    endif()
+    # 캐시를 다시 쓰면 rename으로 새 파일이 되므로, 하드 링크에 덧붙인 바이트가 .ditc에
+    # 보이면 두 번째 실행은 캐시를 그대로 쓴 것 (적중)
+    file(CREATE_LINK ${WORK}/${name}.ditc ${WORK}/first.ditc)
+    run_dahdit()
+    file(SIZE ${WORK}/${name}.ditc size_before)
+    file(APPEND ${WORK}/first.ditc "x")
+    file(SIZE ${WORK}/${name}.ditc size_after)
+    if (size_after EQUAL size_before)
+        message(FATAL_ERROR "second run rewrote ${name}.ditc instead of using it")
+    endif()
+elseif (MODE STREQUAL "jit")
+    # 한 프로세스에서 두 번 실행: 첫 실행은 VM, 두 번째(INTERP_JIT_RUNS)는 기계어로 번역한 코드
+    run_dahdit(--no-cache --jit --jobs=1 ${name}.dit)
+    string(REGEX REPLACE "batch: [^\n]*\n$" "" err "${err}")
+    set(expected_out "${expected_out}${expected_out}")
+    set(expected_err "${expected_err}${expected_err}")
+elseif (MODE MATCHES "^emit-c")
+    set(flags)
+    if (MODE STREQUAL "emit-c-optimize")
+        set(flags -O)
+    endif()
+    execute_process(COMMAND ${DAHDIT} ${flags} --emit-c=${name}.c ${name}.dit
+            WORKING_DIRECTORY ${WORK} RESULT_VARIABLE rc ERROR_VARIABLE err)
+    if (NOT rc EQUAL 0)
+        message(FATAL_ERROR "--emit-c failed:\n${err}")
+    endif()
+    execute_process(COMMAND ${CC} -std=c11 -O1 -o ${name}.exe ${name}.c
+            WORKING_DIRECTORY ${WORK} RESULT_VARIABLE rc ERROR_VARIABLE err)
+    if (NOT rc EQUAL 0)
+        message(FATAL_ERROR "compiling the generated C failed:\n${err}")
+    endif()
+    execute_process(COMMAND ${WORK}/${name}.exe
+            WORKING_DIRECTORY ${WORK}
+            OUTPUT_VARIABLE out ERROR_VARIABLE err)
+else()
+    message(FATAL_ERROR "unknown MODE '${MODE}'")
+endif()
+
+if (NOT out STREQUAL expected_out)
+    message(FATAL_ERROR "stdout differs (${MODE})\n--- expected\n${expected_out}--- actual\n${out}")
+endif()
+if (NOT err STREQUAL expected_err)
+    message(FATAL_ERROR "diagnostics differ (${MODE})\n--- expected\n${expected_err}--- actual\n${err}")
+endif()
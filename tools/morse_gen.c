@@ -0,0 +1,80 @@
+//========================================
+// System Includes
+//========================================
+#include "morse_table.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+//========================================
+// MORSE_TABLE → MORSE_INDEX 생성기
+// 빌드 시점에 실행되어 lexer.c가 사용하는 morse_index.h를 만든다.
+//========================================
+
+/**
+ * @brief 모스 부호 문자열을 (길이, 비트 패턴) 인덱스로 변환
+ * i번째 부호가 선(-)이면 비트 i를 세우고, 길이 표시로 비트 n(부호 길이)을 세운다.
+ * 예) ".-" → 0b110 = 6. SIMD 비교 결과의 비트마스크가 그대로 인덱스가 되는 순서다.
+ * @return 유효한 부호면 인덱스, 문자가 잘못되었거나 너무 길면 -1.
+ */
+static int morse_index_of(const char* code) {
+    int idx = 0;
+    int n = 0;
+    for (const char* p = code; *p; ++p, ++n) {
+        if (n >= MORSE_MAX_CODE_LEN) return -1;
+        if (*p == '-') idx |= 1 << n;
+        else if (*p != '.') return -1;
+    }
+    return n > 0 ? idx | (1 << n) : -1;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <morse_index.h>\n", argv[0]);
+        return 1;
+    }
+
+    char index[MORSE_INDEX_SIZE];
+    memset(index, 0, sizeof(index));
+
+    // 1) 연산자와 '='는 동일한 부호의 알파벳보다 항상 우선
+    // 2) 나머지는 기존 선형 탐색과 동일하게 테이블에서 먼저 나온 항목이 우선
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < MORSE_TABLE_LEN; ++i) {
+            int idx = morse_index_of(MORSE_TABLE[i].code);
+            if (idx < 0) {
+                fprintf(stderr, "morse_gen: invalid code \"%s\" in MORSE_TABLE\n", MORSE_TABLE[i].code);
+                return 1;
+            }
+            bool priority = strchr(MORSE_PRIORITY_CHARS, MORSE_TABLE[i].ch) != NULL;
+            if (pass == 0 && !priority) continue;
+            if (index[idx] == '\0') index[idx] = MORSE_TABLE[i].ch;
+        }
+    }
+
+    FILE* fp = fopen(argv[1], "w");
+    if (!fp) {
+        fprintf(stderr, "morse_gen: cannot write %s\n", argv[1]);
+        return 1;
+    }
+
+    fprintf(fp, "// 자동 생성 파일: tools/morse_gen.c가 include/morse_table.h로부터 생성. 직접 수정 금지.\n");
+    fprintf(fp, "#ifndef MORSE_INDEX_H\n#define MORSE_INDEX_H\n\n");
+    fprintf(fp, "#define MORSE_INDEX_MAX_LEN %d\n\n", MORSE_MAX_CODE_LEN);
+    fprintf(fp, "// 인덱스 = (1 << 길이) | (i번째 부호가 선(-)이면 비트 i), 값 0은 미등록 부호\n");
+    fprintf(fp, "static const char MORSE_INDEX[%d] = {", MORSE_INDEX_SIZE);
+    for (int i = 0; i < MORSE_INDEX_SIZE; ++i) {
+        fprintf(fp, i % 8 == 0 ? "\n    " : " ");
+        unsigned char c = (unsigned char)index[i];
+        if (c == 0) fprintf(fp, "0,");
+        else if (c == '\'' || c == '\\') fprintf(fp, "'\\%c',", c);
+        else fprintf(fp, "'%c',", c);
+    }
+    fprintf(fp, "\n};\n\n#endif\n");
+
+    if (fclose(fp) != 0) {
+        fprintf(stderr, "morse_gen: cannot write %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}